@@ -0,0 +1,57 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+namespace selaura::bench {
+    // keeps the optimizer from dropping a result nobody reads
+    template <typename T>
+    inline void keep(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        static const void* volatile sink;
+        sink = &value;
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    // runs fn in batches sized to fill roughly target, reports the fastest of a few batches in ns per op
+    // ops is how many operations a single call of fn performs
+    template <typename fn_t>
+    void run(std::string_view name, std::size_t ops, fn_t&& fn) {
+        using clock = std::chrono::steady_clock;
+        constexpr auto target = std::chrono::milliseconds(200);
+        constexpr int batches = 5;
+
+        std::size_t iterations = 1;
+        while (true) {
+            const auto start = clock::now();
+            for (std::size_t i = 0; i < iterations; i++) fn();
+            if (clock::now() - start >= target / 10 || iterations >= (std::size_t{ 1 } << 30)) break;
+            iterations *= 2;
+        }
+        iterations *= 10;
+
+        double best = 0.0;
+        for (int batch = 0; batch < batches; batch++) {
+            const auto start = clock::now();
+            for (std::size_t i = 0; i < iterations; i++) fn();
+            const double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+            const double per_op = elapsed / static_cast<double>(iterations * ops);
+            best = batch == 0 ? per_op : std::min(best, per_op);
+        }
+
+        std::printf("%-48.*s %14.2f ns/op\n", static_cast<int>(name.size()), name.data(), best);
+    }
+
+    void run_event_benchmarks();
+    void run_scanner_benchmarks();
+    void run_renderer_benchmarks();
+    void run_hashing_benchmarks();
+    void run_feature_benchmarks();
+    void run_math_benchmarks();
+};
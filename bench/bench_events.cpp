@@ -0,0 +1,50 @@
+#include "bench.hpp"
+
+#include "event/event_manager.hpp"
+
+#include <string>
+#include <vector>
+
+namespace selaura::bench {
+    namespace {
+        struct bench_event {
+            std::uint64_t value = 0;
+        };
+
+        struct bench_cancellable_event : cancellable {
+            std::uint64_t value = 0;
+        };
+
+        template <typename T>
+        void dispatch_with(std::size_t listeners) {
+            // listener lists are per event type rather than per manager, so every run unsubscribes what it added
+            event_manager evm;
+            std::uint64_t total = 0;
+            std::vector<event_manager::subscription_token> tokens;
+            for (std::size_t i = 0; i < listeners; i++) {
+                tokens.push_back(evm.subscribe<T>([&total](T& ev) { total += ev.value; }));
+            }
+
+            bool cancelled = false;
+            T ev{};
+            if constexpr (std::is_base_of_v<cancellable, T>) ev.cancelled = &cancelled;
+            ev.value = 1;
+
+            const std::string name = std::string(std::is_base_of_v<cancellable, T> ? "dispatch cancellable" : "dispatch") + ", " + std::to_string(listeners) + " listeners";
+            run(name, 1, [&] {
+                evm.dispatch(ev);
+            });
+            keep(total);
+
+            for (const auto token : tokens) evm.unsubscribe<T>(token);
+            event_manager::quiesce();
+        }
+    }
+
+    void run_event_benchmarks() {
+        for (const std::size_t listeners : { 0, 1, 8, 64 }) {
+            dispatch_with<bench_event>(listeners);
+        }
+        dispatch_with<bench_cancellable_event>(8);
+    }
+};
@@ -0,0 +1,58 @@
+#include "bench.hpp"
+
+#include "feature/feature_manager.hpp"
+
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace selaura::bench {
+    namespace {
+        constexpr std::size_t feature_count = 32;
+
+        // one type per slot, the registry only ever holds a single instance of each
+        template <std::size_t index>
+        struct bench_feature : feature {
+            DEFINE_FEATURE_TRAITS("Bench", "Settings only, never enabled")
+
+            bench_feature() {
+                this->add_setting("Scale", 1.0f);
+                this->add_setting("Enabled", true);
+                this->add_setting("Mode", 2);
+                this->add_setting("Color", glm::vec4(1.0f));
+                this->add_setting("Opacity", 0.5f);
+                this->add_setting("Shadow", false);
+                this->add_setting("Alignment", 0);
+                this->add_setting("Outline", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            }
+        };
+
+        template <std::size_t... index>
+        void add_features(feature_manager& features, std::index_sequence<index...>) {
+            (features.add_feature<bench_feature<index>>(), ...);
+        }
+    }
+
+    void run_feature_benchmarks() {
+        feature_manager features;
+        add_features(features, std::make_index_sequence<feature_count>{});
+
+        std::size_t settings = 0;
+        features.for_each([&](const feature& feat) { settings += feat.get_settings().size(); });
+
+        // the walk the config writer and the click gui do, every setting's value visited by type
+        run("visit " + std::to_string(settings) + " settings of " + std::to_string(feature_count) + " features", 1, [&] {
+            float sum = 0.0f;
+            features.for_each([&](const feature& feat) {
+                for (const auto& setting : feat.get_settings()) {
+                    std::visit([&](const auto& value) {
+                        using value_t = std::decay_t<decltype(value)>;
+                        if constexpr (std::is_same_v<value_t, glm::vec4>) sum += value.w;
+                        else sum += static_cast<float>(value);
+                    }, setting.value);
+                }
+            });
+            keep(sum);
+        });
+    }
+};
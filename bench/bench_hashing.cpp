@@ -0,0 +1,32 @@
+#include "bench.hpp"
+
+#include "sdk/mc/HashedString.hpp"
+#include "sdk/mc/deps/core/resource/ResourceHelper.hpp"
+
+#include <string>
+
+namespace selaura::bench {
+    void run_hashing_benchmarks() {
+        // names of the length the renderer and texture code actually hash
+        const std::string material = "ui_texture_and_color_blur";
+        const std::string texture = "textures/ui/selaura/icons/armor_hud_background";
+
+        run("fnv1a_64, 25 chars", 1, [&] {
+            keep(HashedString::fnv1a_64(material));
+        });
+
+        run("HashedStringView, 25 chars", 1, [&] {
+            keep(HashedStringView(material));
+        });
+
+        run("HashedString, 25 chars", 1, [&] {
+            HashedString hashed(material);
+            keep(hashed.hash);
+        });
+
+        run("ResourceLocation, 47 chars", 1, [&] {
+            ResourceLocation location(texture);
+            keep(location.mFullHash);
+        });
+    }
+};
@@ -0,0 +1,42 @@
+#include "bench.hpp"
+
+#include "world/projection.hpp"
+
+#include <vector>
+
+namespace selaura::bench {
+    void run_math_benchmarks() {
+        constexpr std::size_t count = 10000;
+
+        // a camera at the origin looking down -z, about a third of the points land on screen
+        glm::mat4 view_proj(0.0f);
+        view_proj[0][0] = 1.0f;
+        view_proj[1][1] = 1.7f;
+        view_proj[2][3] = -1.0f;
+        const glm::vec2 screen{ 1280.0f, 720.0f };
+
+        std::vector<float> xs(count), ys(count), zs(count);
+        for (std::size_t i = 0; i < count; i++) {
+            xs[i] = static_cast<float>(i % 97) - 48.0f;
+            ys[i] = static_cast<float>(i % 31) - 15.0f;
+            zs[i] = static_cast<float>(i % 61) - 30.0f;
+        }
+
+        std::vector<float> out_x(count), out_y(count);
+        std::vector<std::uint8_t> visible(count);
+
+        run("world_to_screen, one point at a time", count, [&] {
+            std::size_t on_screen = 0;
+            for (std::size_t i = 0; i < count; i++) {
+                Vec2 out;
+                on_screen += world_to_screen(view_proj, screen, { xs[i], ys[i], zs[i] }, out);
+                out_x[i] = out.x;
+            }
+            keep(on_screen);
+        });
+
+        run("project_points, 10000 points", count, [&] {
+            keep(project_points(view_proj, screen, { xs, ys, zs }, { out_x.data(), out_y.data(), visible.data() }));
+        });
+    }
+};
@@ -0,0 +1,293 @@
+#include "bench.hpp"
+
+#include "renderer/renderer.hpp"
+#include "sdk/mem/symbols.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <imgui.h>
+
+namespace selaura::bench {
+    namespace {
+        // what the mocked engine was asked to do, so a run can be sanity checked
+        struct engine_calls {
+            std::uint64_t begins = 0;
+            std::uint64_t vertices = 0;
+            std::uint64_t colors = 0;
+            std::uint64_t meshes = 0;
+        };
+
+        engine_calls calls;
+        mce::MaterialPtr fake_material;
+
+        void fake_begin(Tessellator*, mce::PrimitiveMode, const int, const bool) { calls.begins++; }
+        void fake_vertex_uv(Tessellator*, float, float, float, float, float) { calls.vertices++; }
+        void fake_color(Tessellator*, float, float, float, float) { calls.colors++; }
+        void fake_render_mesh(void*, void*, void*, BedrockTextureData&, char*) { calls.meshes++; }
+        mce::MaterialPtr* fake_get_material(void*, const HashedString&) { return &fake_material; }
+
+        // createMaterial follows a rip-relative mov to the material group and calls into its vtable, both faked side by side
+        struct fake_material_lookup {
+            unsigned char mov[8]{ 0x48, 0x8B, 0x05 };
+            void** vtable;
+        };
+
+        void* fake_group_vtable[8]{};
+        fake_material_lookup material_lookup;
+
+        struct fake_game {
+            alignas(16) std::byte ctx[0x20]{};
+            alignas(16) std::byte screen_context[0x20]{};
+            alignas(16) std::byte client_instance[0x20]{};
+            alignas(16) std::byte gui_data[0x80]{};
+            alignas(16) std::byte tessellator[0x10]{};
+
+            template <typename T>
+            static void write(std::byte* base, uintptr_t offset, T value) {
+                std::memcpy(base + offset, &value, sizeof(value));
+            }
+
+            MinecraftUIRenderContext* context() {
+                return reinterpret_cast<MinecraftUIRenderContext*>(ctx);
+            }
+        };
+
+        // points every engine call render_draw_data makes at the fakes, false if this platform has no material slot to fake
+        bool install_fakes(fake_game& game) {
+            const int material_index = signatures::mce_rendermaterialgroup_getmaterial.index();
+            if (material_index < 0 || material_index >= static_cast<int>(std::size(fake_group_vtable))) return false;
+
+            signatures::tessellator_begin.cached = reinterpret_cast<void*>(&fake_begin);
+            signatures::tessellator_vertexuv.cached = reinterpret_cast<void*>(&fake_vertex_uv);
+            signatures::tessellator_color.cached = reinterpret_cast<void*>(&fake_color);
+            signatures::meshhelpers_rendermeshimmediately.cached = reinterpret_cast<void*>(&fake_render_mesh);
+
+            fake_group_vtable[material_index] = reinterpret_cast<void*>(&fake_get_material);
+            material_lookup.vtable = fake_group_vtable;
+            const auto displacement = static_cast<std::int32_t>(reinterpret_cast<intptr_t>(&material_lookup.vtable) - reinterpret_cast<intptr_t>(material_lookup.mov + 7));
+            std::memcpy(material_lookup.mov + 3, &displacement, sizeof(displacement));
+            signatures::mce_rendermaterialgroup_ui.cached = material_lookup.mov;
+
+            // our own layout, the shipped offsets are zero on platforms nobody has mapped yet
+            signatures::minecraftuirendercontext_clientinstance.override_offset = 0x8;
+            signatures::minecraftuirendercontext_screencontext.override_offset = 0x10;
+            signatures::clientinstance_guidata.override_offset = 0x8;
+            signatures::screencontext_tessellator.override_offset = 0x8;
+
+            fake_game::write(game.ctx, 0x8, reinterpret_cast<ClientInstance*>(game.client_instance));
+            fake_game::write(game.ctx, 0x10, reinterpret_cast<ScreenContext*>(game.screen_context));
+            fake_game::write(game.client_instance, 0x8, reinterpret_cast<GuiData*>(game.gui_data));
+            fake_game::write(game.screen_context, 0x8, reinterpret_cast<Tessellator*>(game.tessellator));
+            fake_game::write(game.gui_data, 0x40, Vec2{ 640.0f, 360.0f });
+            fake_game::write(game.gui_data, 0x5C, 2.0f);
+            return true;
+        }
+
+        // a busy overlay: a few windows of text and widgets plus the rounded rects features draw in the background
+        ImDrawData* build_frame() {
+            auto& io = ImGui::GetIO();
+            io.DeltaTime = 1.0f / 60.0f;
+            ImGui::NewFrame();
+
+            for (int w = 0; w < 4; w++) {
+                ImGui::SetNextWindowPos({ 20.0f + w * 300.0f, 20.0f }, ImGuiCond_Always);
+                ImGui::SetNextWindowSize({ 280.0f, 400.0f }, ImGuiCond_Always);
+                char title[16];
+                std::snprintf(title, sizeof(title), "window %d", w);
+
+                ImGui::Begin(title);
+                for (int line = 0; line < 20; line++) {
+                    ImGui::Text("line %d of a window with some text in it", line);
+                }
+                static bool toggle = true;
+                static float slider = 0.5f;
+                ImGui::Checkbox("toggle", &toggle);
+                ImGui::SliderFloat("slider", &slider, 0.0f, 1.0f);
+                ImGui::End();
+            }
+
+            auto* background = ImGui::GetBackgroundDrawList();
+            for (int i = 0; i < 64; i++) {
+                const float x = 10.0f + (i % 16) * 75.0f;
+                const float y = 450.0f + (i / 16) * 60.0f;
+                background->AddRectFilled({ x, y }, { x + 70.0f, y + 50.0f }, IM_COL32(20, 20, 20, 160), 6.0f);
+                background->AddText({ x + 4.0f, y + 4.0f }, IM_COL32_WHITE, "hud");
+            }
+
+            ImGui::Render();
+            return ImGui::GetDrawData();
+        }
+
+        // what a panel-heavy hud costs in vertices either way, before any of it reaches the tessellator
+        void compare_shapes(const shape_atlas& shapes) {
+            ImDrawList tessellated(ImGui::GetDrawListSharedData());
+            ImDrawList sliced(ImGui::GetDrawListSharedData());
+
+            auto fill = [](ImDrawList& list, auto&& draw) {
+                list._ResetForNewFrame();
+                list.PushClipRectFullScreen();
+                list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+                for (int i = 0; i < 64; i++) {
+                    const ImVec2 min{ 10.0f + (i % 16) * 75.0f, 450.0f + (i / 16) * 60.0f };
+                    draw(list, min, ImVec2{ min.x + 70.0f, min.y + 50.0f });
+                }
+            };
+
+            auto imgui_rects = [&] {
+                fill(tessellated, [](ImDrawList& list, ImVec2 min, ImVec2 max) { list.AddRectFilled(min, max, IM_COL32(20, 20, 20, 160), 6.0f); });
+            };
+            auto shape_rects = [&] {
+                fill(sliced, [&](ImDrawList& list, ImVec2 min, ImVec2 max) { shapes.fill_rect(&list, min, max, IM_COL32(20, 20, 20, 160), 6.0f); });
+            };
+
+            imgui_rects();
+            shape_rects();
+            std::printf("64 rounded rects: %d vertices tessellated, %d nine-sliced\n", tessellated.VtxBuffer.Size, sliced.VtxBuffer.Size);
+
+            run("rounded rect, AddRectFilled", 64, imgui_rects);
+            run("rounded rect, nine-sliced", 64, shape_rects);
+        }
+
+        // flat rects either way, imgui's six indexed vertices against four per quad, both recorded every frame
+        void compare_quads(renderer& target, const frame_context& frame) {
+            ImDrawList list(ImGui::GetDrawListSharedData());
+            ImDrawData data;
+            data.Valid = true;
+            data.DisplaySize = ImGui::GetIO().DisplaySize;
+            data.FramebufferScale = { 1.0f, 1.0f };
+            data.CmdLists.push_back(&list);
+            data.CmdListsCount = 1;
+
+            auto& quads = target.get_quads();
+            auto rects = [](auto&& draw) {
+                for (int i = 0; i < 256; i++) {
+                    const ImVec2 min{ 10.0f + (i % 32) * 38.0f, 20.0f + (i / 32) * 30.0f };
+                    draw(min, ImVec2{ min.x + 34.0f, min.y + 24.0f });
+                }
+            };
+
+            auto imgui_rects = [&] {
+                list._ResetForNewFrame();
+                list.PushClipRectFullScreen();
+                list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+                rects([&](ImVec2 min, ImVec2 max) { list.AddRectFilled(min, max, IM_COL32(20, 20, 20, 160)); });
+                target.render_draw_data(&data, frame);
+            };
+            auto quad_rects = [&] {
+                list._ResetForNewFrame();
+                quads.clear();
+                rects([&](ImVec2 min, ImVec2 max) { quads.fill(min, max, IM_COL32(20, 20, 20, 160)); });
+                target.render_draw_data(&data, frame);
+            };
+
+            calls = {};
+            imgui_rects();
+            const auto triangle_vertices = calls.vertices;
+            calls = {};
+            quad_rects();
+            std::printf("256 flat rects: %llu vertices as triangles, %llu as quads\n", static_cast<unsigned long long>(triangle_vertices), static_cast<unsigned long long>(calls.vertices));
+
+            run("flat rect, imgui triangles", 256, imgui_rects);
+            run("flat rect, quad list", 256, quad_rects);
+            quads.clear();
+        }
+
+        // frames captured in game from the profiler screen, set SELAURA_DRAW_CAPTURE to the draws.bin it wrote
+        void replay_capture(renderer& target, const frame_context& frame) {
+            const char* path = std::getenv("SELAURA_DRAW_CAPTURE");
+            if (!path) return;
+
+            const auto frames = load_draw_capture(path);
+            if (frames.empty()) {
+                std::printf("no frames in %s\n", path);
+                return;
+            }
+
+            // one fake texture per texture the capture saw, so batches split exactly where they did in game
+            std::uint32_t texture_count = 1;
+            for (const auto& frame : frames) {
+                for (const auto& list : frame.lists) {
+                    for (const auto& command : list.commands) {
+                        if (command.texture < captured_command::material_switch) texture_count = std::max(texture_count, command.texture + 1);
+                    }
+                }
+            }
+
+            std::vector<mce::TexturePtr> textures(texture_count);
+            std::vector<ImTextureID> ids;
+            for (auto& texture : textures) {
+                texture.mClientTexture = std::make_shared<BedrockTextureData>();
+                ids.push_back(static_cast<ImTextureID>(&texture));
+            }
+
+            draw_replay replay;
+            std::printf("%zu captured frames, %u textures\n", frames.size(), texture_count);
+
+            // copying the capture into draw lists is part of every frame below, this is how much of it to subtract
+            run("captured frame, copy only", frames.size(), [&] {
+                for (const auto& frame : frames) keep(replay.prepare(frame, ids));
+            });
+
+            run("render_draw_data, captured frames", frames.size(), [&] {
+                for (const auto& captured : frames) {
+                    target.render_draw_data(replay.prepare(captured, ids), frame, captured.replayed);
+                }
+            });
+        }
+    }
+
+    void run_renderer_benchmarks() {
+        fake_game game;
+        if (!install_fakes(game)) {
+            std::printf("no material vtable slot on this platform, renderer benchmarks skipped\n");
+            return;
+        }
+
+        ImGui::CreateContext();
+        auto& io = ImGui::GetIO();
+        io.DisplaySize = { 1280.0f, 720.0f };
+
+        shape_atlas shapes;
+        shapes.add_rects(*io.Fonts);
+        io.Fonts->Build();
+        shapes.bake(*io.Fonts);
+
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+        renderer target;
+        target.set_font_texture({ std::make_shared<BedrockTextureData>(), nullptr });
+
+        ImDrawData* data = build_frame();
+        const auto frame = frame_context::capture(*game.context(), 0);
+
+        calls = {};
+        target.render_draw_data(data, frame);
+        std::printf("%d lists, %llu vertices, %llu color changes, %llu meshes per frame\n", data->CmdListsCount,
+            static_cast<unsigned long long>(calls.vertices), static_cast<unsigned long long>(calls.colors), static_cast<unsigned long long>(calls.meshes));
+
+        run("render_draw_data, replayed", 1, [&] {
+            target.render_draw_data(data, frame, true);
+        });
+
+        run("render_draw_data, hashed and unchanged", 1, [&] {
+            target.render_draw_data(data, frame);
+        });
+
+        // one flipped color bit per list is enough to miss the retained copy
+        run("render_draw_data, every list rebuilt", 1, [&] {
+            for (int n = 0; n < data->CmdListsCount; n++) {
+                auto& vertices = data->CmdLists[n]->VtxBuffer;
+                if (!vertices.empty()) vertices[0].col ^= 1;
+            }
+            target.render_draw_data(data, frame);
+        });
+
+        compare_shapes(shapes);
+        compare_quads(target, frame);
+        replay_capture(target, frame);
+        ImGui::DestroyContext();
+    }
+};
@@ -0,0 +1,78 @@
+#include "bench.hpp"
+
+#include "sdk/mem/symbols.hpp"
+#include "sdk/mem/scanner.hpp"
+
+#include <string>
+#include <vector>
+
+namespace selaura::bench {
+    namespace {
+        constexpr std::size_t image_size = 100 << 20;
+
+        // xorshift bytes biased towards the opcodes real code is full of, so anchors get the candidate rate they would in the game
+        std::vector<std::byte> make_image() {
+            constexpr std::uint8_t common[] = { 0x00, 0xFF, 0xCC, 0x48, 0x89, 0x8B, 0x4C, 0x8D, 0x24, 0xE8, 0x83, 0x0F, 0x44, 0x41, 0xC3 };
+
+            std::vector<std::byte> image(image_size);
+            std::uint64_t state = 0x9E3779B97F4A7C15ull;
+            for (auto& byte : image) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+
+                const auto bits = static_cast<std::uint8_t>(state);
+                byte = static_cast<std::byte>((state >> 8) % 4 == 0 ? common[bits % std::size(common)] : bits);
+            }
+            return image;
+        }
+
+        // every windows signature we ship is planted in the last tenth, wildcards left as whatever was there
+        std::vector<scan_target> plant_signatures(std::vector<std::byte>& image) {
+            std::vector<scan_target> targets;
+            std::size_t at = image.size() - image.size() / 10;
+
+            for (const auto* symbol : signatures::signature_symbols) {
+                const auto& info = symbol->signatures.windows;
+                if (info.pattern.empty()) continue;
+
+                for (std::size_t i = 0; i < info.pattern.size(); i++) {
+                    if (info.pattern[i].has_value()) image[at + i] = info.pattern[i].value();
+                }
+                targets.push_back({ info.pattern, info.anchor });
+                at += 4096;
+            }
+            return targets;
+        }
+    }
+
+    void run_scanner_benchmarks() {
+        auto image = make_image();
+        auto targets = plant_signatures(image);
+        const auto* begin = image.data();
+        const auto* end = image.data() + image.size();
+
+        if (targets.empty()) {
+            std::printf("no signatures to plant, scanner benchmarks skipped\n");
+            return;
+        }
+
+        // what find_pattern does for every executable section of the process, minus looking the sections up
+        const auto single = targets.front().signature;
+        run("find_pattern, 1 signature over 100 MB", 1, [&] {
+            keep(hat::find_pattern(begin, end, single));
+        });
+
+        run("find_patterns, " + std::to_string(targets.size()) + " signatures over 100 MB", 1, [&] {
+            for (auto& target : targets) target.result.reset();
+            find_patterns(targets, begin, end);
+            keep(targets.back().result);
+        });
+
+        run("find_patterns_parallel, " + std::to_string(targets.size()) + " signatures over 100 MB", 1, [&] {
+            for (auto& target : targets) target.result.reset();
+            find_patterns_parallel(targets, begin, end);
+            keep(targets.back().result);
+        });
+    }
+};
@@ -0,0 +1,33 @@
+#include "bench.hpp"
+
+#include <cstring>
+
+// runs everything, or only the groups named on the command line
+int main(int argc, char** argv) {
+    struct group {
+        const char* name;
+        void (*run)();
+    };
+
+    constexpr group groups[] = {
+        { "events", selaura::bench::run_event_benchmarks },
+        { "scanner", selaura::bench::run_scanner_benchmarks },
+        { "renderer", selaura::bench::run_renderer_benchmarks },
+        { "hashing", selaura::bench::run_hashing_benchmarks },
+        { "features", selaura::bench::run_feature_benchmarks },
+        { "math", selaura::bench::run_math_benchmarks }
+    };
+
+    for (const auto& entry : groups) {
+        bool wanted = argc < 2;
+        for (int i = 1; i < argc; i++) {
+            if (std::strcmp(argv[i], entry.name) == 0) wanted = true;
+        }
+        if (!wanted) continue;
+
+        std::printf("[%s]\n", entry.name);
+        entry.run();
+    }
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include "asset_bundle.hpp"
+
+#include "../instance.hpp"
+#include "../sdk/mc/HashedString.hpp"
+
+#include <lz4.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace selaura {
+	namespace {
+		constexpr char bundle_magic[8] = { 'S', 'L', 'B', 'U', 'N', 'D', 'L', 'E' };
+		constexpr std::uint64_t entry_alignment = 16;
+		constexpr std::uint16_t flag_lz4 = 1 << 0;
+
+		// header, then every entry's data, then the index and the names it points into
+		struct bundle_header {
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t count;
+			std::uint64_t index_offset;
+			std::uint64_t names_offset;
+			std::uint64_t names_size;
+		};
+
+		std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		void pad_to(std::ofstream& out, std::uint64_t alignment) {
+			static constexpr char zeros[entry_alignment]{};
+			const auto position = static_cast<std::uint64_t>(out.tellp());
+			out.write(zeros, static_cast<std::streamsize>(align_up(position, alignment) - position));
+		}
+
+		// a bundle older than any file or folder under the source is repacked, a deleted file touches its folder
+		bool is_stale(const std::filesystem::path& folder, const std::filesystem::path& bundle) {
+			std::error_code ec;
+			if (!std::filesystem::is_directory(folder, ec)) return false;
+
+			const auto packed = std::filesystem::last_write_time(bundle, ec);
+			if (ec) return true;
+			if (std::filesystem::last_write_time(folder, ec) > packed) return true;
+
+			for (const auto& file : std::filesystem::recursive_directory_iterator(folder, ec)) {
+				std::error_code time_ec;
+				if (file.last_write_time(time_ec) > packed) return true;
+			}
+			return false;
+		}
+	}
+
+	void asset_bundle::init() {
+		const auto& data_folder = selaura::instance::get()->get_data_folder();
+		const auto path = data_folder / "assets.bundle";
+
+		if (const auto source = data_folder / "assets"; is_stale(source, path)) pack(source, path);
+		if (!this->open(path)) return;
+
+		spdlog::info("Mapped {} assets from {}", this->count, path.filename().string());
+	}
+
+	bool asset_bundle::open(const std::filesystem::path& path) {
+		this->close();
+		if (!this->file.open(path)) return false;
+
+		const auto bytes = this->file.bytes();
+		bundle_header header{};
+		if (bytes.size() < sizeof(header)) {
+			this->file.close();
+			return false;
+		}
+		std::memcpy(&header, bytes.data(), sizeof(header));
+
+		const auto index_size = static_cast<std::uint64_t>(header.count) * sizeof(entry);
+		const bool valid = std::memcmp(header.magic, bundle_magic, sizeof(bundle_magic)) == 0
+			&& header.version == format_version
+			&& header.index_offset % alignof(entry) == 0
+			&& header.index_offset + index_size <= bytes.size()
+			&& header.names_offset + header.names_size <= bytes.size();
+		if (!valid) {
+			spdlog::error("{} is not an asset bundle of version {}", path.string(), format_version);
+			this->file.close();
+			return false;
+		}
+
+		const auto* index = reinterpret_cast<const entry*>(bytes.data() + header.index_offset);
+
+		// checked once here so lookups never have to
+		for (std::uint32_t i = 0; i < header.count; i++) {
+			const entry& target = index[i];
+			if (target.offset + target.stored_size > bytes.size() || static_cast<std::uint64_t>(target.name_offset) + target.name_length > header.names_size) {
+				spdlog::error("Asset bundle {} is truncated", path.string());
+				this->file.close();
+				return false;
+			}
+		}
+
+		this->entries = index;
+		this->count = header.count;
+		this->names = reinterpret_cast<const char*>(bytes.data() + header.names_offset);
+		return true;
+	}
+
+	void asset_bundle::close() {
+		std::scoped_lock lock(this->mutex);
+		this->inflated.clear();
+		this->entries = nullptr;
+		this->count = 0;
+		this->names = nullptr;
+		this->file.close();
+	}
+
+	std::string_view asset_bundle::name_of(const entry& target) const {
+		return { this->names + target.name_offset, target.name_length };
+	}
+
+	std::span<const std::byte> asset_bundle::data_of(const entry& target) const {
+		const auto stored = this->file.bytes().subspan(target.offset, target.stored_size);
+		if (!(target.flags & flag_lz4)) return stored;
+
+		std::scoped_lock lock(this->mutex);
+		auto [it, inserted] = this->inflated.try_emplace(&target);
+		if (inserted) {
+			auto buffer = std::make_unique<std::byte[]>(target.size);
+			const int written = LZ4_decompress_safe(reinterpret_cast<const char*>(stored.data()), reinterpret_cast<char*>(buffer.get()), static_cast<int>(target.stored_size), static_cast<int>(target.size));
+
+			// kept as null so a broken entry is only reported once
+			if (written < 0 || static_cast<std::uint32_t>(written) != target.size) spdlog::error("Failed to inflate asset {}", this->name_of(target));
+			else it->second = std::move(buffer);
+		}
+
+		if (!it->second) return {};
+		return { it->second.get(), target.size };
+	}
+
+	std::span<const std::byte> asset_bundle::find(std::string_view name) const {
+		const std::uint64_t hash = HashedString::fnv1a_64(name);
+		const auto* end = this->entries + this->count;
+
+		for (const auto* it = std::lower_bound(this->entries, end, hash, [](const entry& target, std::uint64_t value) { return target.hash < value; }); it != end && it->hash == hash; ++it) {
+			if (this->name_of(*it) == name) return this->data_of(*it);
+		}
+		return {};
+	}
+
+	void asset_bundle::for_each(std::string_view prefix, const std::function<void(std::string_view name, std::span<const std::byte> data)>& fn) const {
+		for (std::uint32_t i = 0; i < this->count; i++) {
+			const entry& target = this->entries[i];
+			const auto name = this->name_of(target);
+			if (!name.starts_with(prefix)) continue;
+
+			const auto data = this->data_of(target);
+			if (!data.empty() || target.size == 0) fn(name, data);
+		}
+	}
+
+	bool asset_bundle::pack(const std::filesystem::path& folder, const std::filesystem::path& out) {
+		std::error_code ec;
+		std::vector<std::filesystem::path> files;
+		for (const auto& file : std::filesystem::recursive_directory_iterator(folder, ec)) {
+			if (file.is_regular_file(ec)) files.push_back(file.path());
+		}
+		// the same folder always packs to the same bytes
+		std::ranges::sort(files);
+
+		auto temp = out;
+		temp += ".tmp";
+		std::ofstream bundle(temp, std::ios::binary | std::ios::trunc);
+		if (!bundle) {
+			spdlog::error("Failed to write asset bundle {}", out.string());
+			return false;
+		}
+
+		bundle_header header{};
+		std::memcpy(header.magic, bundle_magic, sizeof(bundle_magic));
+		header.version = format_version;
+		bundle.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		std::vector<entry> index;
+		std::string names;
+		std::vector<char> contents;
+		std::vector<char> compressed;
+		std::uint64_t stored_total = 0;
+		std::uint64_t original_total = 0;
+
+		for (const auto& path : files) {
+			const auto name = path.lexically_relative(folder).generic_string();
+
+			std::ifstream in(path, std::ios::binary);
+			if (!in) {
+				spdlog::error("Failed to read asset {}", path.string());
+				continue;
+			}
+			contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+			if (name.size() > UINT16_MAX || contents.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+				spdlog::error("Asset {} is too large to bundle", name);
+				continue;
+			}
+
+			// only kept compressed when it saves at least an eighth, images and fonts that are already packed are stored as is
+			const char* stored = contents.data();
+			std::size_t stored_size = contents.size();
+			std::uint16_t flags = 0;
+
+			compressed.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(contents.size()))));
+			const int compressed_size = contents.empty() ? 0 : LZ4_compress_default(contents.data(), compressed.data(), static_cast<int>(contents.size()), static_cast<int>(compressed.size()));
+			if (compressed_size > 0 && static_cast<std::size_t>(compressed_size) < contents.size() - contents.size() / 8) {
+				stored = compressed.data();
+				stored_size = static_cast<std::size_t>(compressed_size);
+				flags |= flag_lz4;
+			}
+
+			pad_to(bundle, entry_alignment);
+			index.push_back({
+				HashedString::fnv1a_64(name),
+				static_cast<std::uint64_t>(bundle.tellp()),
+				static_cast<std::uint32_t>(stored_size),
+				static_cast<std::uint32_t>(contents.size()),
+				static_cast<std::uint32_t>(names.size()),
+				static_cast<std::uint16_t>(name.size()),
+				flags
+			});
+			bundle.write(stored, static_cast<std::streamsize>(stored_size));
+			names += name;
+
+			stored_total += stored_size;
+			original_total += contents.size();
+		}
+
+		std::ranges::stable_sort(index, {}, &entry::hash);
+
+		pad_to(bundle, alignof(entry));
+		header.count = static_cast<std::uint32_t>(index.size());
+		header.index_offset = static_cast<std::uint64_t>(bundle.tellp());
+		bundle.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(entry)));
+
+		header.names_offset = static_cast<std::uint64_t>(bundle.tellp());
+		header.names_size = names.size();
+		bundle.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+		bundle.seekp(0);
+		bundle.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		bundle.close();
+		if (!bundle) {
+			spdlog::error("Failed to write asset bundle {}", out.string());
+			return false;
+		}
+
+		// renamed over the old bundle, which is never mapped while it is repacked
+		std::filesystem::rename(temp, out, ec);
+		if (ec) {
+			spdlog::error("Failed to write asset bundle {}: {}", out.string(), ec.message());
+			return false;
+		}
+
+		spdlog::info("Packed {} assets into {} ({} of {} bytes)", index.size(), out.filename().string(), stored_total, original_total);
+		return true;
+	}
+};
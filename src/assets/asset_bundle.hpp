@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include "../util/mapped_file.hpp"
+
+namespace selaura {
+	// every client resource in data_folder/assets.bundle, mapped once and read in place instead of one file open per asset
+	// entries are named by their path inside the bundle, "fonts/fallback.ttf", and start 16 byte aligned
+	// stored entries are handed out straight from the mapping, lz4 compressed ones are inflated on first use and kept
+	struct asset_bundle {
+		static constexpr std::uint32_t format_version = 1;
+
+		asset_bundle() = default;
+		asset_bundle(const asset_bundle&) = delete;
+		asset_bundle& operator=(const asset_bundle&) = delete;
+
+		// repacks from data_folder/assets when anything in it is newer than the bundle, then maps it
+		// a missing bundle is not an error, every consumer falls back to its loose files
+		void init();
+
+		// false for a missing file or one that isn't a bundle of this version, whatever was open is closed either way
+		bool open(const std::filesystem::path& path);
+		void close();
+
+		// empty if there is no such entry or it failed to inflate, valid until the bundle is closed
+		std::span<const std::byte> find(std::string_view name) const;
+
+		// every entry whose name starts with prefix, in no particular order
+		void for_each(std::string_view prefix, const std::function<void(std::string_view name, std::span<const std::byte> data)>& fn) const;
+
+		std::uint32_t size() const {
+			return this->count;
+		}
+
+		// every regular file under folder, named by its path relative to it with forward slashes
+		static bool pack(const std::filesystem::path& folder, const std::filesystem::path& out);
+	private:
+		// sorted by hash, a collision just means comparing a few names
+		struct entry {
+			std::uint64_t hash;
+			std::uint64_t offset;
+			std::uint32_t stored_size;
+			std::uint32_t size;
+			std::uint32_t name_offset;
+			std::uint16_t name_length;
+			std::uint16_t flags;
+		};
+
+		std::string_view name_of(const entry& target) const;
+		std::span<const std::byte> data_of(const entry& target) const;
+
+		mapped_file file;
+		const entry* entries = nullptr;
+		std::uint32_t count = 0;
+		const char* names = nullptr;
+
+		// inflated copies never move, so spans into them stay valid like spans into the mapping
+		mutable std::mutex mutex;
+		mutable std::unordered_map<const entry*, std::unique_ptr<std::byte[]>> inflated;
+	};
+};
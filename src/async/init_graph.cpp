@@ -0,0 +1,98 @@
+#include "init_graph.hpp"
+#include "job_system.hpp"
+#include "../profiler/profiler.hpp"
+
+#include <algorithm>
+#include <format>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace selaura {
+	void init_graph::add(std::string_view name, std::function<void()> run, std::initializer_list<std::string_view> after, init_thread thread) {
+		const std::size_t index = this->phases.size();
+		auto& added = this->phases.emplace_back(phase{ name, std::move(run), thread });
+
+		for (std::string_view dependency : after) {
+			auto it = std::ranges::find(this->phases.begin(), this->phases.end() - 1, dependency, &phase::name);
+			if (it == this->phases.end() - 1) {
+				spdlog::error("Init phase {} depends on unknown phase {}", name, dependency);
+				continue;
+			}
+
+			it->dependents.push_back(index);
+			added.waiting_on++;
+		}
+	}
+
+	void init_graph::run(job_system& jobs) {
+		this->started = clock::now();
+
+		for (std::size_t i = 0; i < this->phases.size(); i++) {
+			if (this->phases[i].waiting_on == 0) this->schedule(jobs, i);
+		}
+
+		std::unique_lock lock(this->mutex);
+		while (this->finished < this->phases.size()) {
+			if (this->caller_queue.empty()) {
+				this->changed.wait(lock);
+				continue;
+			}
+
+			const std::size_t next = this->caller_queue.front();
+			this->caller_queue.pop_front();
+			lock.unlock();
+			this->execute(jobs, next);
+			lock.lock();
+		}
+
+		this->total = clock::now() - this->started;
+	}
+
+	void init_graph::schedule(job_system& jobs, std::size_t index) {
+		if (this->phases[index].thread == init_thread::pool) {
+			jobs.submit([this, &jobs, index] { this->execute(jobs, index); });
+			return;
+		}
+
+		{
+			std::scoped_lock lock(this->mutex);
+			this->caller_queue.push_back(index);
+		}
+		this->changed.notify_all();
+	}
+
+	void init_graph::execute(job_system& jobs, std::size_t index) {
+		auto& current = this->phases[index];
+		const auto start = clock::now();
+		{
+			SELAURA_TRACE_SCOPE(current.name);
+			current.run();
+		}
+		current.offset = start - this->started;
+		current.took = clock::now() - start;
+
+		// dependents are collected under the lock and scheduled outside it, scheduling a caller phase takes it again
+		std::vector<std::size_t> ready;
+		{
+			std::scoped_lock lock(this->mutex);
+			for (std::size_t dependent : current.dependents) {
+				if (--this->phases[dependent].waiting_on == 0) ready.push_back(dependent);
+			}
+			this->finished++;
+		}
+
+		for (std::size_t dependent : ready) this->schedule(jobs, dependent);
+		this->changed.notify_all();
+	}
+
+	void init_graph::log_timings() const {
+		using ms = std::chrono::duration<float, std::milli>;
+
+		std::string breakdown;
+		for (const auto& entry : this->phases) {
+			if (!breakdown.empty()) breakdown += ", ";
+			breakdown += std::format("{} {:.1f}ms (+{:.1f})", entry.name, ms(entry.took).count(), ms(entry.offset).count());
+		}
+		spdlog::info("Init phases [{:.1f}ms]: {}", ms(this->total).count(), breakdown);
+	}
+};
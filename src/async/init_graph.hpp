@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace selaura {
+	struct job_system;
+
+	enum class init_thread {
+		// any worker
+		pool,
+		// the thread calling run, for phases that fan out to the pool themselves and wait on it
+		caller
+	};
+
+	// startup phases with declared dependencies, every phase whose dependencies are done runs at once
+	struct init_graph {
+		// names must be string literals, after may only name phases added earlier so the graph can't have a cycle
+		void add(std::string_view name, std::function<void()> run, std::initializer_list<std::string_view> after = {}, init_thread thread = init_thread::pool);
+
+		// blocks until every phase has run
+		void run(job_system& jobs);
+
+		// one line with every phase's time and when it started, in the order they were added
+		void log_timings() const;
+	private:
+		using clock = std::chrono::steady_clock;
+
+		struct phase {
+			std::string_view name;
+			std::function<void()> run;
+			init_thread thread;
+			std::vector<std::size_t> dependents;
+			std::size_t waiting_on = 0;
+			clock::duration offset{};
+			clock::duration took{};
+		};
+
+		void schedule(job_system& jobs, std::size_t index);
+		void execute(job_system& jobs, std::size_t index);
+
+		std::vector<phase> phases;
+		clock::time_point started;
+		clock::duration total{};
+
+		std::mutex mutex;
+		std::condition_variable changed;
+		std::deque<std::size_t> caller_queue;
+		std::size_t finished = 0;
+	};
+};
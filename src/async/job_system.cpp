@@ -0,0 +1,141 @@
+#include "job_system.hpp"
+#include "../instance.hpp"
+
+#include <algorithm>
+
+namespace selaura {
+	namespace {
+		// the worker the current thread is, or npos off the pool
+		thread_local std::size_t current_worker = static_cast<std::size_t>(-1);
+	}
+
+	job_system& get_job_system() {
+		return selaura::get_component<selaura::job_system>();
+	}
+
+	job_system::job_system() {
+		// the game thread keeps a core to itself
+		const std::size_t count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+		for (std::size_t i = 0; i < std::max<std::size_t>(count, 1); i++) {
+			this->workers.push_back(std::make_unique<worker>());
+		}
+
+		for (std::size_t i = 0; i < this->workers.size(); i++) {
+			this->workers[i]->thread = std::thread(&job_system::worker_loop, this, i);
+		}
+	}
+
+	job_system::~job_system() {
+		this->shutdown();
+	}
+
+	void job_system::shutdown() {
+		// queued jobs still run, config writes and the like must not be dropped on shutdown
+		{
+			std::scoped_lock lock(this->sleep_mutex);
+			this->stopping = true;
+		}
+		this->wake.notify_all();
+
+		for (auto& entry : this->workers) {
+			if (entry->thread.joinable()) entry->thread.join();
+		}
+	}
+
+	void job_system::init() {
+		selaura::get_component<selaura::event_manager>().subscribe<minecraftgame_update_event>(&job_system::on_tick, this);
+	}
+
+	void job_system::submit(job_t job) {
+		{
+			std::unique_lock lock(this->sleep_mutex);
+			if (this->stopping) {
+				lock.unlock();
+				job();
+				return;
+			}
+			// counted before it is pushed, so shutdown can't let the last worker leave while this job is on its way in
+			this->queued.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		const std::size_t index = current_worker != static_cast<std::size_t>(-1)
+			? current_worker
+			: this->next_worker.fetch_add(1, std::memory_order_relaxed) % this->workers.size();
+
+		{
+			std::scoped_lock lock(this->workers[index]->mutex);
+			this->workers[index]->jobs.push_back(std::move(job));
+		}
+		this->wake.notify_one();
+	}
+
+	void job_system::post(job_t continuation) {
+		std::scoped_lock lock(this->continuation_mutex);
+		this->continuations.push_back(std::move(continuation));
+	}
+
+	std::size_t job_system::worker_count() const {
+		return this->workers.size();
+	}
+
+	bool job_system::pop(std::size_t index, job_t& out) {
+		// the owner takes its newest job, it is the one most likely to still be in cache
+		auto& self = *this->workers[index];
+		std::scoped_lock lock(self.mutex);
+		if (self.jobs.empty()) return false;
+
+		out = std::move(self.jobs.back());
+		self.jobs.pop_back();
+		return true;
+	}
+
+	bool job_system::steal(std::size_t index, job_t& out) {
+		// thieves take the oldest job from the other end, so they rarely fight the owner for the same one
+		for (std::size_t offset = 1; offset < this->workers.size(); offset++) {
+			auto& victim = *this->workers[(index + offset) % this->workers.size()];
+			std::scoped_lock lock(victim.mutex);
+			if (victim.jobs.empty()) continue;
+
+			out = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			return true;
+		}
+
+		return false;
+	}
+
+	void job_system::worker_loop(std::size_t index) {
+		current_worker = index;
+
+		while (true) {
+			job_t job;
+			if (this->pop(index, job) || this->steal(index, job)) {
+				this->queued.fetch_sub(1, std::memory_order_relaxed);
+				job();
+				continue;
+			}
+
+			std::unique_lock lock(this->sleep_mutex);
+			this->wake.wait(lock, [this] { return this->stopping || this->queued.load(std::memory_order_relaxed) > 0; });
+			if (this->stopping && this->queued.load(std::memory_order_relaxed) == 0) return;
+		}
+	}
+
+	// ticks keep coming while the game is minimized or occluded, results never wait for a frame that may not be drawn
+	void job_system::on_tick(minecraftgame_update_event& ev) {
+		this->run_continuations();
+	}
+
+	void job_system::run_continuations() {
+		{
+			std::scoped_lock lock(this->continuation_mutex);
+			this->running_continuations.swap(this->continuations);
+		}
+
+		// continuations may post more, those wait for the next frame
+		for (auto& continuation : this->running_continuations) {
+			continuation();
+		}
+		this->running_continuations.clear();
+	}
+};
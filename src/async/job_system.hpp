@@ -0,0 +1,120 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "task_scheduler.hpp"
+
+namespace selaura {
+	// a fixed pool of workers, each owning a deque that idle workers steal from
+	struct job_system {
+		using job_t = std::function<void()>;
+
+		job_system();
+		~job_system();
+		job_system(const job_system&) = delete;
+		job_system& operator=(const job_system&) = delete;
+
+		// continuations run at the start of every tick on the game thread, never inside a frame, and keep running while nothing is drawn
+		void init();
+
+		// runs every queued job and joins the workers, anything submitted afterwards runs on the caller
+		void shutdown();
+
+		// any thread, a job submitted from a worker lands on that worker's own deque
+		void submit(job_t job);
+
+		// runs work on a worker and hands whatever it returns to then on the game thread
+		template <typename F, typename Then>
+		void submit(F work, Then then) {
+			this->submit([this, work = std::move(work), then = std::move(then)]() mutable {
+				if constexpr (std::is_void_v<std::invoke_result_t<F&>>) {
+					work();
+					this->post(std::move(then));
+				}
+				else {
+					// std::function needs copyable callables, the result is shared rather than copied
+					auto result = std::make_shared<std::invoke_result_t<F&>>(work());
+					this->post([then = std::move(then), result = std::move(result)]() mutable {
+						then(std::move(*result));
+					});
+				}
+			});
+		}
+
+		// queues a callback for the next tick on the game thread
+		void post(job_t continuation);
+
+		std::size_t worker_count() const;
+	private:
+		struct worker {
+			std::mutex mutex;
+			std::deque<job_t> jobs;
+			std::thread thread;
+		};
+
+		void worker_loop(std::size_t index);
+		bool pop(std::size_t index, job_t& out);
+		bool steal(std::size_t index, job_t& out);
+		void on_tick(minecraftgame_update_event& ev);
+		void run_continuations();
+
+		std::vector<std::unique_ptr<worker>> workers;
+		std::atomic<std::size_t> next_worker{ 0 };
+
+		// queued is only raised under sleep_mutex so a worker can't miss the wakeup between checking and waiting
+		std::mutex sleep_mutex;
+		std::condition_variable wake;
+		std::atomic<std::size_t> queued{ 0 };
+		bool stopping = false;
+
+		std::mutex continuation_mutex;
+		std::vector<job_t> continuations;
+		std::vector<job_t> running_continuations;
+	};
+
+	job_system& get_job_system();
+
+	// co_await run_job(fn) runs fn on a worker and resumes the task from the next tick with its result, co_await next_frame() before drawing
+	template <typename F>
+	struct job_awaiter {
+		using result_t = std::invoke_result_t<F&>;
+		using stored_t = std::conditional_t<std::is_void_v<result_t>, std::monostate, result_t>;
+
+		F work;
+		// shared with the continuation, which may outlive a cancelled task
+		std::shared_ptr<std::optional<stored_t>> result = std::make_shared<std::optional<stored_t>>();
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(task::handle_t handle) {
+			const std::uint64_t id = handle.promise().id;
+			get_job_system().submit([work = std::move(this->work), result = this->result]() mutable {
+				if constexpr (std::is_void_v<result_t>) {
+					work();
+					result->emplace();
+				}
+				else {
+					result->emplace(work());
+				}
+			}, [id] {
+				get_task_scheduler().resume(id);
+			});
+		}
+		result_t await_resume() {
+			if constexpr (!std::is_void_v<result_t>) return std::move(**this->result);
+		}
+	};
+
+	template <typename F>
+	job_awaiter<F> run_job(F work) {
+		return { std::move(work) };
+	}
+};
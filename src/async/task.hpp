@@ -0,0 +1,54 @@
+#pragma once
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+namespace selaura {
+	// a fire and forget coroutine, it does nothing until handed to task_scheduler::spawn
+	struct task {
+		struct promise_type {
+			std::uint64_t id = 0;
+			std::exception_ptr error;
+
+			task get_return_object() {
+				return task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+			}
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			// the scheduler destroys finished frames, so they stay alive until it looks at them
+			std::suspend_always final_suspend() noexcept { return {}; }
+
+			void return_void() {}
+			void unhandled_exception() {
+				this->error = std::current_exception();
+			}
+		};
+
+		using handle_t = std::coroutine_handle<promise_type>;
+
+		task(task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+		task& operator=(task&& other) noexcept {
+			if (this != &other) {
+				if (this->handle) this->handle.destroy();
+				this->handle = std::exchange(other.handle, {});
+			}
+			return *this;
+		}
+
+		task(const task&) = delete;
+		task& operator=(const task&) = delete;
+
+		~task() {
+			if (this->handle) this->handle.destroy();
+		}
+
+		handle_t release() {
+			return std::exchange(this->handle, {});
+		}
+	private:
+		explicit task(handle_t handle) : handle(handle) {}
+
+		handle_t handle;
+	};
+};
@@ -0,0 +1,149 @@
+#include "task_scheduler.hpp"
+#include "../instance.hpp"
+
+#include <algorithm>
+
+namespace selaura {
+	task_scheduler& get_task_scheduler() {
+		return selaura::get_component<selaura::task_scheduler>();
+	}
+
+	task_scheduler::~task_scheduler() {
+		this->shutdown();
+	}
+
+	void task_scheduler::shutdown() {
+		for (auto& [id, entry] : this->tasks) {
+			entry.handle.destroy();
+		}
+		this->tasks.clear();
+		this->frame_waiters.clear();
+		this->tick_waiters.clear();
+		this->timers.clear();
+	}
+
+	void task_scheduler::init() {
+		this->evm = &selaura::get_component<selaura::event_manager>();
+		this->evm->subscribe<setupandrender_event>(&task_scheduler::on_frame, this);
+		this->evm->subscribe<minecraftgame_update_event>(&task_scheduler::on_tick, this);
+	}
+
+	void task_scheduler::spawn(task work, const void* owner) {
+		auto handle = work.release();
+		const std::uint64_t id = this->next_id++;
+		handle.promise().id = id;
+
+		this->tasks.emplace(id, entry{ handle, owner });
+		this->resume(id);
+	}
+
+	void task_scheduler::cancel(const void* owner) {
+		for (auto it = this->tasks.begin(); it != this->tasks.end();) {
+			if (it->second.owner != owner) {
+				++it;
+			}
+			else if (it->first == this->running) {
+				this->running_cancelled = true;
+				++it;
+			}
+			else {
+				auto next = std::next(it);
+				this->destroy(it);
+				it = next;
+			}
+		}
+	}
+
+	void task_scheduler::resume(std::uint64_t id) {
+		// waiters of destroyed tasks are left in the queues, missing ids are simply skipped
+		auto it = this->tasks.find(id);
+		if (it == this->tasks.end()) return;
+
+		const auto previous = std::exchange(this->running, id);
+		const bool previous_cancelled = std::exchange(this->running_cancelled, false);
+
+		auto handle = it->second.handle;
+		handle.resume();
+
+		const bool cancelled = this->running_cancelled;
+		this->running = previous;
+		this->running_cancelled = previous_cancelled;
+
+		if (!handle.done() && !cancelled) return;
+
+		if (auto error = handle.promise().error) {
+			try {
+				std::rethrow_exception(error);
+			}
+			catch (const std::exception& e) {
+				spdlog::error("Task threw: {}", e.what());
+			}
+			catch (...) {
+				spdlog::error("Task threw an unknown exception");
+			}
+		}
+
+		// resuming can spawn tasks and rehash the map, so look the entry up again
+		this->destroy(this->tasks.find(id));
+	}
+
+	void task_scheduler::destroy(std::unordered_map<std::uint64_t, entry>::iterator it) {
+		it->second.handle.destroy();
+		this->tasks.erase(it);
+	}
+
+	void task_scheduler::wait_frame(std::uint64_t id) {
+		this->frame_waiters.push_back(id);
+	}
+
+	void task_scheduler::wait_tick(std::uint64_t id) {
+		this->tick_waiters.push_back(id);
+	}
+
+	void task_scheduler::wait_until(std::chrono::steady_clock::time_point deadline, std::uint64_t id) {
+		this->timers.push_back({ deadline, id });
+	}
+
+	event_manager& task_scheduler::get_event_manager() {
+		return *this->evm;
+	}
+
+	std::size_t task_scheduler::size() const {
+		return this->tasks.size();
+	}
+
+	void task_scheduler::resume_all(std::vector<std::uint64_t>& waiting) {
+		// anything that waits again while resuming lands in the next batch, not this one
+		std::vector<std::uint64_t> current;
+		current.swap(waiting);
+		for (const auto id : current) {
+			this->resume(id);
+		}
+
+		current.clear();
+		if (waiting.empty()) waiting.swap(current);
+	}
+
+	void task_scheduler::on_frame(setupandrender_event& ev) {
+		this->resuming_frame = true;
+		this->resume_all(this->frame_waiters);
+		this->resuming_frame = false;
+	}
+
+	bool task_scheduler::in_frame() const {
+		return this->resuming_frame;
+	}
+
+	void task_scheduler::on_tick(minecraftgame_update_event& ev) {
+		const auto now = std::chrono::steady_clock::now();
+		auto expired = std::partition(this->timers.begin(), this->timers.end(), [&](const timer& t) {
+			return t.deadline > now;
+		});
+		for (auto it = expired; it != this->timers.end(); ++it) {
+			this->tick_waiters.push_back(it->id);
+		}
+		this->timers.erase(expired, this->timers.end());
+
+		this->resume_all(this->tick_waiters);
+	}
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "task.hpp"
+#include "../event/event_manager.hpp"
+
+namespace selaura {
+	// runs tasks on the game thread, frames come from SetupAndRender and ticks from MinecraftGame::update
+	// only next_frame resumes inside a frame, next_tick, sleep_for and run_job resume from ticks and keep going while nothing is drawn
+	struct task_scheduler {
+		task_scheduler() = default;
+		~task_scheduler();
+		task_scheduler(const task_scheduler&) = delete;
+		task_scheduler& operator=(const task_scheduler&) = delete;
+
+		void init();
+
+		// destroys every task, suspended ones included, no task resumes afterwards
+		void shutdown();
+
+		// runs the task up to its first co_await, owner lets cancel drop every task something started
+		void spawn(task work, const void* owner = nullptr);
+		void cancel(const void* owner);
+
+		// resumes a suspended task by id and retires it once it finishes, used by the awaiters
+		void resume(std::uint64_t id);
+
+		void wait_frame(std::uint64_t id);
+		void wait_tick(std::uint64_t id);
+		void wait_until(std::chrono::steady_clock::time_point deadline, std::uint64_t id);
+
+		// true only while a next_frame waiter is being resumed, an imgui frame is open then and drawing is allowed
+		bool in_frame() const;
+
+		event_manager& get_event_manager();
+		std::size_t size() const;
+	private:
+		struct entry {
+			task::handle_t handle;
+			const void* owner;
+		};
+
+		struct timer {
+			std::chrono::steady_clock::time_point deadline;
+			std::uint64_t id;
+		};
+
+		void on_frame(setupandrender_event& ev);
+		void on_tick(minecraftgame_update_event& ev);
+		void resume_all(std::vector<std::uint64_t>& waiting);
+		void destroy(std::unordered_map<std::uint64_t, entry>::iterator it);
+
+		event_manager* evm = nullptr;
+		std::unordered_map<std::uint64_t, entry> tasks;
+		std::uint64_t next_id = 1;
+		// a task that cancels its own owner is only destroyed once it suspends
+		std::uint64_t running = 0;
+		bool running_cancelled = false;
+
+		// true while on_frame resumes its waiters
+		bool resuming_frame = false;
+
+		std::vector<std::uint64_t> frame_waiters;
+		std::vector<std::uint64_t> tick_waiters;
+		std::vector<timer> timers;
+	};
+
+	task_scheduler& get_task_scheduler();
+
+	struct frame_awaiter {
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(task::handle_t handle) {
+			get_task_scheduler().wait_frame(handle.promise().id);
+		}
+		void await_resume() const noexcept {}
+	};
+
+	struct tick_awaiter {
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(task::handle_t handle) {
+			get_task_scheduler().wait_tick(handle.promise().id);
+		}
+		void await_resume() const noexcept {}
+	};
+
+	struct sleep_awaiter {
+		std::chrono::steady_clock::time_point deadline;
+
+		bool await_ready() const noexcept {
+			return std::chrono::steady_clock::now() >= this->deadline;
+		}
+		void await_suspend(task::handle_t handle) {
+			get_task_scheduler().wait_until(this->deadline, handle.promise().id);
+		}
+		void await_resume() const noexcept {}
+	};
+
+	// resumes inside the dispatch, so the task can read or cancel the event before anyone later sees it
+	template <typename T>
+	struct event_awaiter {
+		event_awaiter() = default;
+		event_awaiter(const event_awaiter&) = delete;
+		event_awaiter& operator=(const event_awaiter&) = delete;
+
+		~event_awaiter() {
+			if (this->token) get_task_scheduler().get_event_manager().unsubscribe<T>(this->token);
+		}
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(task::handle_t handle) {
+			const std::uint64_t id = handle.promise().id;
+			this->token = get_task_scheduler().get_event_manager().subscribe<T>([this, id](T& ev) {
+				if (!this->token) return;
+				this->event = &ev;
+				get_task_scheduler().get_event_manager().unsubscribe<T>(std::exchange(this->token, 0));
+				// nothing may touch this after resuming, the frame holding it can be gone by then
+				get_task_scheduler().resume(id);
+			});
+		}
+		T& await_resume() const noexcept {
+			return *this->event;
+		}
+	private:
+		event_manager::subscription_token token = 0;
+		T* event = nullptr;
+	};
+
+	inline frame_awaiter next_frame() {
+		return {};
+	}
+
+	inline tick_awaiter next_tick() {
+		return {};
+	}
+
+	inline sleep_awaiter sleep_for(std::chrono::milliseconds duration) {
+		return { std::chrono::steady_clock::now() + duration };
+	}
+
+	template <typename T>
+	event_awaiter<T> on_event() {
+		return {};
+	}
+};
@@ -0,0 +1,193 @@
+#include "config_manager.hpp"
+
+#include "../instance.hpp"
+#include "../util/byte_stream.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+namespace selaura {
+	namespace {
+		constexpr uint32_t config_magic = 0x464C4353; // "SCLF"
+		// 2 added the language after the features
+		constexpr uint16_t config_version = 2;
+	}
+
+	void config_manager::flush() {
+		// once the job system has shut down the write runs on the caller, so this still reaches the disk
+		if (!this->loaded || !this->dirty) return;
+		this->dirty = false;
+		this->submit(this->serialize());
+	}
+
+	void config_manager::init() {
+		auto startTime = std::chrono::steady_clock::now();
+		this->config_file = selaura::instance::get()->get_data_folder() / "config.bin";
+		this->features = &selaura::get_component<selaura::feature_manager>();
+
+		std::ifstream file(this->config_file, std::ios::binary);
+		if (file) {
+			std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+			this->applying = true;
+			this->deserialize(data);
+			this->applying = false;
+		}
+
+		this->loaded = true;
+		selaura::get_component<selaura::event_manager>().subscribe<minecraftgame_update_event>(&config_manager::on_update, this);
+
+		auto endTime = std::chrono::steady_clock::now();
+		spdlog::info("Loaded config [{}us]", std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count());
+	}
+
+	void config_manager::mark_dirty() {
+		if (!this->loaded || this->applying) return;
+		this->dirty = true;
+		this->last_change = std::chrono::steady_clock::now();
+	}
+
+	void config_manager::on_update(minecraftgame_update_event& ev) {
+		if (!this->dirty || std::chrono::steady_clock::now() - this->last_change < debounce) return;
+
+		// serializing is a few hundred bytes of copies, the file itself is written off thread
+		this->dirty = false;
+		this->submit(this->serialize());
+	}
+
+	std::vector<uint8_t> config_manager::serialize() const {
+		std::vector<uint8_t> data;
+		byte_writer out{ data };
+
+		auto& features = *this->features;
+
+		out.put(config_magic);
+		out.put(config_version);
+
+		uint32_t count = 0;
+		features.for_each([&](const feature&) { count++; });
+		out.put(count);
+
+		features.for_each([&](const feature& feat) {
+			out.put_string(feat.get_name());
+			out.put(static_cast<uint8_t>(feat.is_enabled()));
+			out.put(static_cast<int32_t>(feat.get_hotkey()));
+			out.put(feat.get_feature_pos());
+			out.put(feat.get_feature_size());
+
+			const auto settings = feat.get_settings();
+			out.put(static_cast<uint16_t>(settings.size()));
+			for (const auto& setting : settings) {
+				out.put_string(setting.name);
+				out.put(static_cast<uint8_t>(setting.value.index()));
+				std::visit([&](const auto& value) { out.put(value); }, setting.value);
+			}
+		});
+
+		out.put_string(selaura::get_component<selaura::localization>().get_language());
+
+		return data;
+	}
+
+	void config_manager::deserialize(const std::vector<uint8_t>& data) {
+		byte_reader in{ data.data(), data.data() + data.size() };
+
+		const auto magic = in.get<uint32_t>();
+		const auto version = in.get<uint16_t>();
+		if (magic != config_magic || version == 0 || version > config_version || !in.ok) {
+			spdlog::warn("Ignoring config.bin with an unknown header");
+			return;
+		}
+
+		auto& features = *this->features;
+		const auto count = in.get<uint32_t>();
+
+		for (uint32_t i = 0; i < count && in.ok; i++) {
+			const auto name = in.get_string();
+			const bool enabled = in.get<uint8_t>() != 0;
+			const auto hotkey = in.get<int32_t>();
+			const auto pos = in.get<glm::vec2>();
+			const auto size = in.get<glm::vec2>();
+			const auto setting_count = in.get<uint16_t>();
+
+			feature* target = nullptr;
+			features.for_each([&](feature& feat) {
+				if (feat.get_name() == name) target = &feat;
+			});
+
+			for (uint16_t s = 0; s < setting_count && in.ok; s++) {
+				const auto setting_name = in.get_string();
+				const auto type = in.get<uint8_t>();
+
+				feature_setting_type value;
+				switch (type) {
+					case 0: value = in.get<float>(); break;
+					case 1: value = in.get<uint8_t>() != 0; break;
+					case 2: value = in.get<int>(); break;
+					case 3: value = in.get<glm::vec4>(); break;
+					default: in.ok = false; continue;
+				}
+
+				// settings that were renamed or changed type keep their defaults
+				if (!target) continue;
+				const auto settings = target->get_settings();
+				for (std::size_t idx = 0; idx < settings.size(); idx++) {
+					if (settings[idx].name == setting_name && settings[idx].value.index() == type) {
+						target->set_setting(idx, value);
+					}
+				}
+			}
+
+			if (!target || !in.ok) continue;
+			target->set_hotkey(hotkey);
+			target->set_feature_position(pos);
+			target->set_feature_size(size);
+			target->set_enabled(enabled);
+		}
+
+		if (version >= 2 && in.ok) {
+			const auto language = in.get_string();
+			if (in.ok && !selaura::get_component<selaura::localization>().apply_language(language)) {
+				spdlog::warn("Saved language {} is gone, keeping {}", language, selaura::get_component<selaura::localization>().get_language());
+			}
+		}
+
+		if (!in.ok) spdlog::warn("config.bin is truncated, loaded what was readable");
+	}
+
+	void config_manager::submit(std::vector<uint8_t>&& data) {
+		std::scoped_lock lock(this->mutex);
+		this->pending = std::move(data);
+
+		if (this->write_queued) return;
+		this->write_queued = true;
+		selaura::get_component<selaura::job_system>().submit([this] { this->write_pending(); });
+	}
+
+	void config_manager::write_pending() {
+		std::unique_lock lock(this->mutex);
+
+		while (this->pending) {
+			auto data = std::move(*this->pending);
+			this->pending.reset();
+			lock.unlock();
+
+			// write next to the real file and rename over it, a crash mid-write leaves the old config intact
+			auto temp_file = this->config_file;
+			temp_file += ".tmp";
+			{
+				std::ofstream file(temp_file, std::ios::binary | std::ios::trunc);
+				file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+			}
+
+			std::error_code ec;
+			std::filesystem::rename(temp_file, this->config_file, ec);
+			if (ec) spdlog::error("Failed to save config: {}", ec.message());
+
+			lock.lock();
+		}
+
+		this->write_queued = false;
+	}
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace selaura {
+	struct minecraftgame_update_event;
+	struct feature_manager;
+
+	struct config_manager {
+		config_manager() = default;
+		config_manager(const config_manager&) = delete;
+		config_manager& operator=(const config_manager&) = delete;
+
+		// reads config.bin into the registered features, call once features exist
+		void init();
+
+		// cheap, any number of changes inside the debounce window become one write
+		void mark_dirty();
+
+		// writes out changes still inside the debounce window, called while every component is still alive
+		void flush();
+
+		static constexpr std::chrono::milliseconds debounce{ 1000 };
+	private:
+		void on_update(minecraftgame_update_event& ev);
+		std::vector<uint8_t> serialize() const;
+		void deserialize(const std::vector<uint8_t>& data);
+		void submit(std::vector<uint8_t>&& data);
+		// job, writes whatever is pending until nothing is, so only one write is ever in flight
+		void write_pending();
+
+		feature_manager* features = nullptr;
+		std::filesystem::path config_file;
+		bool loaded = false;
+		bool applying = false;
+		bool dirty = false;
+		std::chrono::steady_clock::time_point last_change{};
+
+		std::mutex mutex;
+		std::optional<std::vector<uint8_t>> pending;
+		bool write_queued = false;
+	};
+};
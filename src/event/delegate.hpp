@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace selaura {
+    template <typename signature>
+    struct delegate;
+
+    // fixed size callable, small lambdas and member-function-plus-instance live inline and are called through one thunk
+    // anything bigger is a compile error rather than a hidden heap allocation, capture a pointer to it instead
+    template <typename R, typename... Args>
+    struct delegate<R(Args...)> {
+        static constexpr std::size_t capacity = 4 * sizeof(void*);
+
+        delegate() = default;
+
+        template <typename F>
+            requires (!std::is_same_v<std::remove_cvref_t<F>, delegate> && std::is_invocable_r_v<R, F&, Args...>)
+        delegate(F&& callable) {
+            using fn_t = std::decay_t<F>;
+            static_assert(sizeof(fn_t) <= capacity && alignof(fn_t) <= alignof(std::max_align_t), "callable is too big for a delegate, capture a pointer instead");
+            static_assert(std::is_nothrow_move_constructible_v<fn_t>, "delegates move their callable around, it must not throw doing so");
+
+            ::new (static_cast<void*>(this->storage)) fn_t(std::forward<F>(callable));
+            this->thunk = [](void* storage, Args... args) -> R {
+                return (*std::launder(static_cast<fn_t*>(storage)))(std::forward<Args>(args)...);
+            };
+
+            // trivially copyable callables, which is nearly all of them, are copied bytewise and need no manager
+            if constexpr (!std::is_trivially_copyable_v<fn_t>) {
+                this->manager = [](operation op, void* dst, void* src) {
+                    auto* source = std::launder(static_cast<fn_t*>(src));
+                    switch (op) {
+                        case operation::copy: ::new (dst) fn_t(*source); break;
+                        case operation::move: ::new (dst) fn_t(std::move(*source)); source->~fn_t(); break;
+                        case operation::destroy: source->~fn_t(); break;
+                    }
+                };
+            }
+        }
+
+        // binds a member function at compile time, only the instance pointer is stored
+        template <auto member, typename C>
+        static delegate bind(C* instance) {
+            return delegate([instance](Args... args) -> R { return (instance->*member)(std::forward<Args>(args)...); });
+        }
+
+        delegate(const delegate& other) {
+            this->copy_from(other);
+        }
+
+        delegate(delegate&& other) noexcept {
+            this->move_from(other);
+        }
+
+        delegate& operator=(const delegate& other) {
+            if (this != &other) {
+                this->reset();
+                this->copy_from(other);
+            }
+            return *this;
+        }
+
+        delegate& operator=(delegate&& other) noexcept {
+            if (this != &other) {
+                this->reset();
+                this->move_from(other);
+            }
+            return *this;
+        }
+
+        ~delegate() {
+            this->reset();
+        }
+
+        R operator()(Args... args) const {
+            return this->thunk(const_cast<std::byte*>(this->storage), std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept {
+            return this->thunk != nullptr;
+        }
+
+    private:
+        enum class operation {
+            copy,
+            move,
+            destroy
+        };
+
+        void reset() noexcept {
+            if (this->manager) this->manager(operation::destroy, nullptr, this->storage);
+            this->thunk = nullptr;
+            this->manager = nullptr;
+        }
+
+        void copy_from(const delegate& other) {
+            if (other.manager) other.manager(operation::copy, this->storage, const_cast<std::byte*>(other.storage));
+            else if (other.thunk) std::memcpy(this->storage, other.storage, capacity);
+            this->thunk = other.thunk;
+            this->manager = other.manager;
+        }
+
+        void move_from(delegate& other) noexcept {
+            if (other.manager) other.manager(operation::move, this->storage, other.storage);
+            else if (other.thunk) std::memcpy(this->storage, other.storage, capacity);
+            this->thunk = std::exchange(other.thunk, nullptr);
+            this->manager = std::exchange(other.manager, nullptr);
+        }
+
+        alignas(std::max_align_t) std::byte storage[capacity];
+        R (*thunk)(void*, Args...) = nullptr;
+        void (*manager)(operation, void*, void*) = nullptr;
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+#include "event_manager.hpp"
+
+namespace selaura {
+    // the events an object consumes, subscribed only while it is attached
+    struct event_bindings {
+        event_bindings() = default;
+        event_bindings(const event_bindings&) = delete;
+        event_bindings& operator=(const event_bindings&) = delete;
+
+        ~event_bindings() {
+            detach();
+        }
+
+        template <typename T>
+        void add(event_manager::listener_t<T> handler, listener_options options = {}) {
+            binding entry;
+            entry.subscribe = [handler = std::move(handler), options](event_manager& evm) {
+                return evm.subscribe<T>(handler, options);
+            };
+            entry.unsubscribe = [](event_manager& evm, event_manager::subscription_token token) {
+                evm.unsubscribe<T>(token);
+            };
+            if (evm) entry.token = entry.subscribe(*evm);
+            bindings.push_back(std::move(entry));
+        }
+
+        void attach(event_manager& manager) {
+            if (evm) return;
+            evm = &manager;
+            for (auto& entry : bindings)
+                entry.token = entry.subscribe(manager);
+        }
+
+        // uses the manager it attached to, so detaching during shutdown never looks the component up again
+        void detach() {
+            if (!evm) return;
+            for (auto& entry : bindings)
+                entry.unsubscribe(*evm, entry.token);
+            evm = nullptr;
+        }
+
+        bool attached() const {
+            return evm != nullptr;
+        }
+
+    private:
+        struct binding {
+            std::function<event_manager::subscription_token(event_manager&)> subscribe;
+            void (*unsubscribe)(event_manager&, event_manager::subscription_token) = nullptr;
+            event_manager::subscription_token token = 0;
+        };
+
+        std::vector<binding> bindings;
+        event_manager* evm = nullptr;
+    };
+};
@@ -1,4 +1,16 @@
 #include "event_manager.hpp"
 
 namespace selaura {
-};
\ No newline at end of file
+    void event_manager::quiesce() {
+        std::vector<retired_entry> reclaim;
+        {
+            std::scoped_lock lock(write_mutex);
+            // a dispatch that started before this point may still hold a retired snapshot, try again next frame
+            if (retired.entries.empty() || readers.load(std::memory_order_seq_cst) != 0) return;
+            reclaim.swap(retired.entries);
+        }
+
+        for (auto& entry : reclaim)
+            entry.destroy(entry.ptr);
+    }
+};
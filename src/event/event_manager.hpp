@@ -1,40 +1,173 @@
 #pragma once
-#include <functional>
 #include <vector>
 #include <algorithm>
 #include <memory>
 #include <cstdint>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
 
+#include "delegate.hpp"
 #include "impl/event_types.hpp"
+#include "../profiler/profiler.hpp"
+#include "../profiler/memory.hpp"
 
 namespace selaura {
+    // higher runs first, equal priorities keep subscription order
+    enum class event_priority : std::int8_t {
+        lowest = -2,
+        low = -1,
+        normal = 0,
+        high = 1,
+        highest = 2
+    };
+
+    struct listener_options {
+        event_priority priority = event_priority::normal;
+        // still called once an earlier listener cancelled the event, for listeners that only observe
+        bool receive_cancelled = false;
+    };
+
     struct event_manager {
     public:
         using subscription_token = std::uint64_t;
 
+        event_manager() = default;
+        event_manager(const event_manager&) = delete;
+        event_manager& operator=(const event_manager&) = delete;
+
         template<typename T>
-        using listener_t = std::function<void(T& event)>;
+        using listener_t = delegate<void(T& event)>;
+
+        template <typename U>
+        struct counting_allocator {
+            using value_type = U;
+
+            counting_allocator() = default;
+            template <typename V>
+            counting_allocator(const counting_allocator<V>&) noexcept {}
+
+            U* allocate(std::size_t n) {
+                allocations.fetch_add(1, std::memory_order_relaxed);
+                return memory::allocator<U, memory::tag::events>{}.allocate(n);
+            }
 
+            void deallocate(U* ptr, std::size_t n) noexcept {
+                memory::allocator<U, memory::tag::events>{}.deallocate(ptr, n);
+            }
+
+            template <typename V>
+            bool operator==(const counting_allocator<V>&) const noexcept { return true; }
+        };
+
+        // read-copy-update: dispatch walks an immutable snapshot it loaded once, writers build and publish a new one
+        // replaced snapshots and removed listeners are freed at the next quiescent point with no dispatch in flight
         template<typename T>
         struct listener_container {
-            struct listener_entry {
+            struct listener_node : memory::tracked<memory::tag::events> {
                 subscription_token token;
-                std::function<void(T&)> callback;
-                void* instance = nullptr;
-                void* memberFunction = nullptr;
+                listener_t<T> callback;
+                listener_options options;
+                // set on unsubscribe, dispatches still walking an older snapshot skip the node from then on
+                std::atomic<bool> removed{ false };
             };
-            std::vector<listener_entry> listeners;
+
+            struct snapshot : memory::tracked<memory::tag::events> {
+                std::vector<listener_node*, counting_allocator<listener_node*>> nodes;
+            };
+
+            std::atomic<snapshot*> current{ nullptr };
+            // writer side, only touched under write_mutex
             subscription_token nextToken = 1;
+
+            ~listener_container() {
+                if (auto* snap = current.load(std::memory_order_relaxed)) {
+                    for (auto* node : snap->nodes)
+                        delete node;
+                    delete snap;
+                }
+            }
+
+            // sorted when the list changes, dispatch just walks it
+            void insert(listener_node* node) {
+                auto* old = current.load(std::memory_order_relaxed);
+                auto* next = new snapshot();
+                if (old) {
+                    next->nodes.reserve(old->nodes.size() + 1);
+                    next->nodes.assign(old->nodes.begin(), old->nodes.end());
+                }
+
+                auto it = std::upper_bound(next->nodes.begin(), next->nodes.end(), node->options.priority, [](event_priority priority, const listener_node* other) {
+                    return priority > other->options.priority;
+                });
+                next->nodes.insert(it, node);
+                publish(old, next);
+            }
+
+            void remove(subscription_token token) {
+                auto* old = current.load(std::memory_order_relaxed);
+                if (!old) return;
+
+                auto found = std::find_if(old->nodes.begin(), old->nodes.end(), [&](const listener_node* node) { return node->token == token; });
+                if (found == old->nodes.end()) return;
+
+                listener_node* node = *found;
+                node->removed.store(true, std::memory_order_release);
+
+                auto* next = new snapshot();
+                next->nodes.reserve(old->nodes.size() - 1);
+                for (auto* other : old->nodes) {
+                    if (other != node) next->nodes.push_back(other);
+                }
+                publish(old, next);
+                retire(node);
+            }
+
+            void publish(snapshot* old, snapshot* next) {
+                current.store(next, std::memory_order_seq_cst);
+                if (old) retire(old);
+            }
         };
 
+        // number of times listener storage hit the heap; stays flat across steady-state dispatches
+        static std::uint64_t get_allocation_count() {
+            return allocations.load(std::memory_order_relaxed);
+        }
+
+        // lock free, any thread may dispatch while any other subscribes
         template <typename T>
         void dispatch(T& event) {
-            auto listenersCopy = get_listener_container<T>().listeners;
-            for (const auto& entry : listenersCopy) {
-                entry.callback(event);
+            SELAURA_PROFILE_SCOPE(profiler::type_name<T>());
+            auto& container = get_listener_container<T>();
+
+            read_guard guard;
+            auto* snap = container.current.load(std::memory_order_seq_cst);
+            if (!snap) return;
+
+            for (auto* node : snap->nodes) {
+                if (node->removed.load(std::memory_order_acquire))
+                    continue;
+
+                // once cancelled, only listeners that asked to see cancelled events are still called
+                if constexpr (std::is_base_of_v<cancellable, T>) {
+                    if (*event.cancelled && !node->options.receive_cancelled)
+                        continue;
+                }
+
+                node->callback(event);
             }
         }
 
+        // for callers that would have to build the event before anyone wants it
+        template <typename T>
+        bool has_listeners() {
+            // the snapshot is dereferenced, so it has to be pinned against quiesce like a dispatch does
+            read_guard guard;
+            auto* snap = get_listener_container<T>().current.load(std::memory_order_seq_cst);
+            return snap && !snap->nodes.empty();
+        }
+
         template <typename T>
         void dispatch() {
             T event{};
@@ -42,104 +175,75 @@ namespace selaura {
         }
 
         template <typename T>
-        subscription_token subscribe(std::function<void(T&)> listener) {
+        subscription_token subscribe(listener_t<T> listener, listener_options options = {}) {
             auto& container = get_listener_container<T>();
-            subscription_token token = container.nextToken++;
-            typename listener_container<T>::listener_entry entry;
-            entry.token = token;
-            entry.callback = std::move(listener);
-            entry.instance = nullptr;
-            entry.memberFunction = nullptr;
-            container.listeners.push_back(std::move(entry));
-            return token;
-        }
-
-        template <typename T, typename Func>
-        subscription_token subscribe(Func listener) {
-            return subscribe<T>(listener_t<T>{listener});
-        }
+            std::scoped_lock lock(write_mutex);
 
-        template <typename T, typename C>
-        subscription_token subscribe(void (C::* listener)(T&), C* instance) {
-            auto& container = get_listener_container<T>();
-            subscription_token token = container.nextToken++;
-            typename listener_container<T>::listener_entry entry;
-            entry.token = token;
-            entry.callback = [instance, listener](T& event) {
-                (instance->*listener)(event);
-                };
-            entry.instance = static_cast<void*>(instance);
-            entry.memberFunction = *reinterpret_cast<void**>(&listener);
-            container.listeners.push_back(std::move(entry));
-            return token;
-        }
-
-        template <typename T>
-        void unsubscribe(const std::function<void(T&)>& listener) {
-            auto& entries = get_listener_container<T>().listeners;
-            for (auto it = entries.begin(); it != entries.end(); ++it) {
-                if (it->instance != nullptr)
-                    continue;
-                if (it->callback.target_type() != listener.target_type())
-                    continue;
-                if (auto ptr1 = it->callback.template target<void(*)(T&)>()) {
-                    if (auto ptr2 = listener.template target<void(*)(T&)>()) {
-                        if (*ptr1 == *ptr2) {
-                            entries.erase(it);
-                            return;
-                        }
-                    }
-                }
-                if (it->callback.template target<void>() == listener.template target<void>()) {
-                    entries.erase(it);
-                    return;
-                }
-            }
+            auto* node = new listener_node_t<T>{ {}, container.nextToken++, std::move(listener), options };
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            container.insert(node);
+            return node->token;
         }
 
+        // lambdas and free functions, stored inline in the listener list
         template <typename T, typename Func>
-        void unsubscribe(Func listener) {
-            unsubscribe<T>(listener_t<T>{listener});
+            requires (!std::is_same_v<std::remove_cvref_t<Func>, listener_t<T>>)
+        subscription_token subscribe(Func&& listener, listener_options options = {}) {
+            return subscribe<T>(listener_t<T>{ std::forward<Func>(listener) }, options);
         }
 
         template <typename T, typename C>
-        void unsubscribe(void (C::* listener)(T&), C* instance) {
-            auto& entries = get_listener_container<T>().listeners;
-            void* targetInstance = static_cast<void*>(instance);
-            void* targetMemberFunc = *reinterpret_cast<void**>(&listener);
-            for (auto it = entries.begin(); it != entries.end(); ++it) {
-                if (it->instance == targetInstance && it->memberFunction == targetMemberFunc) {
-                    entries.erase(it);
-                    return;
-                }
-            }
+        subscription_token subscribe(void (C::* listener)(T&), C* instance, listener_options options = {}) {
+            return subscribe<T>(listener_t<T>{ [instance, listener](T& event) { (instance->*listener)(event); } }, options);
         }
 
+        // tokens are the only handle on a listener, whatever subscribed keeps the one it got back
+        // safe from inside a dispatch, the listener is skipped from the moment this returns
         template <typename T>
-        subscription_token subscribe(void (*listener)(T&)) {
+        void unsubscribe(subscription_token token) {
             auto& container = get_listener_container<T>();
-            subscription_token token = container.nextToken++;
-            typename listener_container<T>::listener_entry entry;
-            entry.token = token;
-            entry.callback = listener;
-            entry.instance = nullptr;
-            entry.memberFunction = reinterpret_cast<void*>(listener);
-            container.listeners.push_back(std::move(entry));
-            return token;
+            std::scoped_lock lock(write_mutex);
+            container.remove(token);
         }
 
+        // frees what writers retired if no dispatch is running anywhere, called once per game frame
+        static void quiesce();
+    private:
         template <typename T>
-        void unsubscribe(void (*listener)(T&)) {
-            auto& entries = get_listener_container<T>().listeners;
-            void* targetFunc = reinterpret_cast<void*>(listener);
-            for (auto it = entries.begin(); it != entries.end(); ++it) {
-                if (it->memberFunction == targetFunc && it->instance == nullptr) {
-                    entries.erase(it);
-                    return;
-                }
+        using listener_node_t = typename listener_container<T>::listener_node;
+
+        struct retired_entry {
+            void* ptr;
+            void (*destroy)(void*);
+        };
+
+        // everything is static like the containers themselves, so components detaching during teardown never touch a dead manager
+        inline static std::atomic<std::uint64_t> allocations{ 0 };
+        inline static std::atomic<std::uint32_t> readers{ 0 };
+        inline static std::mutex write_mutex;
+        struct retired_list {
+            std::vector<retired_entry> entries;
+
+            ~retired_list() {
+                for (auto& entry : entries)
+                    entry.destroy(entry.ptr);
             }
+        };
+        inline static retired_list retired;
+
+        struct read_guard {
+            read_guard() { readers.fetch_add(1, std::memory_order_seq_cst); }
+            ~read_guard() { readers.fetch_sub(1, std::memory_order_release); }
+            read_guard(const read_guard&) = delete;
+            read_guard& operator=(const read_guard&) = delete;
+        };
+
+        // under write_mutex
+        template <typename U>
+        static void retire(U* ptr) {
+            retired.entries.push_back({ ptr, [](void* p) { delete static_cast<U*>(p); } });
         }
-    private:
+
         template<typename T>
         listener_container<T>& get_listener_container() {
             static listener_container<T> container;
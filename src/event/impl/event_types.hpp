@@ -4,6 +4,8 @@
 #include "../../renderer/renderer.hpp"
 #include "../../input/key.hpp"
 
+#include <memory_resource>
+
 namespace selaura {
 	struct cancellable {
 		bool* cancelled;
@@ -15,9 +17,12 @@ namespace selaura {
 	};
 	struct minecraftgame_update_event {};
 	struct setupandrender_event {
-		MinecraftUIRenderContext* ctx;
+		// render context, screen size, scale and layer as read once at the top of the frame
+		const selaura::frame_context& frame;
 		selaura::renderer& renderer;
 		ScreenView* screen_view;
+		// frame-lifetime allocations, reset once the frame is drawn
+		std::pmr::memory_resource* arena;
 	};
 
 	struct key_event : public cancellable {
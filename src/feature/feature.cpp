@@ -1,12 +1,73 @@
 #include "feature.hpp"
+#include "../instance.hpp"
+#include "../hook/impl/render_hooks.hpp"
+
+#include <mutex>
+#include <unordered_set>
 
 namespace selaura {
+	std::string_view intern_setting_name(std::string_view name) {
+		static std::mutex mutex;
+		static std::unordered_set<std::string> names;
+
+		std::scoped_lock lock(mutex);
+		return *names.emplace(name).first;
+	}
+
+	void feature::set_setting(std::size_t index, const feature_setting_type& value) {
+		auto& setting = this->settings[index];
+		if (setting.value == value) return;
+
+		setting.value = value;
+		setting.dirty = true;
+		selaura::get_component<selaura::config_manager>().mark_dirty();
+		if (this->hud_drawer) this->mark_hud_dirty();
+
+		for (const auto& [target, callback] : this->setting_callbacks) {
+			if (target == index) callback(setting);
+		}
+	}
+
+	bool feature::consume_setting_dirty(std::size_t index) {
+		return std::exchange(this->settings[index].dirty, false);
+	}
+
+	void feature::on_setting_changed(std::size_t index, std::function<void(const feature_setting&)> callback) {
+		this->setting_callbacks.emplace_back(index, std::move(callback));
+	}
 	feature::~feature() noexcept {
 		this->enabled = false;
 	}
 
 	void feature::set_enabled(bool enabled) {
+		if (this->enabled == enabled) return;
 		this->enabled = enabled;
+		selaura::get_component<selaura::config_manager>().mark_dirty();
+
+		auto& renderer = selaura::get_component<selaura::renderer>();
+		renderer.get_pacer().invalidate();
+		if (enabled) renderer.get_layers().want(this->layers);
+		else renderer.get_layers().release(this->layers);
+
+		auto& hooks = selaura::get_component<selaura::hook_manager>();
+		for (const auto& dependency : this->hooks) {
+			if (enabled) hooks.acquire(dependency);
+			else hooks.release(dependency);
+		}
+
+		if (enabled) {
+			this->bindings.attach(selaura::get_component<selaura::event_manager>());
+			this->on_enable();
+		}
+		else {
+			this->bindings.detach();
+			selaura::get_component<selaura::task_scheduler>().cancel(this);
+			this->on_disable();
+		}
+	}
+
+	void feature::spawn(task work) {
+		selaura::get_component<selaura::task_scheduler>().spawn(std::move(work), this);
 	}
 
 	bool feature::is_enabled() const {
@@ -14,30 +75,73 @@ namespace selaura {
 	}
 
 	void feature::toggle() {
-		this->enabled = !this->enabled;
+		this->set_enabled(!this->enabled);
 	}
 
 	void feature::set_hotkey(int hotkey) {
+		if (this->hotkey == hotkey) return;
+		selaura::get_component<selaura::input_manager>().get_hotkeys().bind(this->hotkey, hotkey, { this, nullptr });
 		this->hotkey = hotkey;
+		selaura::get_component<selaura::config_manager>().mark_dirty();
 	}
 
 	int feature::get_hotkey() const {
 		return this->hotkey;
 	}
 
+	std::span<const layer_hash> feature::get_layers() const {
+		return this->layers;
+	}
+
+	void feature::draw_on(std::string_view layer) {
+		const layer_hash hash = HashedString::fnv1a_64(layer);
+		if (std::ranges::find(this->layers, hash) != this->layers.end()) return;
+		this->layers.push_back(hash);
+		if (this->enabled) selaura::get_component<selaura::renderer>().get_layers().want({ &hash, 1 });
+		this->require_hooks<render_hooks>();
+	}
+
+	void feature::require_hooks(const hook_dependency& dependency) {
+		if (std::ranges::find(this->hooks, dependency) != this->hooks.end()) return;
+		this->hooks.push_back(dependency);
+		if (this->enabled) selaura::get_component<selaura::hook_manager>().acquire(dependency);
+	}
+
 	void feature::on_enable() {}
 	void feature::on_disable() {}
 
 	void feature::set_feature_size(const glm::vec2& size) {
 		this->size = size;
+		selaura::get_component<selaura::config_manager>().mark_dirty();
+		if (this->hud_drawer) this->mark_hud_dirty();
 	}
 	void feature::set_feature_position(const glm::vec2& pos) {
 		this->pos = pos;
+		selaura::get_component<selaura::config_manager>().mark_dirty();
+		if (this->hud_drawer) this->mark_hud_dirty();
 	}
-	const glm::vec2& feature::get_feature_size() {
+
+	void feature::mark_hud_dirty() {
+		this->hud_version.fetch_add(1, std::memory_order_relaxed);
+		selaura::get_component<selaura::renderer>().get_pacer().invalidate();
+	}
+
+	void feature::on_hud_render(setupandrender_event& ev) {
+		ev.renderer.get_hud().draw(this, this->hud_version.load(std::memory_order_relaxed), this->hud_drawer);
+	}
+	const glm::vec2& feature::get_feature_size() const {
 		return this->size;
 	}
-	const glm::vec2& feature::get_feature_pos() {
+	const glm::vec2& feature::get_feature_pos() const {
 		return this->pos;
 	}
+	std::string_view feature::get_name() const {
+		return this->name;
+	}
+	std::string_view feature::get_description() const {
+		return this->description;
+	}
+	feature_category feature::get_category() const {
+		return this->category;
+	}
 };
\ No newline at end of file
@@ -3,10 +3,22 @@
 #include <vector>
 #include <string>
 #include <variant>
+#include <span>
+#include <string_view>
+#include <functional>
+#include <cstdint>
+#include <atomic>
+#include <type_traits>
 
 #include <glm/glm.hpp>
+#include <imgui.h>
 #include <libhat/fixed_string.hpp>
 #include "../event/event_manager.hpp"
+#include "../event/event_bindings.hpp"
+#include "../async/task.hpp"
+#include "../renderer/render_layers.hpp"
+#include "../hook/hook_dependency.hpp"
+#include "../profiler/memory.hpp"
 
 namespace selaura {
 
@@ -17,18 +29,53 @@ namespace selaura {
 		glm::vec4 // color
 	>;
 
+	// names are interned, settings live by value in their feature's array
 	struct feature_setting {
-		std::string name;
+		std::string_view name;
 		feature_setting_type value;
+		bool dirty = false;
 	};
 
-	template <hat::fixed_string name_str = "String Not Found", hat::fixed_string description_str = "Description Not Found">
+	// returns a view that stays valid for the lifetime of the process, equal names share storage
+	std::string_view intern_setting_name(std::string_view name);
+
+	struct feature;
+
+	// index based so it survives the settings array growing
+	template <typename T>
+	struct setting_handle {
+		feature* owner = nullptr;
+		std::uint32_t index = 0;
+
+		const T& get() const;
+		void set(const T& value) const;
+
+		// true once after every change, for consumers that cache derived values
+		bool consume_dirty() const;
+		void on_change(std::function<void(const T&)> callback) const;
+	};
+
+	// where the click gui lists a feature, fixed at compile time through its traits
+	enum class feature_category : std::uint8_t {
+		general,
+		visual,
+		combat,
+		utility,
+		count
+	};
+
+	inline constexpr std::string_view feature_category_names[] = { "General", "Visual", "Combat", "Utility" };
+	static_assert(std::size(feature_category_names) == static_cast<std::size_t>(feature_category::count));
+
+	template <hat::fixed_string name_str = "String Not Found", hat::fixed_string description_str = "Description Not Found", feature_category category_v = feature_category::general>
 	struct feature_traits {
 		static constexpr auto name = name_str;
 		static constexpr auto description = description_str;
+		static constexpr feature_category category = category_v;
 	};
 
-#define DEFINE_FEATURE_TRAITS(name, description) using info = feature_traits<name, description>;
+	// the category is optional and defaults to general
+#define DEFINE_FEATURE_TRAITS(name, description, ...) using info = feature_traits<name, description __VA_OPT__(,) __VA_ARGS__>;
 
 	struct feature {
 		using info = feature_traits<>;
@@ -45,25 +92,115 @@ namespace selaura {
 		void set_hotkey(int hotkey = 0);
 		int get_hotkey() const;
 
-		template<typename setting_t = feature_setting, typename... args_t>
-		auto* add_settings(args_t... args) {
-			return settings.emplace_back(std::make_unique<setting_t>(std::forward<args_t>(args)...)).get();
+		template <typename T>
+		setting_handle<T> add_setting(std::string_view name, T value) {
+			settings.push_back({ intern_setting_name(name), feature_setting_type{ std::move(value) } });
+			return { this, static_cast<std::uint32_t>(settings.size() - 1) };
 		}
 
-		const std::vector<std::unique_ptr<feature_setting>>& get_settings() const {
+		std::span<const feature_setting> get_settings() const {
 			return settings;
 		}
 
+		// marks the setting dirty and runs its change callbacks, a no-op if the value is unchanged
+		void set_setting(std::size_t index, const feature_setting_type& value);
+		bool consume_setting_dirty(std::size_t index);
+		void on_setting_changed(std::size_t index, std::function<void(const feature_setting&)> callback);
+
 		virtual void set_feature_size(const glm::vec2& size);
 		virtual void set_feature_position(const glm::vec2& pos);
-		const glm::vec2& get_feature_size();
-		const glm::vec2& get_feature_pos();
+		const glm::vec2& get_feature_size() const;
+		const glm::vec2& get_feature_pos() const;
+
+		// the registered type's traits name, filled in by feature_manager and used as the config key
+		std::string_view get_name() const;
+		// empty when the traits have none
+		std::string_view get_description() const;
+		feature_category get_category() const;
+
+		std::span<const layer_hash> get_layers() const;
+
+	protected:
+		// handlers are only subscribed while the feature is enabled, call from the constructor
+		// render handlers only run while one of the feature's layers is on screen
+		template <typename T, typename C>
+		void listen(void (C::*handler)(T&), listener_options options = {}) {
+			if constexpr (std::is_same_v<T, setupandrender_event>) {
+				bindings.add<T>([this, handler](T& ev) {
+					if (ev.renderer.layers_visible(this->layers)) (static_cast<C*>(this)->*handler)(ev);
+				}, options);
+			}
+			else {
+				bindings.add<T>([this, handler](T& ev) { (static_cast<C*>(this)->*handler)(ev); }, options);
+			}
+		}
+
+		// root layer names (hud_screen, start_screen, ...) the feature renders on, views showing none of them are skipped
+		void draw_on(std::string_view layer);
+
+		// a hud module, drawn into a cached list of its own that is only recorded again after mark_hud_dirty
+		// settings, position and size changes mark it dirty already, call from the constructor after draw_on
+		template <typename C>
+		void draw_hud(void (C::*handler)(ImDrawList&)) {
+			this->hud_drawer = [this, handler](ImDrawList& list) { (static_cast<C*>(this)->*handler)(list); };
+			this->listen(&feature::on_hud_render);
+		}
+
+		// the module's contents changed, e.g. a counter it shows went up
+		void mark_hud_dirty();
+
+		// hook groups held while enabled, draw_on already brings in the render hooks
+		void require_hooks(const hook_dependency& dependency);
+
+		template <typename group_t>
+		void require_hooks() {
+			this->require_hooks(hook_dependency::of<group_t>());
+		}
+
+		// work spread over several frames, whatever is still running is cancelled when the feature is disabled
+		void spawn(task work);
 
 	private:
+		friend struct feature_manager;
+
+		void on_hud_render(setupandrender_event& ev);
+		std::function<void(ImDrawList&)> hud_drawer;
+		// bumped from setting callbacks on any thread, read by the render thread
+		std::atomic<std::uint64_t> hud_version{ 1 };
+
+		std::string_view name{ info::name.c_str(), info::name.size() };
+		std::string_view description;
+		feature_category category = feature_category::general;
 		bool enabled = false;
-		int hotkey;
+		event_bindings bindings;
+		int hotkey = 0;
+		std::vector<layer_hash> layers;
+		std::vector<hook_dependency> hooks;
 		glm::vec2 pos{};
 		glm::vec2 size{};
-		std::vector<std::unique_ptr<feature_setting>> settings;
+		memory::vector<feature_setting, memory::tag::settings> settings;
+		std::vector<std::pair<std::size_t, std::function<void(const feature_setting&)>>> setting_callbacks;
 	};
+
+	template <typename T>
+	const T& setting_handle<T>::get() const {
+		return std::get<T>(owner->get_settings()[index].value);
+	}
+
+	template <typename T>
+	void setting_handle<T>::set(const T& value) const {
+		owner->set_setting(index, value);
+	}
+
+	template <typename T>
+	bool setting_handle<T>::consume_dirty() const {
+		return owner->consume_setting_dirty(index);
+	}
+
+	template <typename T>
+	void setting_handle<T>::on_change(std::function<void(const T&)> callback) const {
+		owner->on_setting_changed(index, [callback = std::move(callback)](const feature_setting& setting) {
+			callback(std::get<T>(setting.value));
+		});
+	}
 }
\ No newline at end of file
@@ -4,12 +4,27 @@
 #include <string_view>
 #include <type_traits>
 #include <algorithm>
+#include <array>
+#include <span>
+#include <string>
 
 #include "feature.hpp"
+#include "../util/type_registry.hpp"
 
 namespace selaura {
+	// ascii lower case, names and queries are compared folded
+	inline std::string fold_name(std::string_view name) {
+		std::string folded(name);
+		for (char& c : folded) {
+			if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+		}
+		return folded;
+	}
+
 	struct feature_manager {
 		feature_manager() = default;
+		feature_manager(const feature_manager&) = delete;
+		feature_manager& operator=(const feature_manager&) = delete;
 
 		void init() {
 			//add_feature<
@@ -21,32 +36,60 @@ namespace selaura {
 		template <typename T, typename... Args>
 		T* add_feature(Args&&... args) {
 			static_assert(std::is_base_of_v<feature, T>, "T must derive from feature");
-			auto ptr = std::make_unique<T>(std::forward<Args>(args)...);
-			T* raw_ptr = ptr.get();
-			features.emplace_back(std::move(ptr));
+			const std::size_t before = features.size();
+			T* raw_ptr = features.emplace<T>(std::forward<Args>(args)...);
+			if (features.size() == before) return raw_ptr;
+
+			raw_ptr->name = std::string_view(T::info::name.c_str(), T::info::name.size());
+			constexpr std::string_view description(T::info::description.c_str(), T::info::description.size());
+			if constexpr (description != "Description Not Found") raw_ptr->description = description;
+			raw_ptr->category = T::info::category;
+			index(*raw_ptr);
 			return raw_ptr;
 		}
 
+		// registration order within the category
+		std::span<feature* const> in_category(feature_category category) const {
+			return categories[static_cast<std::size_t>(category)];
+		}
+
+		struct name_entry {
+			// lower case, what searches compare against
+			std::string folded;
+			feature* target;
+		};
+
+		// every feature sorted by name
+		std::span<const name_entry> get_name_index() const {
+			return names;
+		}
+
 		void for_each(auto&& callback) {
-			for (auto& scr : features)
+			for (auto* scr : features.all())
 				callback(*scr);
 		}
 
 		void for_each(auto&& callback) const {
-			for (const auto& scr : features)
+			for (const auto* scr : features.all())
 				callback(*scr);
 		}
 
 		template <typename T>
 		T* get() {
-			for (auto& scr : features) {
-				if (auto* casted = dynamic_cast<T*>(scr.get()))
-					return casted;
-			}
-			return nullptr;
+			return features.get<T>();
 		}
 
 	private:
-		std::vector<std::unique_ptr<feature>> features;
+		void index(feature& target) {
+			categories[static_cast<std::size_t>(target.get_category())].push_back(&target);
+
+			name_entry entry{ fold_name(target.get_name()), &target };
+			auto at = std::ranges::upper_bound(names, entry.folded, {}, &name_entry::folded);
+			names.insert(at, std::move(entry));
+		}
+
+		type_registry<feature> features;
+		std::array<std::vector<feature*>, static_cast<std::size_t>(feature_category::count)> categories;
+		std::vector<name_entry> names;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "feature_search.hpp"
+
+namespace selaura {
+	std::span<const feature_manager::name_entry* const> feature_search::update(const feature_manager& features, std::string_view query) {
+		const std::string folded = fold_name(query);
+		const auto index = features.get_name_index();
+		if (folded == this->last && index.size() == this->indexed) return this->matches;
+
+		// anything matching the longer query matched the shorter one, as long as no feature was added since
+		const bool narrowing = !this->last.empty() && folded.starts_with(this->last) && index.size() == this->indexed;
+		if (narrowing) {
+			std::erase_if(this->matches, [&](const feature_manager::name_entry* entry) {
+				return entry->folded.find(folded) == std::string::npos;
+			});
+		}
+		else {
+			this->matches.clear();
+			if (!folded.empty()) {
+				for (const auto& entry : index) {
+					if (entry.folded.find(folded) != std::string::npos) this->matches.push_back(&entry);
+				}
+			}
+		}
+
+		this->last = folded;
+		this->indexed = index.size();
+		return this->matches;
+	}
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "feature_manager.hpp"
+
+namespace selaura {
+	// case-insensitive substring search over the feature name index
+	// typing narrows the last result rather than scanning everything again, only shortening or editing the query rescans
+	struct feature_search {
+		// sorted by name, an empty query matches nothing
+		std::span<const feature_manager::name_entry* const> update(const feature_manager& features, std::string_view query);
+	private:
+		std::string last;
+		// into the manager's index, only valid while indexed matches its size
+		std::vector<const feature_manager::name_entry*> matches;
+		std::size_t indexed = 0;
+	};
+};
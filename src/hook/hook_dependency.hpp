@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <typeinfo>
+
+namespace selaura {
+    class hook_manager;
+    struct hook_group;
+
+    // names a hook group without building it, features and screens hold these for the hooks they need while enabled
+    struct hook_dependency {
+        std::size_t id;
+        std::shared_ptr<hook_group> (*create)(hook_manager& mgr);
+
+        template <typename group_t>
+        static hook_dependency of() {
+            return { typeid(group_t).hash_code(), [](hook_manager& mgr) -> std::shared_ptr<hook_group> { return std::make_shared<group_t>(mgr); } };
+        }
+
+        bool operator==(const hook_dependency& other) const {
+            return this->id == other.id;
+        }
+    };
+}
@@ -1,9 +1,44 @@
 #include "hook_manager.hpp"
 #include <spdlog/spdlog.h>
+#include <atomic>
+#include <thread>
+
+#ifndef SELAURA_WINDOWS
+#include <cstdio>
+#include <optional>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "impl/hook_registry.hpp"
+#include "../instance.hpp"
 
 namespace selaura {
+#ifndef SELAURA_WINDOWS
+    namespace {
+        // there is no call that reads a page's protection back, the kernel's mapping list is the only source
+        std::optional<int> page_protection(uintptr_t page) {
+            std::FILE* maps = std::fopen("/proc/self/maps", "r");
+            if (!maps) return std::nullopt;
+
+            std::optional<int> protection;
+            char line[512];
+            while (std::fgets(line, sizeof(line), maps)) {
+                unsigned long long begin = 0, end = 0;
+                char perms[5] = {};
+                if (std::sscanf(line, "%llx-%llx %4s", &begin, &end, perms) != 3) continue;
+                if (page < begin || page >= end) continue;
+
+                protection = (perms[0] == 'r' ? PROT_READ : 0) | (perms[1] == 'w' ? PROT_WRITE : 0) | (perms[2] == 'x' ? PROT_EXEC : 0);
+                break;
+            }
+
+            std::fclose(maps);
+            return protection;
+        }
+    }
+#endif
+
     hook_group::hook_group(hook_manager& mgr) {};
 
     void hook_manager::init() {
@@ -11,19 +46,180 @@ namespace selaura {
         MH_Initialize();
 #endif
 
+        const auto& data_folder = instance::get()->get_data_folder();
+        load_offset_overrides(data_folder / "offsets.txt", signatures::offset_symbols);
+        resolve_signatures(signatures::signature_symbols, data_folder / "signatures.cache");
+    }
+
+    void hook_manager::install() {
         register_hookgroup<hook_registry>();
-        
+    }
+
+    void hook_manager::begin_batch() {
+        batching_ = true;
+    }
+
+    void hook_manager::commit_batch() {
+        batching_ = false;
+
+#ifdef SELAURA_WINDOWS
+        // one thread suspension for the whole group instead of one per hook
+        MH_ApplyQueued();
+#else
+        // dobby patches in place without freezing threads, so the group is just installed back to back
+        for (auto& hook : pending_hooks_) {
+            DobbyHook(hook.target, hook.detour, hook.original);
+        }
+        pending_hooks_.clear();
+#endif
+    }
+
+    void hook_manager::acquire(const hook_dependency& dependency) {
+        if (destroyed_) return;
+
+        auto& group = demand_groups_[dependency.id];
+        group.create = dependency.create;
+        if (group.users++ > 0 || group.active || suspended_) return;
+
+        activate(group);
+    }
+
+    void hook_manager::activate(demand_group& group) {
+        if (group.group) {
+            set_group_active(group, true);
+            return;
+        }
+
+        group.first_hook = hook_entries_.size();
+        group.first_vtable = vtable_entries_.size();
+        begin_batch();
+        group.group = group.create(*this);
+        commit_batch();
+        group.last_hook = hook_entries_.size();
+        group.last_vtable = vtable_entries_.size();
+        group.active = true;
+    }
+
+    void hook_manager::release(const hook_dependency& dependency) {
+        auto it = demand_groups_.find(dependency.id);
+        if (it == demand_groups_.end() || it->second.users == 0) return;
+
+        // a detour of this very group may be the caller, so the hooks stay in place until the next update
+        if (--it->second.users == 0) release_pending_ = true;
+    }
+
+    bool hook_manager::is_active(const hook_dependency& dependency) const {
+        auto it = demand_groups_.find(dependency.id);
+        return it != demand_groups_.end() && it->second.active;
+    }
+
+    void hook_manager::update() {
+        if (!release_pending_ || destroyed_) return;
+        release_pending_ = false;
+
+        for (auto& [id, group] : demand_groups_) {
+            if (group.users == 0 && group.active) set_group_active(group, false);
+        }
+    }
+
+    void hook_manager::set_suspended(bool suspended) {
+        if (destroyed_ || suspended_ == suspended) return;
+        suspended_ = suspended;
+
+        for (auto& [id, group] : demand_groups_) {
+            if (suspended && group.active) set_group_active(group, false);
+            else if (!suspended && !group.active && group.users > 0) activate(group);
+        }
+    }
+
+    bool hook_manager::is_suspended() const {
+        return suspended_;
+    }
+
+    void hook_manager::set_group_active(demand_group& group, bool active) {
+        group.active = active;
+
+        for (std::size_t i = group.first_hook; i < group.last_hook; ++i) {
+            auto& hook = hook_entries_[i];
+            if (hook.enabled == active) continue;
+            hook.enabled = active;
+
+#ifdef SELAURA_WINDOWS
+            if (active) MH_QueueEnableHook(hook.target);
+            else MH_QueueDisableHook(hook.target);
+#else
+            if (active) DobbyHook(hook.target, hook.detour, hook.original);
+            else DobbyDestroy(hook.target);
+#endif
+        }
+
+#ifdef SELAURA_WINDOWS
+        MH_ApplyQueued();
+#endif
+
+        for (std::size_t i = group.first_vtable; i < group.last_vtable; ++i) {
+            auto& hook = vtable_entries_[i];
+            swap_vtable_entry(hook.slot, active ? hook.detour : hook.original, nullptr);
+        }
+    }
+
+    bool hook_manager::swap_vtable_entry(void** slot, void* replacement, void** previous) {
+        // vtables live in .rdata or relro, the page is only writable for the duration of the swap
+#ifdef SELAURA_WINDOWS
+        DWORD protection;
+        if (!VirtualProtect(slot, sizeof(void*), PAGE_READWRITE, &protection)) {
+            spdlog::error("Failed to unprotect vtable slot {}", static_cast<void*>(slot));
+            return false;
+        }
+#else
+        const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        auto* page = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(slot) & ~(page_size - 1));
+        // put back exactly as found, a slot sharing its page with code or writable data must not lose either
+        const auto protection = page_protection(reinterpret_cast<uintptr_t>(page));
+        if (!protection) {
+            spdlog::error("Failed to read the protection of vtable slot {}", static_cast<void*>(slot));
+            return false;
+        }
+        if (mprotect(page, page_size, *protection | PROT_READ | PROT_WRITE) != 0) {
+            spdlog::error("Failed to unprotect vtable slot {}", static_cast<void*>(slot));
+            return false;
+        }
+#endif
+
+        std::atomic_ref<void*> entry(*slot);
+        if (previous) *previous = entry.load(std::memory_order_acquire);
+        entry.store(replacement, std::memory_order_release);
+
+#ifdef SELAURA_WINDOWS
+        VirtualProtect(slot, sizeof(void*), protection, &protection);
+#else
+        mprotect(page, page_size, *protection);
+#endif
+        return true;
     }
 
     void hook_manager::destroy() {
+        if (destroyed_) return;
+        destroyed_ = true;
+
+        for (auto& hook : vtable_entries_) {
+            if (*hook.slot == hook.detour) swap_vtable_entry(hook.slot, hook.original, nullptr);
+        }
+
 #ifdef SELAURA_WINDOWS
         MH_RemoveHook(MH_ALL_HOOKS);
         MH_Uninitialize();
 #else
         for (auto& hook : hook_entries_) {
-            DobbyDestroy((void*)hook.target);
+            if (hook.enabled) DobbyDestroy((void*)hook.target);
         }
 #endif
+
+        // the unload fence, detours read the pinned instance without any refcount so it has to outlive the last of them
+#ifdef SELAURA_WINDOWS
+        FlushProcessWriteBuffers();
+#endif
+        std::this_thread::sleep_for(unload_grace);
     }
 
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
+#include <chrono>
 
 #include "../sdk/mem/storage.hpp"
 #include "../sdk/mem/signatures.hpp"
+#include "hook_dependency.hpp"
 
 #ifdef SELAURA_WINDOWS
 #include <MinHook.h>
@@ -24,7 +26,13 @@ namespace selaura {
     class hook_manager {
     public:
         hook_manager() = default;
+        hook_manager(const hook_manager&) = delete;
+        hook_manager& operator=(const hook_manager&) = delete;
+
+        // resolves every signature, nothing is hooked yet
         void init();
+        // installs the hooks that are always on, after every other component so no detour sees a half initialized client
+        void install();
 
         template <auto detour, typename symbol_t>
         void register_hook(base_symbol<symbol_t>& symbol) {
@@ -37,12 +45,12 @@ namespace selaura {
             if (!target) return;
 
             void* detour_ptr = resolve_func_ptr(detour);
-            fn_t original_fn = nullptr;
+            auto& original_fn = trampoline<detour>::original;
 
             hook_platform_install(target, detour_ptr, reinterpret_cast<void**>(&original_fn));
 
             hooks_.emplace(hash, std::make_shared<typed_hook<fn_t>>(original_fn));
-            hook_entries_.emplace_back(target, detour_ptr);
+            hook_entries_.emplace_back(target, detour_ptr, reinterpret_cast<void**>(&original_fn));
         }
 
         template <auto detour>
@@ -53,37 +61,91 @@ namespace selaura {
             if (hooks_.count(hash)) return;
 
             void* detour_ptr = resolve_func_ptr(detour);
-            fn_t original_fn = nullptr;
+            auto& original_fn = trampoline<detour>::original;
 
             hook_platform_install(target, detour_ptr, reinterpret_cast<void**>(&original_fn));
 
             hooks_.emplace(hash, std::make_shared<typed_hook<fn_t>>(original_fn));
-            hook_entries_.emplace_back(target, detour_ptr);
+            hook_entries_.emplace_back(target, detour_ptr, reinterpret_cast<void**>(&original_fn));
+        }
+
+        // swaps one slot of the class's own vtable, every instance is hooked by a single pointer write with no trampoline
+        template <auto detour, typename symbol_t>
+        void register_vtable_hook(const vtable_symbol<symbol_t>& symbol) {
+            if (symbol.index() < 0) {
+                spdlog::error("No vtable slot for {} on this platform, its hook is not installed", symbol.type_name);
+                return;
+            }
+
+            const auto* vtable = find_vtable(symbol.type_name);
+            if (!vtable) return;
+
+            register_vtable_hook<detour>(const_cast<uintptr_t*>(vtable), static_cast<std::size_t>(symbol.index()));
         }
 
         template <auto detour>
-        auto get_original() const {
+        void register_vtable_hook(uintptr_t* vtable, std::size_t index) {
             using fn_t = decltype(detour);
+
             const auto hash = get_hash<detour>();
+            if (hooks_.count(hash)) return;
+
+            void* detour_ptr = resolve_func_ptr(detour);
+            auto& original_fn = trampoline<detour>::original;
+            auto** slot = reinterpret_cast<void**>(vtable + index);
 
-            auto it = hooks_.find(hash);
-            assert(it != hooks_.end() && "original function not found");
+            if (!swap_vtable_entry(slot, detour_ptr, reinterpret_cast<void**>(&original_fn))) return;
 
-            return std::static_pointer_cast<typed_hook<fn_t>>(it->second)->original;
+            hooks_.emplace(hash, std::make_shared<typed_hook<fn_t>>(original_fn));
+            vtable_entries_.push_back({ slot, *reinterpret_cast<void**>(&original_fn), detour_ptr });
         }
 
+        template <auto detour>
+        static auto get_original() {
+            assert(trampoline<detour>::original != nullptr && "original function not found");
+            return trampoline<detour>::original;
+        }
+
+        // every hook a group registers is created first and enabled together once the group is built
         template <typename group_t, typename... Args>
         void register_hookgroup(Args&&... args) {
+            begin_batch();
             hook_groups_.emplace_back(std::make_shared<group_t>(*this, std::forward<Args>(args)...));
+            commit_batch();
         }
 
+        // builds and installs the group for its first user, the last release disables its hooks again on the next update
+        void acquire(const hook_dependency& dependency);
+        void release(const hook_dependency& dependency);
+        bool is_active(const hook_dependency& dependency) const;
+
+        // disables groups nothing has needed since the last call, run at the top of MinecraftGame::update outside every other detour
+        void update();
+
+        // disables every on-demand group without dropping its users, resuming brings back the ones still needed
+        // same rules as update, call it from MinecraftGame::update and never from a detour of those groups
+        void set_suspended(bool suspended);
+        bool is_suspended() const;
+
+        // removes every hook, then waits long enough for detours already inside our code to return
         void destroy();
 
+        // a few frames, detours never block so anything still running is out well before this
+        static constexpr std::chrono::milliseconds unload_grace{ 100 };
+
     private:
+        // one slot per detour, written by the hooking backend and read directly by get_original
+        template <auto detour>
+        struct trampoline {
+            inline static decltype(detour) original = nullptr;
+        };
+
         struct hook_entry {
             void* target;
             void* detour;
-            hook_entry(void* t, void* d) : target(t), detour(d) {}
+            void** original;
+            bool enabled = true;
+            hook_entry(void* t, void* d, void** o) : target(t), detour(d), original(o) {}
         };
 
         struct hook_base {
@@ -96,9 +158,52 @@ namespace selaura {
             explicit typed_hook(fn_t fn) : original(fn) {}
         };
 
+#ifndef SELAURA_WINDOWS
+        struct pending_hook {
+            void* target;
+            void* detour;
+            void** original;
+        };
+
+        std::vector<pending_hook> pending_hooks_;
+#endif
+
+        struct vtable_entry {
+            void** slot;
+            void* original;
+            void* detour;
+        };
+
+        // an on-demand group owns the entries registered while it was built
+        struct demand_group {
+            std::shared_ptr<hook_group> group;
+            // kept so a group first acquired while suspended can still be built on resume
+            std::shared_ptr<hook_group> (*create)(hook_manager& mgr) = nullptr;
+            std::size_t first_hook = 0;
+            std::size_t last_hook = 0;
+            std::size_t first_vtable = 0;
+            std::size_t last_vtable = 0;
+            std::size_t users = 0;
+            bool active = false;
+        };
+
         std::vector<hook_entry> hook_entries_;
+        std::vector<vtable_entry> vtable_entries_;
         std::unordered_map<size_t, std::shared_ptr<hook_base>> hooks_;
         std::vector<std::shared_ptr<hook_group>> hook_groups_;
+        std::unordered_map<size_t, demand_group> demand_groups_;
+        bool release_pending_ = false;
+        bool suspended_ = false;
+        bool batching_ = false;
+        bool destroyed_ = false;
+
+        void begin_batch();
+        void commit_batch();
+        void set_group_active(demand_group& group, bool active);
+        void activate(demand_group& group);
+
+        // stores the old entry in previous before publishing replacement, so a detour called right away already has its original
+        static bool swap_vtable_entry(void** slot, void* replacement, void** previous);
 
         template <typename fn_t>
         void* resolve_func_ptr(fn_t fn) {
@@ -126,9 +231,20 @@ namespace selaura {
 
         void hook_platform_install(void* target, void* detour, void** original) {
 #ifdef SELAURA_WINDOWS
-            MH_CreateHook(target, detour, original);
-            MH_EnableHook(target);
+            if (MH_CreateHook(target, detour, original) != MH_OK) return;
+
+            if (batching_) {
+                MH_QueueEnableHook(target);
+            }
+            else {
+                MH_EnableHook(target);
+            }
 #else
+            if (batching_) {
+                pending_hooks_.push_back({ target, detour, original });
+                return;
+            }
+
             DobbyHook(target, detour, original);
 #endif
         }
@@ -4,7 +4,6 @@ namespace selaura {
 	hook_registry::hook_registry(hook_manager& mgr) : hook_group(mgr) {
 		mgr.register_hook<&SplashTextRenderer::render>(signatures::splashtextrenderer_render);
 		mgr.register_hook<&MinecraftGame::update>(signatures::minecraftgame_update);
-		mgr.register_hook<&ScreenView::SetupAndRender>(signatures::screenview_setupandrender);
 		mgr.register_hook<&mce::TextureGroup::unloadAllTextures>(signatures::mce_texturegroup_unloadalltextures);
 	};
 }
\ No newline at end of file
@@ -1,11 +1,11 @@
 #pragma once
 #include "../../sdk/mc/game/MinecraftGame.hpp"
 #include "../../sdk/mc/gui/controls/renderers/SplashTextRenderer.hpp"
-#include "../../sdk/mc/gui/ScreenView.hpp"
 #include "../hook_manager.hpp"
 #include "../../sdk/mem/symbols.hpp"
 
 namespace selaura {
+	// always installed, hooks a feature only needs while enabled go in their own group
 	struct hook_registry : public hook_group {
 		explicit hook_registry(hook_manager& mgr);
 	};
@@ -0,0 +1,9 @@
+#include "network_hooks.hpp"
+
+namespace selaura {
+	network_hooks::network_hooks(hook_manager& mgr) : hook_group(mgr) {
+		// every connection shares the class vtable, so one swap each covers them all
+		mgr.register_vtable_hook<&BatchedNetworkPeer::sendPacket>(signatures::batchednetworkpeer_sendpacket);
+		mgr.register_vtable_hook<&BatchedNetworkPeer::receivePacket>(signatures::batchednetworkpeer_receivepacket);
+	};
+}
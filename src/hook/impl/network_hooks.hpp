@@ -0,0 +1,11 @@
+#pragma once
+#include "../../sdk/mc/network/NetworkPeer.hpp"
+#include "../hook_manager.hpp"
+#include "../../sdk/mem/symbols.hpp"
+
+namespace selaura {
+	// only installed while something reads packets, anything subscribing to a packet_event depends on it
+	struct network_hooks : public hook_group {
+		explicit network_hooks(hook_manager& mgr);
+	};
+}
@@ -0,0 +1,13 @@
+#include "render_hooks.hpp"
+
+namespace selaura {
+	render_hooks::render_hooks(hook_manager& mgr) : hook_group(mgr) {
+		// the renderer calls through these from the detour, without them nothing is drawn rather than calling before the vtable
+		if (signatures::minecraftuirendercontext_gettexture.index() < 0 || signatures::mce_rendermaterialgroup_getmaterial.index() < 0) {
+			spdlog::error("No vtable slots for getTexture/getMaterial on this platform, the renderer stays disabled");
+			return;
+		}
+
+		mgr.register_hook<&ScreenView::SetupAndRender>(signatures::screenview_setupandrender);
+	};
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include "../../sdk/mc/gui/ScreenView.hpp"
+#include "../hook_manager.hpp"
+#include "../../sdk/mem/symbols.hpp"
+
+namespace selaura {
+	// only installed while something draws, everything on draw_on depends on it
+	struct render_hooks : public hook_group {
+		explicit render_hooks(hook_manager& mgr);
+	};
+}
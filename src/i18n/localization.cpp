@@ -0,0 +1,264 @@
+#include "localization.hpp"
+
+#include "../instance.hpp"
+#include "../sdk/mc/HashedString.hpp"
+#include "../util/hash.hpp"
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+namespace selaura {
+	namespace {
+		constexpr char table_magic[8] = { 'S', 'L', 'L', 'A', 'N', 'G', '0', '2' };
+		constexpr std::string_view builtin_language = "en_US";
+
+		struct table_header {
+			char magic[8];
+			std::uint32_t count;
+			std::uint32_t blob_size;
+			std::uint64_t source_hash;
+		};
+
+		// sorted by hash, offsets are into the blob that follows the entries and every string in it is null terminated
+		struct table_entry {
+			std::uint64_t hash;
+			std::uint32_t offset;
+			std::uint32_t length;
+		};
+
+		constexpr auto key_hashes = [] {
+			std::array<std::uint64_t, std::size(translation_keys)> hashes{};
+			for (std::size_t id = 0; id < hashes.size(); id++) hashes[id] = HashedString::fnv1a_64(translation_keys[id].key);
+			return hashes;
+		}();
+
+		std::string_view trim(std::string_view text) {
+			while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+			while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+			return text;
+		}
+	}
+
+	localization::localization() {
+		auto builtin = std::make_unique<table>();
+		builtin->name = builtin_language;
+		for (const auto& entry : translation_keys) {
+			this->fallbacks.emplace_back(entry.fallback);
+		}
+		for (const auto& fallback : this->fallbacks) {
+			builtin->strings.push_back(fallback.c_str());
+		}
+
+		this->current.store(builtin.get(), std::memory_order_release);
+		this->tables.push_back(std::move(builtin));
+	}
+
+	void localization::init() {
+		const auto& data_folder = selaura::instance::get()->get_data_folder();
+		const auto folder = data_folder / "lang";
+		const auto cache = data_folder / "cache" / "lang";
+
+		// loose files are read whole, they are a few kilobytes and read once
+		std::map<std::string, std::string> loose;
+		std::error_code ec;
+		if (std::filesystem::is_directory(folder, ec)) {
+			for (const auto& file : std::filesystem::directory_iterator(folder, ec)) {
+				if (file.path().extension() != ".lang") continue;
+
+				std::ifstream in(file.path(), std::ios::binary);
+				if (!in) continue;
+				loose[file.path().stem().string()].assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+			}
+		}
+
+		auto& bundle = selaura::get_component<selaura::asset_bundle>();
+		std::map<std::string, std::string_view> bundled;
+		bundle.for_each("lang/", [&](std::string_view name, std::span<const std::byte> data) {
+			const std::filesystem::path file(name);
+			if (file.extension() != ".lang" || file.parent_path() != "lang") return;
+			bundled[file.stem().string()] = { reinterpret_cast<const char*>(data.data()), data.size() };
+		});
+
+		if (loose.empty() && bundled.empty()) return;
+		std::filesystem::create_directories(cache, ec);
+
+		for (const auto& [name, source] : bundled) {
+			if (!loose.contains(name)) this->load(name, source, cache);
+		}
+		for (const auto& [name, source] : loose) {
+			this->load(name, source, cache);
+		}
+
+		// a translated table for the language in use replaces the one it had, the saved choice is applied by the config
+		this->apply_language(this->get_language());
+	}
+
+	void localization::load(std::string name, std::string_view source, const std::filesystem::path& cache) {
+		const auto compiled = cache / (name + ".bin");
+		const std::uint64_t source_hash = hash_bytes(0, source.data(), source.size());
+
+		// recompiled whenever the source changed, a table that fails to map falls back to english key by key
+		auto loaded = std::make_unique<table>();
+		loaded->name = std::move(name);
+		if (!this->map(*loaded, compiled) || loaded->source_hash != source_hash) {
+			// unmapped first, a mapped file can't be replaced everywhere
+			loaded->file.close();
+			if (!compile(source, source_hash, compiled) || !this->map(*loaded, compiled)) {
+				spdlog::error("Failed to load language {}", loaded->name);
+				return;
+			}
+		}
+
+		std::scoped_lock lock(this->mutex);
+		this->tables.push_back(std::move(loaded));
+	}
+
+	bool localization::compile(std::string_view source, std::uint64_t source_hash, const std::filesystem::path& out) {
+		// later lines for the same key win, like the game's own .lang files
+		std::map<std::uint64_t, std::string> entries;
+		while (!source.empty()) {
+			const auto newline = source.find('\n');
+			const auto line = source.substr(0, newline);
+			source.remove_prefix(newline == std::string_view::npos ? source.size() : newline + 1);
+
+			std::string_view text = trim(line);
+			if (text.empty() || text.front() == '#') continue;
+
+			const auto equals = text.find('=');
+			if (equals == std::string_view::npos) continue;
+
+			const auto key = trim(text.substr(0, equals));
+			auto value = text.substr(equals + 1);
+			if (const auto comment = value.find("\t#"); comment != std::string_view::npos) value = value.substr(0, comment);
+
+			std::string unescaped;
+			for (std::size_t i = 0; i < value.size(); i++) {
+				if (value[i] == '\\' && i + 1 < value.size() && value[i + 1] == 'n') {
+					unescaped += '\n';
+					i++;
+				}
+				else {
+					unescaped += value[i];
+				}
+			}
+			entries[HashedString::fnv1a_64(key)] = std::move(unescaped);
+		}
+
+		std::vector<table_entry> index;
+		std::string blob;
+		for (const auto& [hash, value] : entries) {
+			index.push_back({ hash, static_cast<std::uint32_t>(blob.size()), static_cast<std::uint32_t>(value.size()) });
+			blob += value;
+			blob += '\0';
+		}
+
+		table_header header{};
+		std::memcpy(header.magic, table_magic, sizeof(table_magic));
+		header.count = static_cast<std::uint32_t>(index.size());
+		header.blob_size = static_cast<std::uint32_t>(blob.size());
+		header.source_hash = source_hash;
+
+		// written next to the table and renamed over it, a table that is mapped elsewhere is never half written
+		auto temp = out;
+		temp += ".tmp";
+		{
+			std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+			if (!file) {
+				spdlog::error("Failed to write language table {}", out.string());
+				return false;
+			}
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(table_entry)));
+			file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temp, out, ec);
+		if (ec) {
+			spdlog::error("Failed to write language table {}: {}", out.string(), ec.message());
+			return false;
+		}
+
+		spdlog::info("Compiled {} strings into {}", index.size(), out.filename().string());
+		return true;
+	}
+
+	bool localization::map(table& target, const std::filesystem::path& path) const {
+		if (!target.file.open(path)) return false;
+
+		const auto bytes = target.file.bytes();
+		table_header header{};
+		if (bytes.size() < sizeof(header)) return false;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		if (std::memcmp(header.magic, table_magic, sizeof(table_magic)) != 0) return false;
+
+		const std::size_t index_size = static_cast<std::size_t>(header.count) * sizeof(table_entry);
+		if (bytes.size() < sizeof(header) + index_size + header.blob_size) return false;
+
+		// the header is 24 bytes, so the entries are as aligned as the mapping itself
+		const auto* entries = reinterpret_cast<const table_entry*>(bytes.data() + sizeof(header));
+		const auto* blob = reinterpret_cast<const char*>(bytes.data() + sizeof(header) + index_size);
+
+		target.source_hash = header.source_hash;
+		target.strings.resize(std::size(translation_keys));
+		for (std::size_t id = 0; id < key_hashes.size(); id++) {
+			target.strings[id] = this->fallbacks[id].c_str();
+
+			const auto* found = std::lower_bound(entries, entries + header.count, key_hashes[id], [](const table_entry& entry, std::uint64_t hash) { return entry.hash < hash; });
+			if (found == entries + header.count || found->hash != key_hashes[id]) continue;
+			if (static_cast<std::uint64_t>(found->offset) + found->length >= header.blob_size || blob[found->offset + found->length] != '\0') continue;
+
+			target.strings[id] = blob + found->offset;
+		}
+		return true;
+	}
+
+	bool localization::set_language(std::string_view name) {
+		if (!this->apply_language(name)) return false;
+		selaura::get_component<selaura::config_manager>().mark_dirty();
+		return true;
+	}
+
+	bool localization::apply_language(std::string_view name) {
+		std::scoped_lock lock(this->mutex);
+
+		// the last one loaded under a name wins, so a translated en_US beats the built in one
+		for (auto it = this->tables.rbegin(); it != this->tables.rend(); ++it) {
+			if ((*it)->name != name) continue;
+
+			const table* selected = it->get();
+			this->current.store(selected, std::memory_order_release);
+
+			// the atlas only holds what has been asked for, the whole table is requested up front rather than glyph by glyph as it shows up
+			// any thread may switch, the renderer is only touched from the game thread
+			selaura::get_component<selaura::job_system>().post([selected] {
+				auto& renderer = selaura::get_component<selaura::renderer>();
+				for (const char* text : selected->strings) renderer.request_glyphs(text);
+				renderer.get_pacer().invalidate();
+			});
+			return true;
+		}
+		return false;
+	}
+
+	std::string_view localization::get_language() const {
+		return this->current.load(std::memory_order_acquire)->name;
+	}
+
+	std::vector<std::string> localization::get_languages() const {
+		std::scoped_lock lock(this->mutex);
+
+		std::vector<std::string> names;
+		for (const auto& entry : this->tables) {
+			if (std::ranges::find(names, entry->name) == names.end()) names.push_back(entry->name);
+		}
+		return names;
+	}
+
+	const char* translate(std::uint32_t id) {
+		return selaura::get_component<selaura::localization>().get(id);
+	}
+};
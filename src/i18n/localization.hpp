@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libhat/fixed_string.hpp>
+#include "translation_keys.hpp"
+#include "../util/mapped_file.hpp"
+
+namespace selaura {
+	// a key's index in translation_keys, an unknown key does not compile
+	consteval std::uint32_t translation_id(std::string_view key) {
+		for (std::uint32_t id = 0; id < std::size(translation_keys); id++) {
+			if (translation_keys[id].key == key) return id;
+		}
+		throw "unknown translation key, add it to translation_keys";
+	}
+
+	// languages are lang/<name>.lang in the asset bundle or data_folder/lang/<name>.lang, minecraft style key=value lines
+	// a loose file replaces the bundled language of the same name
+	// compiled tables are keyed by the fnv1a hash of the key, so they stay valid when keys are added in between
+	// each is compiled once into cache/lang/<name>.bin and mapped, a lookup is an array index and a language switch a pointer swap
+	struct localization {
+		localization();
+		localization(const localization&) = delete;
+		localization& operator=(const localization&) = delete;
+
+		// compiles what changed and maps every language, the english fallbacks are used until then
+		void init();
+
+		// false if there is no such language, the current one stays
+		// any thread, the choice is saved with the config and its glyphs are queued for the atlas
+		bool set_language(std::string_view name);
+		// the same switch without saving it, for init and the config restoring the saved choice
+		bool apply_language(std::string_view name);
+		std::string_view get_language() const;
+		// "en_US" first, then every language found in the lang folder
+		std::vector<std::string> get_languages() const;
+
+		// any thread, null terminated for imgui
+		const char* get(std::uint32_t id) const {
+			return this->current.load(std::memory_order_acquire)->strings[id];
+		}
+	private:
+		struct table {
+			std::string name;
+			mapped_file file;
+			// of the source it was compiled from, a table is recompiled whenever it differs
+			std::uint64_t source_hash = 0;
+			// one per translation_keys entry, into the mapping or the fallbacks
+			std::vector<const char*> strings;
+		};
+
+		static bool compile(std::string_view source, std::uint64_t source_hash, const std::filesystem::path& out);
+		bool map(table& target, const std::filesystem::path& path) const;
+		void load(std::string name, std::string_view source, const std::filesystem::path& cache);
+
+		// null terminated copies of the fallbacks, string_views into a constexpr array aren't
+		std::vector<std::string> fallbacks;
+
+		// tables are never freed while the client runs, a reader holding the old pointer stays valid
+		mutable std::mutex mutex;
+		std::vector<std::unique_ptr<table>> tables;
+		std::atomic<const table*> current{ nullptr };
+	};
+
+	// the current language's string for an id, for when the key is only known at run time as an id
+	const char* translate(std::uint32_t id);
+
+	// tr<"click_gui.search">(), the key is resolved to its id at compile time
+	template <hat::fixed_string key>
+	const char* tr() {
+		constexpr std::uint32_t id = translation_id(std::string_view(key.c_str(), key.size()));
+		return translate(id);
+	}
+};
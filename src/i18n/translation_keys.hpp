@@ -0,0 +1,21 @@
+#pragma once
+#include <string_view>
+
+namespace selaura {
+	struct translation_key {
+		std::string_view key;
+		// english, used when the current language has no entry
+		std::string_view fallback;
+	};
+
+	// every string the client translates, a key's index here is its id
+	// append only within a release, ids are compiled into the code that uses them
+	inline constexpr translation_key translation_keys[] = {
+		{ "click_gui.search", "Search" },
+		{ "click_gui.language", "Language" },
+		{ "category.general", "General" },
+		{ "category.visual", "Visual" },
+		{ "category.combat", "Combat" },
+		{ "category.utility", "Utility" },
+	};
+};
@@ -0,0 +1,60 @@
+#include "hotkey_index.hpp"
+#include "../instance.hpp"
+
+namespace selaura {
+    namespace {
+        int modifier_of(selaura::key key) {
+            switch (key) {
+                case selaura::key::Control: return selaura::key::ImGuiMod_Ctrl;
+                case selaura::key::Shift: return selaura::key::ImGuiMod_Shift;
+                case selaura::key::Alt: return selaura::key::ImGuiMod_Alt;
+                default: return 0;
+            }
+        }
+    }
+
+    void hotkey_index::bind(hotkey_chord old_chord, hotkey_chord new_chord, hotkey_target target) {
+        if (old_chord != selaura::key::None) {
+            if (auto it = this->bindings.find(old_chord); it != this->bindings.end()) {
+                std::erase(it->second, target);
+                if (it->second.empty()) this->bindings.erase(it);
+            }
+        }
+
+        if (new_chord != selaura::key::None) {
+            this->bindings[new_chord].push_back(target);
+        }
+    }
+
+    void hotkey_index::handle(key_event& ev) {
+        const bool down = ev.action == selaura::key_action::key_down || ev.action == selaura::key_action::system_key_down;
+        const bool up = ev.action == selaura::key_action::key_up || ev.action == selaura::key_action::system_key_up;
+
+        // a modifier on its own is still a valid hotkey, it just doesn't count as held for itself
+        const int modifier = modifier_of(ev.key);
+        const int held = this->modifiers & ~modifier;
+        if (modifier) {
+            if (down) this->modifiers |= modifier;
+            if (up) this->modifiers &= ~modifier;
+        }
+
+        if (!up) return;
+
+        auto it = this->bindings.find(ev.key | held);
+        if (it == this->bindings.end()) return;
+
+        const bool captured = selaura::get_component<selaura::screen_manager>().captures_input();
+
+        // copied, toggling can rebind and invalidate the bucket
+        const auto targets = it->second;
+        for (const auto& target : targets) {
+            if (target.scr && !target.scr->is_enabled()) target.scr->set_enabled(true);
+            // features stay put while a screen has the keyboard
+            if (target.feat && !captured) target.feat->toggle();
+        }
+    }
+
+    int hotkey_index::get_modifiers() const {
+        return this->modifiers;
+    }
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "key.hpp"
+
+namespace selaura {
+    struct feature;
+    struct screen;
+    struct key_event;
+
+    // a key plus the modifiers held with it, packed the same way ImGuiKeyChord is
+    using hotkey_chord = int;
+
+    struct hotkey_target {
+        feature* feat = nullptr;
+        screen* scr = nullptr;
+
+        bool operator==(const hotkey_target&) const = default;
+    };
+
+    // chord to everything bound to it, kept current by set_hotkey so a key press is one lookup
+    struct hotkey_index {
+        void bind(hotkey_chord old_chord, hotkey_chord new_chord, hotkey_target target);
+
+        // render thread, tracks modifiers and fires whatever the released chord is bound to
+        void handle(key_event& ev);
+
+        int get_modifiers() const;
+    private:
+        std::unordered_map<hotkey_chord, std::vector<hotkey_target>> bindings;
+        int modifiers = 0;
+    };
+};
@@ -1,14 +1,82 @@
 #include "input_manager.hpp"
 
 #include "../instance.hpp"
+#include "key_table.hpp"
+
+#include <bit>
+
+#ifndef SELAURA_WINDOWS
+#include <dlfcn.h>
+#endif
 
 namespace selaura {
 
+    bool input_manager::drain(bool to_imgui) {
+        auto& evm = selaura::get_component<selaura::event_manager>();
+
+        ImGuiIO* io = to_imgui ? &ImGui::GetIO() : nullptr;
+        bool received = false;
+
+        while (auto event = this->events.pop()) {
+            received = true;
+            switch (event->type) {
+                case input_event::kind::key: {
+                    // the os already got its answer, cancelling here only stops later listeners
+                    bool cancelled = false;
+                    selaura::key_event ev{ &cancelled, event->key, event->action };
+                    evm.dispatch<selaura::key_event>(ev);
+                    break;
+                }
+                case input_event::kind::mouse_button:
+                    if (!io) break;
+                    // clicks land where the pointer was when they happened, not where it ended up
+                    io->AddMousePosEvent(event->x, event->y);
+                    io->AddMouseButtonEvent(event->button, event->down);
+                    break;
+                case input_event::kind::mouse_wheel:
+                    if (io) io->AddMouseWheelEvent(event->x, event->y);
+                    break;
+            }
+        }
+
+        // however many moves came in, imgui gets one per frame
+        const std::uint64_t position = this->pointer_position.load(std::memory_order_relaxed);
+        if (io && position != this->applied_position) {
+            this->applied_position = position;
+            this->mouse_x = std::bit_cast<float>(static_cast<std::uint32_t>(position));
+            this->mouse_y = std::bit_cast<float>(static_cast<std::uint32_t>(position >> 32));
+            io->AddMousePosEvent(this->mouse_x, this->mouse_y);
+            received = true;
+        }
+
+        return received;
+    }
+
+    void input_manager::set_pointer_position(float x, float y) {
+        const float scale = this->pointer_scale.load(std::memory_order_relaxed);
+        const std::uint64_t packed = std::bit_cast<std::uint32_t>(x * scale) | (static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(y * scale)) << 32);
+        this->pointer_position.store(packed, std::memory_order_relaxed);
+    }
+
+    hotkey_index& input_manager::get_hotkeys() {
+        return this->hotkeys;
+    }
+
+    float input_manager::get_mouse_x() const {
+        return this->mouse_x;
+    }
+
+    float input_manager::get_mouse_y() const {
+        return this->mouse_y;
+    }
+
     void input_manager::init() {
 #ifdef SELAURA_WINDOWS
         winrt::Windows::ApplicationModel::Core::CoreApplication::MainView().CoreWindow().Dispatcher().RunAsync(winrt::Windows::UI::Core::CoreDispatcherPriority::Normal, [&]() {
             init_winrt_hooks();
         });
+#else
+        init_native_hooks();
 #endif
     }
 
@@ -18,117 +86,20 @@ namespace selaura {
 
         auto token = coreWindow.Dispatcher().AcceleratorKeyActivated({&input_manager::key_hk});
         auto mouse_token = coreWindow.PointerMoved({ &input_manager::pointer_moved_hk });
+        auto pressed_token = coreWindow.PointerPressed({ &input_manager::pointer_button_hk });
+        auto released_token = coreWindow.PointerReleased({ &input_manager::pointer_button_hk });
+        auto wheel_token = coreWindow.PointerWheelChanged({ &input_manager::pointer_wheel_hk });
+
+        auto& input = selaura::get_component<selaura::input_manager>();
+        input.pointer_scale.store(static_cast<float>(winrt::Windows::Graphics::Display::DisplayInformation::GetForCurrentView().RawPixelsPerViewPixel()), std::memory_order_relaxed);
     }
 
 
     selaura::key input_manager::translate_key(winrt::Windows::System::VirtualKey vkey) {
-        uint32_t key = static_cast<uint32_t>(vkey);
-
-        switch (key) {
-            case 0x09: return selaura::key::Tab;
-            case 0x10: return selaura::key::Shift;
-            case 0x11: return selaura::key::Control;
-            case 0x12: return selaura::key::Alt;
-            case 0x25: return selaura::key::LeftArrow;
-            case 0x27: return selaura::key::RightArrow;
-            case 0x26: return selaura::key::UpArrow;
-            case 0x28: return selaura::key::DownArrow;
-            case 0x21: return selaura::key::PageUp;
-            case 0x22: return selaura::key::PageDown;
-            case 0x24: return selaura::key::Home;
-            case 0x23: return selaura::key::End;
-            case 0x2D: return selaura::key::Insert;
-            case 0x2E: return selaura::key::Delete;
-            case 0x08: return selaura::key::Backspace;
-            case 0x20: return selaura::key::Space;
-            case 0x0D: return selaura::key::Enter;
-            case 0x1B: return selaura::key::Escape;
-            case 0x5D: return selaura::key::Menu;
-            case 0x30: return selaura::key::NUM_0;
-            case 0x31: return selaura::key::NUM_1;
-            case 0x32: return selaura::key::NUM_2;
-            case 0x33: return selaura::key::NUM_3;
-            case 0x34: return selaura::key::NUM_4;
-            case 0x35: return selaura::key::NUM_5;
-            case 0x36: return selaura::key::NUM_6;
-            case 0x37: return selaura::key::NUM7;
-            case 0x38: return selaura::key::NUM_8;
-            case 0x39: return selaura::key::NUM_9;
-
-            case 0x41: return selaura::key::A;
-            case 0x42: return selaura::key::B;
-            case 0x43: return selaura::key::C;
-            case 0x44: return selaura::key::D;
-            case 0x45: return selaura::key::E;
-            case 0x46: return selaura::key::F;
-            case 0x47: return selaura::key::G;
-            case 0x48: return selaura::key::H;
-            case 0x49: return selaura::key::I;
-            case 0x4A: return selaura::key::J;
-            case 0x4B: return selaura::key::K;
-            case 0x4C: return selaura::key::L;
-            case 0x4D: return selaura::key::M;
-            case 0x4E: return selaura::key::N;
-            case 0x4F: return selaura::key::O;
-            case 0x50: return selaura::key::P;
-            case 0x51: return selaura::key::Q;
-            case 0x52: return selaura::key::R;
-            case 0x53: return selaura::key::S;
-            case 0x54: return selaura::key::T;
-            case 0x55: return selaura::key::U;
-            case 0x56: return selaura::key::V;
-            case 0x57: return selaura::key::W;
-            case 0x58: return selaura::key::X;
-            case 0x59: return selaura::key::Y;
-            case 0x5A: return selaura::key::Z;
-
-            case 0x70: return selaura::key::F1;
-            case 0x71: return selaura::key::F2;
-            case 0x72: return selaura::key::F3;
-            case 0x73: return selaura::key::F4;
-            case 0x74: return selaura::key::F5;
-            case 0x75: return selaura::key::F6;
-            case 0x76: return selaura::key::F7;
-            case 0x77: return selaura::key::F8;
-            case 0x78: return selaura::key::F9;
-            case 0x79: return selaura::key::F10;
-            case 0x7A: return selaura::key::F11;
-            case 0x7B: return selaura::key::F12;
-
-            case 0x14: return selaura::key::CapsLock;
-            case 0x91: return selaura::key::ScrollLock;
-            case 0x90: return selaura::key::NumLock;
-            case 0x2C: return selaura::key::PrintScreen;
-            case 0x13: return selaura::key::Pause;
-
-            case 0x6E: return selaura::key::KeypadDecimal;
-            case 0x6F: return selaura::key::KeypadDivide;
-            case 0x6A: return selaura::key::KeypadMultiply;
-            case 0x6D: return selaura::key::KeypadSubtract;
-            case 0x6B: return selaura::key::KeypadAdd;
-            case 0xBB: return selaura::key::Equal;
-            case 0xBA: return selaura::key::Semicolon;
-            case 0xBD: return selaura::key::Minus;
-            case 0xBC: return selaura::key::Comma;
-            case 0xBE: return selaura::key::Period;
-            case 0xBF: return selaura::key::Slash;
-            case 0xC0: return selaura::key::GraveAccent;
-            case 0xDB: return selaura::key::LeftBracket;
-            case 0xDC: return selaura::key::Backslash;
-            case 0xDD: return selaura::key::RightBracket;
-            case 0xDE: return selaura::key::Apostrophe;
-            case 0xE2: return selaura::key::Oem102;
-
-            default: return selaura::key::None;
-        }
+        return key_from_virtual_key(static_cast<uint32_t>(vkey));
     }
 
     void input_manager::key_hk(winrt::Windows::UI::Core::CoreDispatcher const& sender, winrt::Windows::UI::Core::AcceleratorKeyEventArgs const& args) {
-        auto inst = selaura::instance::get();
-        auto evm = inst->get<selaura::event_manager>();
-
-        bool cancelled = false;
-
         selaura::key_action action = selaura::key_action::unknown;
         using Type = winrt::Windows::UI::Core::CoreAcceleratorKeyEventType;
 
@@ -140,17 +111,197 @@ namespace selaura {
             default: break;
         }
 
-        selaura::key_event ev{&cancelled, translate_key(args.VirtualKey()), action};
-        evm.dispatch<selaura::key_event>(ev);
+        // listeners run later on the render thread, whether the game sees the key is decided here
+        auto& input = selaura::get_component<selaura::input_manager>();
+        input.events.push({ input_event::kind::key, translate_key(args.VirtualKey()), action, 0, false, 0.0f, 0.0f });
 
-        if (cancelled) {
+        if (selaura::get_component<selaura::screen_manager>().captures_input()) {
             args.Handled(true);
         }
     }
 
     void input_manager::pointer_moved_hk(winrt::Windows::UI::Core::CoreWindow const& sender, winrt::Windows::UI::Core::PointerEventArgs const& args) {
-        //spdlog::info("mouse pos x: {}, y: {}", args.CurrentPoint().Position().X, args.CurrentPoint().Position().Y);
-        //args.Handled(true);
+        // this fires at the mouse's polling rate, keep it to a single store
+        const auto position = args.CurrentPoint().Position();
+        selaura::get_component<selaura::input_manager>().set_pointer_position(position.X, position.Y);
+    }
+
+    void input_manager::pointer_button_hk(winrt::Windows::UI::Core::CoreWindow const& sender, winrt::Windows::UI::Core::PointerEventArgs const& args) {
+        using kind_t = winrt::Windows::UI::Input::PointerUpdateKind;
+
+        const auto point = args.CurrentPoint();
+        int button = -1;
+        bool down = false;
+
+        switch (point.Properties().PointerUpdateKind()) {
+            case kind_t::LeftButtonPressed:     button = ImGuiMouseButton_Left; down = true; break;
+            case kind_t::LeftButtonReleased:    button = ImGuiMouseButton_Left; break;
+            case kind_t::RightButtonPressed:    button = ImGuiMouseButton_Right; down = true; break;
+            case kind_t::RightButtonReleased:   button = ImGuiMouseButton_Right; break;
+            case kind_t::MiddleButtonPressed:   button = ImGuiMouseButton_Middle; down = true; break;
+            case kind_t::MiddleButtonReleased:  button = ImGuiMouseButton_Middle; break;
+            default: return;
+        }
+
+        auto& input = selaura::get_component<selaura::input_manager>();
+        const float scale = input.pointer_scale.load(std::memory_order_relaxed);
+        const auto position = point.Position();
+        input.events.push({ input_event::kind::mouse_button, selaura::key::None, selaura::key_action::unknown, static_cast<std::uint8_t>(button), down, position.X * scale, position.Y * scale });
+
+        if (selaura::get_component<selaura::screen_manager>().captures_input()) {
+            args.Handled(true);
+        }
+    }
+
+    void input_manager::pointer_wheel_hk(winrt::Windows::UI::Core::CoreWindow const& sender, winrt::Windows::UI::Core::PointerEventArgs const& args) {
+        const auto properties = args.CurrentPoint().Properties();
+        // one notch is WHEEL_DELTA, imgui counts in notches
+        const float steps = static_cast<float>(properties.MouseWheelDelta()) / WHEEL_DELTA;
+
+        auto& input = selaura::get_component<selaura::input_manager>();
+        if (properties.IsHorizontalMouseWheel()) input.events.push({ input_event::kind::mouse_wheel, selaura::key::None, selaura::key_action::unknown, 0, false, steps, 0.0f });
+        else input.events.push({ input_event::kind::mouse_wheel, selaura::key::None, selaura::key_action::unknown, 0, false, 0.0f, steps });
+
+        if (selaura::get_component<selaura::screen_manager>().captures_input()) {
+            args.Handled(true);
+        }
+    }
+#else
+    namespace {
+        // values from android/input.h, there is no ndk to include them from on linux
+        constexpr std::int32_t event_type_key = 1;
+        constexpr std::int32_t event_type_motion = 2;
+
+        constexpr std::int32_t key_action_down = 0;
+        constexpr std::int32_t key_action_up = 1;
+
+        constexpr std::int32_t motion_action_mask = 0xff;
+        constexpr std::int32_t motion_action_down = 0;
+        constexpr std::int32_t motion_action_up = 1;
+        constexpr std::int32_t motion_action_move = 2;
+        constexpr std::int32_t motion_action_cancel = 3;
+        constexpr std::int32_t motion_action_hover_move = 7;
+        constexpr std::int32_t motion_action_scroll = 8;
+
+        constexpr std::int32_t axis_vscroll = 9;
+        constexpr std::int32_t axis_hscroll = 10;
+        constexpr std::int32_t tool_type_mouse = 3;
+
+        constexpr std::int32_t button_primary = 1 << 0;
+        constexpr std::int32_t button_secondary = 1 << 1;
+        constexpr std::int32_t button_tertiary = 1 << 2;
+
+        struct native_input_api {
+            std::int32_t (*AInputQueue_getEvent)(AInputQueue*, AInputEvent**);
+            void (*AInputQueue_finishEvent)(AInputQueue*, AInputEvent*, int);
+            std::int32_t (*AInputEvent_getType)(const AInputEvent*);
+            std::int32_t (*AKeyEvent_getAction)(const AInputEvent*);
+            std::int32_t (*AKeyEvent_getKeyCode)(const AInputEvent*);
+            std::int32_t (*AMotionEvent_getAction)(const AInputEvent*);
+            std::int32_t (*AMotionEvent_getButtonState)(const AInputEvent*);
+            std::int32_t (*AMotionEvent_getToolType)(const AInputEvent*, size_t);
+            float (*AMotionEvent_getX)(const AInputEvent*, size_t);
+            float (*AMotionEvent_getY)(const AInputEvent*, size_t);
+            float (*AMotionEvent_getAxisValue)(const AInputEvent*, std::int32_t, size_t);
+        };
+
+        native_input_api api{};
+
+        template <typename fn_t>
+        bool load(void* library, fn_t& out, const char* name) {
+            out = reinterpret_cast<fn_t>(dlsym(library, name));
+            if (!out) spdlog::error("Missing input symbol {}", name);
+            return out != nullptr;
+        }
+    }
+
+    void input_manager::init_native_hooks() {
+        // on mcpelauncher this resolves through the launcher's linker to its libandroid shim
+        void* library = dlopen("libandroid.so", RTLD_NOW);
+        if (!library) {
+            spdlog::error("Failed to open libandroid.so: {}", dlerror());
+            return;
+        }
+
+        const bool loaded = load(library, api.AInputQueue_getEvent, "AInputQueue_getEvent")
+            & load(library, api.AInputQueue_finishEvent, "AInputQueue_finishEvent")
+            & load(library, api.AInputEvent_getType, "AInputEvent_getType")
+            & load(library, api.AKeyEvent_getAction, "AKeyEvent_getAction")
+            & load(library, api.AKeyEvent_getKeyCode, "AKeyEvent_getKeyCode")
+            & load(library, api.AMotionEvent_getAction, "AMotionEvent_getAction")
+            & load(library, api.AMotionEvent_getButtonState, "AMotionEvent_getButtonState")
+            & load(library, api.AMotionEvent_getToolType, "AMotionEvent_getToolType")
+            & load(library, api.AMotionEvent_getX, "AMotionEvent_getX")
+            & load(library, api.AMotionEvent_getY, "AMotionEvent_getY")
+            & load(library, api.AMotionEvent_getAxisValue, "AMotionEvent_getAxisValue");
+        if (!loaded) return;
+
+        selaura::get_component<selaura::hook_manager>().register_hook_manual<&input_manager::get_event_hk>(reinterpret_cast<void*>(api.AInputQueue_getEvent));
+    }
+
+    std::int32_t input_manager::get_event_hk(AInputQueue* queue, AInputEvent** event) {
+        auto original = hook_manager::get_original<&input_manager::get_event_hk>();
+        auto& input = selaura::get_component<selaura::input_manager>();
+
+        // swallowed events are finished here, the game only ever sees the next one it's allowed to
+        while (true) {
+            const std::int32_t result = original(queue, event);
+            if (result < 0 || !input.queue_native(*event)) return result;
+            api.AInputQueue_finishEvent(queue, *event, 1);
+        }
+    }
+
+    bool input_manager::queue_native(AInputEvent* event) {
+        const bool captured = selaura::get_component<selaura::screen_manager>().captures_input();
+
+        if (api.AInputEvent_getType(event) == event_type_key) {
+            const std::int32_t native_action = api.AKeyEvent_getAction(event);
+            if (native_action != key_action_down && native_action != key_action_up) return false;
+
+            const auto action = native_action == key_action_down ? selaura::key_action::key_down : selaura::key_action::key_up;
+            this->events.push({ input_event::kind::key, key_from_android_keycode(api.AKeyEvent_getKeyCode(event)), action, 0, false, 0.0f, 0.0f });
+            return captured;
+        }
+
+        if (api.AInputEvent_getType(event) != event_type_motion) return false;
+
+        const std::int32_t action = api.AMotionEvent_getAction(event) & motion_action_mask;
+        const float x = api.AMotionEvent_getX(event, 0);
+        const float y = api.AMotionEvent_getY(event, 0);
+
+        if (action == motion_action_scroll) {
+            this->events.push({ input_event::kind::mouse_wheel, selaura::key::None, selaura::key_action::unknown, 0, false, api.AMotionEvent_getAxisValue(event, axis_hscroll, 0), api.AMotionEvent_getAxisValue(event, axis_vscroll, 0) });
+            return captured;
+        }
+
+        // positions are already in physical pixels here
+        this->set_pointer_position(x, y);
+
+        std::int32_t buttons = 0;
+        if (api.AMotionEvent_getToolType(event, 0) == tool_type_mouse) {
+            buttons = api.AMotionEvent_getButtonState(event);
+        }
+        else if (action != motion_action_up && action != motion_action_cancel && action != motion_action_hover_move) {
+            // a finger is the left button for as long as it is down
+            buttons = button_primary;
+        }
+
+        constexpr std::pair<std::int32_t, int> button_map[] = {
+            { button_primary, ImGuiMouseButton_Left },
+            { button_secondary, ImGuiMouseButton_Right },
+            { button_tertiary, ImGuiMouseButton_Middle },
+        };
+
+        const std::int32_t changed = buttons ^ this->native_buttons;
+        this->native_buttons = buttons;
+        for (const auto& [mask, button] : button_map) {
+            if (changed & mask) {
+                this->events.push({ input_event::kind::mouse_button, selaura::key::None, selaura::key_action::unknown, static_cast<std::uint8_t>(button), (buttons & mask) != 0, x, y });
+            }
+        }
+
+        // moves with nothing held still reach the game, camera look on mcpelauncher comes through here
+        return captured && (changed || buttons);
     }
 #endif
 };
\ No newline at end of file
@@ -6,24 +6,85 @@
 #include <winrt/Windows.UI.Input.h>
 #include <winrt/windows.graphics.display.h>
 #include <Windows.h>
+#else
+// opaque on every platform we touch them, the functions are looked up at runtime
+struct AInputQueue;
+struct AInputEvent;
 #endif
 
+#include <atomic>
+#include <cstdint>
+
 #include "key.hpp"
+#include "hotkey_index.hpp"
+#include "../util/spsc_ring.hpp"
 
 namespace selaura {
+    struct input_event {
+        enum class kind : std::uint8_t {
+            key,
+            mouse_button,
+            mouse_wheel
+        };
+
+        kind type;
+        selaura::key key;
+        selaura::key_action action;
+        // ImGuiMouseButton for mouse_button
+        std::uint8_t button;
+        bool down;
+        // pointer position for mouse_button, wheel steps for mouse_wheel
+        float x;
+        float y;
+    };
+
     struct input_manager {
 
         void init();
 
+        // game thread, once per game frame, dispatches everything the dispatcher thread queued since the last one
+        // returns whether anything came in, the frame pacer rebuilds on input
+        // pointer events only go to imgui while it is drawn, otherwise they are dropped and keys still dispatch
+        bool drain(bool to_imgui);
+
+        hotkey_index& get_hotkeys();
+
+        float get_mouse_x() const;
+        float get_mouse_y() const;
+
 #ifdef SELAURA_WINDOWS
         void init_winrt_hooks();
 
         static selaura::key translate_key(winrt::Windows::System::VirtualKey vkey);
         static void key_hk(winrt::Windows::UI::Core::CoreDispatcher const& sender, winrt::Windows::UI::Core::AcceleratorKeyEventArgs const& args);
         static void pointer_moved_hk(winrt::Windows::UI::Core::CoreWindow const& sender, winrt::Windows::UI::Core::PointerEventArgs const& args);
+        static void pointer_button_hk(winrt::Windows::UI::Core::CoreWindow const& sender, winrt::Windows::UI::Core::PointerEventArgs const& args);
+        static void pointer_wheel_hk(winrt::Windows::UI::Core::CoreWindow const& sender, winrt::Windows::UI::Core::PointerEventArgs const& args);
+#else
+        // android and mcpelauncher both feed the game through AInputQueue, reading it there needs no jni
+        void init_native_hooks();
+
+        static std::int32_t get_event_hk(AInputQueue* queue, AInputEvent** event);
+        // queues the event, returns true when the game shouldn't see it
+        bool queue_native(AInputEvent* event);
 #endif
 
-        // jni hooks
+    private:
+        void set_pointer_position(float x, float y);
 
+        // written by the dispatcher thread, read by the render thread
+        spsc_ring<input_event, 256> events;
+        // moves only ever need the latest position, both floats live in one word so they update together
+        std::atomic<std::uint64_t> pointer_position{ 0 };
+        // dips to physical pixels, imgui works in the same pixels as the gui's screen size
+        std::atomic<float> pointer_scale{ 1.0f };
+
+        hotkey_index hotkeys;
+        std::uint64_t applied_position = 0;
+#ifndef SELAURA_WINDOWS
+        std::int32_t native_buttons = 0;
+#endif
+        float mouse_x = 0.0f;
+        float mouse_y = 0.0f;
     };
 };
\ No newline at end of file
@@ -0,0 +1,190 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <magic_enum/magic_enum.hpp>
+#include "key.hpp"
+
+// Tab and None share their values with NamedKey_BEGIN and ImGuiMod_None, pin the names we actually want
+template <>
+struct magic_enum::customize::enum_range<selaura::key> {
+    static constexpr int min = 0;
+    static constexpr int max = selaura::key::NamedKey_END - 1;
+};
+
+template <>
+constexpr magic_enum::customize::customize_t magic_enum::customize::enum_name<selaura::key>(selaura::key value) noexcept {
+    switch (value) {
+        case selaura::key::None: return "None";
+        case selaura::key::Tab: return "Tab";
+        default: return default_tag;
+    }
+}
+
+namespace selaura {
+    struct key_mapping {
+        selaura::key key;
+        // windows VirtualKey
+        std::uint16_t virtual_key;
+        // AKEYCODE_*, which mcpelauncher hands to the game on linux as well
+        std::uint16_t android_keycode;
+    };
+
+    // the one place platform codes are written down, every lookup below is generated from it
+    inline constexpr key_mapping key_mappings[] = {
+        { key::Tab, 0x09, 61 },
+        { key::Shift, 0x10, 59 },
+        { key::Control, 0x11, 113 },
+        { key::Alt, 0x12, 57 },
+        { key::LeftArrow, 0x25, 21 },
+        { key::RightArrow, 0x27, 22 },
+        { key::UpArrow, 0x26, 19 },
+        { key::DownArrow, 0x28, 20 },
+        { key::PageUp, 0x21, 92 },
+        { key::PageDown, 0x22, 93 },
+        { key::Home, 0x24, 122 },
+        { key::End, 0x23, 123 },
+        { key::Insert, 0x2D, 124 },
+        { key::Delete, 0x2E, 112 },
+        { key::Backspace, 0x08, 67 },
+        { key::Space, 0x20, 62 },
+        { key::Enter, 0x0D, 66 },
+        { key::Escape, 0x1B, 111 },
+        { key::Menu, 0x5D, 82 },
+
+        { key::NUM_0, 0x30, 7 },
+        { key::NUM_1, 0x31, 8 },
+        { key::NUM_2, 0x32, 9 },
+        { key::NUM_3, 0x33, 10 },
+        { key::NUM_4, 0x34, 11 },
+        { key::NUM_5, 0x35, 12 },
+        { key::NUM_6, 0x36, 13 },
+        { key::NUM7, 0x37, 14 },
+        { key::NUM_8, 0x38, 15 },
+        { key::NUM_9, 0x39, 16 },
+
+        { key::A, 0x41, 29 }, { key::B, 0x42, 30 }, { key::C, 0x43, 31 }, { key::D, 0x44, 32 },
+        { key::E, 0x45, 33 }, { key::F, 0x46, 34 }, { key::G, 0x47, 35 }, { key::H, 0x48, 36 },
+        { key::I, 0x49, 37 }, { key::J, 0x4A, 38 }, { key::K, 0x4B, 39 }, { key::L, 0x4C, 40 },
+        { key::M, 0x4D, 41 }, { key::N, 0x4E, 42 }, { key::O, 0x4F, 43 }, { key::P, 0x50, 44 },
+        { key::Q, 0x51, 45 }, { key::R, 0x52, 46 }, { key::S, 0x53, 47 }, { key::T, 0x54, 48 },
+        { key::U, 0x55, 49 }, { key::V, 0x56, 50 }, { key::W, 0x57, 51 }, { key::X, 0x58, 52 },
+        { key::Y, 0x59, 53 }, { key::Z, 0x5A, 54 },
+
+        { key::F1, 0x70, 131 }, { key::F2, 0x71, 132 }, { key::F3, 0x72, 133 }, { key::F4, 0x73, 134 },
+        { key::F5, 0x74, 135 }, { key::F6, 0x75, 136 }, { key::F7, 0x76, 137 }, { key::F8, 0x77, 138 },
+        { key::F9, 0x78, 139 }, { key::F10, 0x79, 140 }, { key::F11, 0x7A, 141 }, { key::F12, 0x7B, 142 },
+        { key::F13, 0x7C, 0 }, { key::F14, 0x7D, 0 }, { key::F15, 0x7E, 0 }, { key::F16, 0x7F, 0 },
+        { key::F17, 0x80, 0 }, { key::F18, 0x81, 0 }, { key::F19, 0x82, 0 }, { key::F20, 0x83, 0 },
+        { key::F21, 0x84, 0 }, { key::F22, 0x85, 0 }, { key::F23, 0x86, 0 }, { key::F24, 0x87, 0 },
+
+        { key::CapsLock, 0x14, 115 },
+        { key::ScrollLock, 0x91, 116 },
+        { key::NumLock, 0x90, 143 },
+        { key::PrintScreen, 0x2C, 120 },
+        { key::Pause, 0x13, 121 },
+
+        { key::Keypad0, 0x60, 144 }, { key::Keypad1, 0x61, 145 }, { key::Keypad2, 0x62, 146 },
+        { key::Keypad3, 0x63, 147 }, { key::Keypad4, 0x64, 148 }, { key::Keypad5, 0x65, 149 },
+        { key::Keypad6, 0x66, 150 }, { key::Keypad7, 0x67, 151 }, { key::Keypad8, 0x68, 152 },
+        { key::Keypad9, 0x69, 153 },
+        { key::KeypadDecimal, 0x6E, 158 },
+        { key::KeypadDivide, 0x6F, 154 },
+        { key::KeypadMultiply, 0x6A, 155 },
+        { key::KeypadSubtract, 0x6D, 156 },
+        { key::KeypadAdd, 0x6B, 157 },
+        // windows reports keypad enter as a plain enter with the extended flag
+        { key::KeypadEnter, 0, 160 },
+        { key::KeypadEqual, 0, 161 },
+
+        { key::Equal, 0xBB, 70 },
+        { key::Semicolon, 0xBA, 74 },
+        { key::Minus, 0xBD, 69 },
+        { key::Comma, 0xBC, 55 },
+        { key::Period, 0xBE, 56 },
+        { key::Slash, 0xBF, 76 },
+        { key::GraveAccent, 0xC0, 68 },
+        { key::LeftBracket, 0xDB, 71 },
+        { key::Backslash, 0xDC, 73 },
+        { key::RightBracket, 0xDD, 72 },
+        { key::Apostrophe, 0xDE, 75 },
+        { key::Oem102, 0xE2, 0 },
+        { key::AppBack, 0xA6, 4 },
+        { key::AppForward, 0xA7, 125 },
+
+        // right hand modifiers only exist as their own codes on android
+        { key::Shift, 0, 60 },
+        { key::Control, 0, 114 },
+        { key::Alt, 0, 58 },
+    };
+
+    namespace detail {
+        inline constexpr std::size_t key_slots = selaura::key::NamedKey_END;
+        inline constexpr std::size_t virtual_key_slots = 256;
+        inline constexpr std::size_t android_keycode_slots = 320;
+
+        template <std::uint16_t key_mapping::* code, std::size_t size>
+        consteval std::array<selaura::key, size> make_from_platform() {
+            std::array<selaura::key, size> out{};
+            for (const auto& row : key_mappings) {
+                if (row.*code) out[row.*code] = row.key;
+            }
+            return out;
+        }
+
+        template <std::uint16_t key_mapping::* code>
+        consteval std::array<std::uint16_t, key_slots> make_to_platform() {
+            std::array<std::uint16_t, key_slots> out{};
+            // a key with several codes maps back to the first one listed
+            for (const auto& row : key_mappings) {
+                if (row.*code && !out[row.key]) out[row.key] = row.*code;
+            }
+            return out;
+        }
+
+        consteval std::array<std::string_view, key_slots> make_names() {
+            std::array<std::string_view, key_slots> out{};
+            for (const auto& [value, name] : magic_enum::enum_entries<selaura::key>()) {
+                out[value] = name;
+            }
+            return out;
+        }
+
+        inline constexpr auto from_virtual_key = make_from_platform<&key_mapping::virtual_key, virtual_key_slots>();
+        inline constexpr auto from_android_keycode = make_from_platform<&key_mapping::android_keycode, android_keycode_slots>();
+        inline constexpr auto to_virtual_key = make_to_platform<&key_mapping::virtual_key>();
+        inline constexpr auto to_android_keycode = make_to_platform<&key_mapping::android_keycode>();
+        inline constexpr auto key_names = make_names();
+    }
+
+    // every lookup is a single index, codes outside the tables come back as key::None or 0
+    constexpr selaura::key key_from_virtual_key(std::uint32_t code) {
+        return code < detail::virtual_key_slots ? detail::from_virtual_key[code] : key::None;
+    }
+
+    constexpr selaura::key key_from_android_keycode(std::int32_t code) {
+        return code >= 0 && static_cast<std::size_t>(code) < detail::android_keycode_slots ? detail::from_android_keycode[code] : key::None;
+    }
+
+    constexpr std::uint16_t key_to_virtual_key(selaura::key value) {
+        return static_cast<std::size_t>(value) < detail::key_slots ? detail::to_virtual_key[value] : 0;
+    }
+
+    constexpr std::uint16_t key_to_android_keycode(selaura::key value) {
+        return static_cast<std::size_t>(value) < detail::key_slots ? detail::to_android_keycode[value] : 0;
+    }
+
+    constexpr std::string_view key_name(selaura::key value) {
+        return static_cast<std::size_t>(value) < detail::key_slots ? detail::key_names[value] : std::string_view{};
+    }
+
+    // names are only parsed when reading bindings, this one is allowed to scan
+    constexpr std::optional<selaura::key> key_from_name(std::string_view name) {
+        return magic_enum::enum_cast<selaura::key>(name);
+    }
+
+    static_assert(key_from_virtual_key(0x41) == key::A && key_to_virtual_key(key::A) == 0x41);
+    static_assert(key_from_android_keycode(61) == key::Tab && key_to_android_keycode(key::Escape) == 111);
+};
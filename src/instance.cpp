@@ -1,4 +1,11 @@
 #include "instance.hpp"
+#include "async/init_graph.hpp"
+
+#ifndef SELAURA_WINDOWS
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #ifdef SELAURA_WINDOWS
 DWORD WINAPI unload_thread(LPVOID hModule) {
@@ -13,6 +20,84 @@ DWORD WINAPI unload_thread(LPVOID hModule) {
 namespace selaura {
 	std::shared_ptr<selaura::instance> inst;
 
+	namespace {
+		// loggers share one file sink, so the per-logger tag comes from the logger name instead of its pattern
+		struct logger_tag_flag : spdlog::custom_flag_formatter {
+			void format(const spdlog::details::log_msg& msg, const std::tm&, spdlog::memory_buf_t& dest) override {
+				if (msg.logger_name == "selaura") return;
+				dest.push_back('[');
+				dest.append(msg.logger_name.data(), msg.logger_name.data() + msg.logger_name.size());
+				dest.append(std::string_view("] "));
+			}
+
+			std::unique_ptr<spdlog::custom_flag_formatter> clone() const override {
+				return spdlog::details::make_unique<logger_tag_flag>();
+			}
+		};
+
+		// spdlog::shutdown joins the writer thread and takes the registry lock, neither is safe from a crashing thread
+		// the handlers only get what is already written to disk, lines still queued for the writer thread are lost
+#ifdef SELAURA_WINDOWS
+		LPTOP_LEVEL_EXCEPTION_FILTER previous_filter = nullptr;
+		spdlog::sinks::basic_file_sink_mt* crash_sink = nullptr;
+
+		LONG WINAPI crash_filter(EXCEPTION_POINTERS* info) {
+			if (crash_sink) crash_sink->flush();
+			return previous_filter ? previous_filter(info) : EXCEPTION_CONTINUE_SEARCH;
+		}
+
+		void install_crash_flush(spdlog::sinks::basic_file_sink_mt& sink, const std::filesystem::path&) {
+			crash_sink = &sink;
+			previous_filter = SetUnhandledExceptionFilter(crash_filter);
+		}
+#else
+		constexpr int crash_signals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGILL, SIGFPE };
+		struct sigaction previous_actions[std::size(crash_signals)];
+		// opened up front, write() is the only thing a signal handler can safely do with it
+		int crash_fd = -1;
+
+		void crash_handler(int signal) {
+			if (crash_fd != -1) {
+				char line[] = "[crash] fatal signal   , lines logged just before it may be missing\n";
+				line[21] = static_cast<char>('0' + signal / 10 % 10);
+				line[22] = static_cast<char>('0' + signal % 10);
+				[[maybe_unused]] const auto written = write(crash_fd, line, sizeof(line) - 1);
+			}
+
+			for (std::size_t i = 0; i < std::size(crash_signals); i++) {
+				if (crash_signals[i] == signal) sigaction(signal, &previous_actions[i], nullptr);
+			}
+			raise(signal);
+		}
+
+		void install_crash_flush(spdlog::sinks::basic_file_sink_mt&, const std::filesystem::path& log_file) {
+			crash_fd = open(log_file.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+
+			struct sigaction action{};
+			action.sa_handler = crash_handler;
+			sigemptyset(&action.sa_mask);
+
+			for (std::size_t i = 0; i < std::size(crash_signals); i++) {
+				sigaction(crash_signals[i], &action, &previous_actions[i]);
+			}
+		}
+#endif
+	}
+
+	instance::~instance() {
+		// waits out detours already running, after this nothing from the game calls back into us
+		get<hook_manager>().destroy();
+		// stopped explicitly rather than by the tuple, no task or job may still run or log once spdlog is shut down
+		get<task_scheduler>().shutdown();
+		get<job_system>().shutdown();
+		// the workers are gone, the write happens right here
+		get<config_manager>().flush();
+#if defined(SELAURA_TRACING)
+		profiler::write_trace(this->data_folder / "trace.json");
+#endif
+		spdlog::shutdown();
+	}
+
 	std::shared_ptr<selaura::instance> instance::get() {
 		return selaura::inst;
 	}
@@ -20,6 +105,8 @@ namespace selaura {
 	bool instance::start() {
 		if (auto self = shared_from_this(); self) {
 			selaura::inst = self;
+			// published before init installs any hook, hooking flushes the writes every other thread sees
+			instance::pinned = this;
 		}
 		else {
 			throw std::runtime_error("selaura::instance must be managed by an std::shared_ptr");
@@ -29,31 +116,65 @@ namespace selaura {
 	}
 
 	void instance::init() {
+		SELAURA_TRACE_SCOPE("instance::init");
 		auto startTime = std::chrono::high_resolution_clock::now();
+		this->start_time = std::chrono::steady_clock::now();
 
-		this->get_data_folder();
+		this->resolve_data_folder();
 		auto log_file = this->data_folder / "logs.txt";
 
-		auto logger = spdlog::basic_logger_mt("selaura", log_file.string(), true);
-		logger->set_pattern("[%Y-%m-%d %H:%M:%S] [%^%l%$] %v");
-		logger->set_level(spdlog::level::debug);
-		logger->flush_on(spdlog::level::debug);
+		// one background writer owns the file, callers only pay for queueing the message
+		spdlog::init_thread_pool(8192, 1);
 
-		spdlog::set_default_logger(logger);
+		auto formatter = std::make_unique<spdlog::pattern_formatter>();
+		formatter->add_flag<logger_tag_flag>('*').set_pattern("[%Y-%m-%d %H:%M:%S] [%^%l%$] %*%v");
 
-		get<hook_manager>().init();
-		get<input_manager>().init();
-		get<script_manager>().init();
-		get<screen_manager>().init();
+		auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_file.string(), true);
+		file_sink->set_formatter(std::move(formatter));
 
+		auto logger = std::make_shared<spdlog::async_logger>("selaura", file_sink, spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+		logger->set_level(spdlog::level::debug);
+		logger->flush_on(spdlog::level::err);
+
+		spdlog::register_logger(logger);
+		spdlog::set_default_logger(logger);
+		spdlog::flush_every(std::chrono::seconds(1));
+		install_crash_flush(*file_sink, log_file);
+
+		// everything that only needs the job pool runs at once, hooks are patched one phase at a time and installed last
+		get<job_system>().init();
+		get<task_scheduler>().init();
+		// mapped before anything that reads assets is started
+		get<asset_bundle>().init();
+
+		init_graph graph;
+		graph.add("signatures", [&] { get<hook_manager>().init(); });
+		graph.add("scripts", [&] { get<script_manager>().init(); }, {}, init_thread::caller);
+		graph.add("screens", [&] { get<screen_manager>().init(); });
+		graph.add("features", [&] { get<feature_manager>().init(); });
+		graph.add("input", [&] { get<input_manager>().init(); }, { "signatures" });
+		graph.add("localization", [&] { get<localization>().init(); });
+		graph.add("config", [&] { get<config_manager>().init(); }, { "features", "signatures", "input", "localization" });
+		graph.add("metrics", [&] { get<metrics_exporter>().init(); });
+		// requests are applied from the first tick on, by then the saved config is in and a queued change wins over it
+		graph.add("launcher", [&] { get<launcher_channel>().init(); }, { "features", "scripts", "config" });
+		graph.add("hooks", [&] { get<hook_manager>().install(); }, { "signatures", "scripts", "screens", "input", "config", "localization" });
+		graph.run(get<job_system>());
+		graph.log_timings();
+
+		// ahead of every feature and script, so a key an open screen swallows never fans out to them
 		get<event_manager>().subscribe<key_event>([&](key_event& ev) {
-			get<screen_manager>().for_each([&](screen& scr) {
-				if (scr.is_enabled()) ev.cancel();
+			if (get<screen_manager>().captures_input()) {
+				ev.cancel();
 
-				if (!scr.is_enabled() && scr.get_hotkey() == ev.key && ev.action == selaura::key_action::key_up) scr.set_enabled(true);
-				if (scr.is_enabled() && ev.key == selaura::key::Escape && ev.action == selaura::key_action::key_up) scr.set_enabled(false);
-			});
-		});
+				if (ev.key == selaura::key::Escape && ev.action == selaura::key_action::key_up) {
+					get<screen_manager>().for_each([](screen& scr) { scr.set_enabled(false); });
+					return;
+				}
+			}
+
+			get<input_manager>().get_hotkeys().handle(ev);
+		}, { event_priority::highest });
 
 #ifdef SELAURA_WINDOWS
 		winrt::Windows::ApplicationModel::Core::CoreApplication::MainView().CoreWindow().Dispatcher().RunAsync(winrt::Windows::UI::Core::CoreDispatcherPriority::Normal, []() {
@@ -67,13 +188,14 @@ namespace selaura {
 		spdlog::info("Successfully injected [{:.2f}s]", duration.count());
 	}
 
-	const std::filesystem::path& instance::get_data_folder() {
+	void instance::resolve_data_folder() {
 #ifdef SELAURA_WINDOWS
 		char* localAppData = nullptr;
 		size_t size = 0;
 		_dupenv_s(&localAppData, &size, "APPDATA");
 		if (localAppData) {
 			this->data_folder = std::filesystem::path(localAppData + std::string("\\..\\Local\\Packages\\Microsoft.MinecraftUWP_8wekyb3d8bbwe\\RoamingState\\Selaura"));
+			free(localAppData);
 		}
 #elif defined(SELAURA_LINUX)
 		this->data_folder = "/data/data/com.mojang.minecraftpe/Selaura";
@@ -81,7 +203,5 @@ namespace selaura {
 		this->data_folder = "/data/data/com.selauraclient.launcher/Selaura";
 #endif
 		std::filesystem::create_directories(this->data_folder);
-
-		return this->data_folder;
 	}
 };
\ No newline at end of file
@@ -3,9 +3,12 @@
 #include <format>
 #include <chrono>
 #include <tuple>
+#include <type_traits>
 
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/pattern_formatter.h>
 #include <filesystem>
 
 #ifdef SELAURA_WINDOWS
@@ -17,27 +20,48 @@
 
 #include "sdk/mem/signatures.hpp"
 #include "event/event_manager.hpp"
+#include "async/task_scheduler.hpp"
+#include "async/job_system.hpp"
 #include "sdk/globals.hpp"
+#include "assets/asset_bundle.hpp"
 #include "hook/hook_manager.hpp"
 #include "renderer/renderer.hpp"
+#include "renderer/texture_manager.hpp"
+#include "renderer/texture_atlas.hpp"
 #include "input/input_manager.hpp"
 #include "feature/feature_manager.hpp"
+#include "config/config_manager.hpp"
 #include "screen/screen_manager.hpp"
 #include "scripting/script_manager.hpp"
+#include "i18n/localization.hpp"
+#include "profiler/metrics_export.hpp"
+#include "launcher/launcher_channel.hpp"
 
 namespace selaura {
 	struct instance : public std::enable_shared_from_this<instance> {
+		// the tuple tears down front to back, the job system goes first so no job outlives what it touches
 		using components_t = std::tuple<
+			job_system,
 			event_manager,
+			task_scheduler,
 			globals,
+			asset_bundle,
 			hook_manager,
 			renderer,
+			texture_manager,
+			texture_atlas,
 			input_manager,
 			feature_manager,
+			config_manager,
+			localization,
 			screen_manager,
-			script_manager
+			script_manager,
+			metrics_exporter,
+			launcher_channel
 		>;
 
+		~instance();
+
 		bool start();
 		void init();
 
@@ -46,10 +70,42 @@ namespace selaura {
 			return std::get<component>(components);
 		}
 
-		const std::filesystem::path& get_data_folder();
+		// resolved once by init before anything else runs, read only from then on so init graph nodes can share it
+		const std::filesystem::path& get_data_folder() const {
+			return this->data_folder;
+		}
 		static std::shared_ptr<selaura::instance> get();
+
+		// when init began, startup timings are measured from here
+		std::chrono::steady_clock::time_point get_start_time() const {
+			return this->start_time;
+		}
+
+		// no refcount, the instance is pinned from start() until the module goes away and hooks are gone before it is destroyed
+		static instance& current() {
+			return *pinned;
+		}
 	private:
+		void resolve_data_folder();
+
+		inline static instance* pinned = nullptr;
+
+		template <typename tuple_t>
+		struct pinned_components;
+
+		template <typename... component_t>
+		struct pinned_components<std::tuple<component_t...>> : std::bool_constant<((std::is_trivially_copyable_v<component_t> || !std::is_copy_constructible_v<component_t>) && ...)> {};
+
+		static_assert(pinned_components<components_t>::value, "non-trivial components must not be copyable, take them by reference");
+
 		components_t components{};
 		std::filesystem::path data_folder;
+		std::chrono::steady_clock::time_point start_time{};
 	};
+
+	// a plain load and an offset, no atomics, meant for hook bodies
+	template <typename component>
+	component& get_component() {
+		return instance::current().get<component>();
+	}
 }
\ No newline at end of file
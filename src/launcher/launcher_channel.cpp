@@ -0,0 +1,244 @@
+#include "launcher_channel.hpp"
+#include "../instance.hpp"
+#include "../profiler/memory.hpp"
+#include "../util/byte_stream.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace selaura {
+    namespace {
+        using launcher_layout::message;
+
+        constexpr std::uint32_t padded(std::uint32_t size) {
+            return (static_cast<std::uint32_t>(sizeof(launcher_layout::record)) + size + 7) & ~std::uint32_t{ 7 };
+        }
+
+        feature* find_feature(std::string_view name) {
+            feature* found = nullptr;
+            selaura::get_component<selaura::feature_manager>().for_each([&](feature& feat) {
+                if (feat.get_name() == name) found = &feat;
+            });
+            return found;
+        }
+    }
+
+    void launcher_channel::init() {
+        const auto path = selaura::instance::get()->get_data_folder() / "control.shm";
+        if (!this->segment.open(path, launcher_layout::total_size)) {
+            spdlog::warn("Could not map {}, launcher changes need a restart", path.string());
+            return;
+        }
+
+        auto* base = reinterpret_cast<std::uint8_t*>(this->segment.bytes().data());
+        this->head = reinterpret_cast<launcher_layout::header*>(base);
+
+        // a launcher that got here first may already have queued requests, only a missing or different layout is reset
+        auto& head = *this->head;
+        const bool valid = std::atomic_ref<std::uint32_t>(head.magic).load(std::memory_order_acquire) == launcher_layout::magic
+            && head.version == launcher_layout::version
+            && head.header_size == sizeof(launcher_layout::header)
+            && head.inbox_offset == launcher_layout::inbox_offset
+            && head.outbox_offset == launcher_layout::outbox_offset
+            && head.inbox.capacity == launcher_layout::inbox_capacity
+            && head.outbox.capacity == launcher_layout::outbox_capacity;
+
+        if (!valid) {
+            std::memset(base, 0, launcher_layout::total_size);
+            head.version = launcher_layout::version;
+            head.header_size = sizeof(launcher_layout::header);
+            head.inbox_offset = launcher_layout::inbox_offset;
+            head.outbox_offset = launcher_layout::outbox_offset;
+            head.inbox.capacity = launcher_layout::inbox_capacity;
+            head.outbox.capacity = launcher_layout::outbox_capacity;
+            // written last, a launcher that sees the magic sees a complete header
+            std::atomic_ref<std::uint32_t>(head.magic).store(launcher_layout::magic, std::memory_order_release);
+        }
+
+        // the offsets in the header are only there for the launcher, the mapping itself is never trusted for them
+        this->inbox = base + launcher_layout::inbox_offset;
+        this->outbox = base + launcher_layout::outbox_offset;
+
+        selaura::get_component<selaura::event_manager>().subscribe<minecraftgame_update_event>(&launcher_channel::on_update, this);
+        spdlog::info("Listening for the launcher on {}", path.filename().string());
+    }
+
+    void launcher_channel::on_update(minecraftgame_update_event& ev) {
+        auto& ring = this->head->inbox;
+        std::atomic_ref<std::uint32_t> tail_ref(ring.tail);
+
+        // one acquire load when nothing is queued, which is nearly every tick
+        const std::uint32_t available = std::atomic_ref<std::uint32_t>(ring.head).load(std::memory_order_acquire);
+        std::uint32_t tail = tail_ref.load(std::memory_order_relaxed);
+        if (tail == available) return;
+
+        constexpr std::uint32_t capacity = launcher_layout::inbox_capacity;
+        // a flood of requests is spread over several ticks instead of stalling one frame, the rest stays queued
+        for (std::uint32_t handled = 0; tail != available && handled < max_requests_per_tick; handled++) {
+            const std::uint32_t offset = tail & (capacity - 1);
+
+            // a record that claims more than was published or runs past the end can't be trusted, neither can anything after it
+            const auto drop = [&] {
+                spdlog::error("Dropping {} bytes of malformed launcher requests", available - tail);
+                tail = available;
+            };
+
+            if (offset % 8 != 0 || available - tail < sizeof(launcher_layout::record)) {
+                drop();
+                break;
+            }
+
+            launcher_layout::record record;
+            std::memcpy(&record, this->inbox + offset, sizeof(record));
+
+            if (static_cast<message>(record.type) == message::wrap) {
+                if (capacity - offset > available - tail) {
+                    drop();
+                    break;
+                }
+                tail += capacity - offset;
+                continue;
+            }
+
+            if (record.size > capacity - offset - sizeof(record) || padded(record.size) > available - tail) {
+                drop();
+                break;
+            }
+
+            this->handle(static_cast<message>(record.type), { this->inbox + offset + sizeof(record), record.size });
+            tail += padded(record.size);
+        }
+
+        tail_ref.store(tail, std::memory_order_release);
+    }
+
+    void launcher_channel::handle(message type, std::span<const std::uint8_t> payload) {
+        byte_reader in{ payload.data(), payload.data() + payload.size() };
+        const auto id = in.get<std::uint32_t>();
+        if (!in.ok) return;
+
+        switch (type) {
+            case message::set_feature: {
+                const bool enabled = in.get<std::uint8_t>() != 0;
+                const auto name = in.get_string();
+                if (!in.ok) return this->reply_result(id, false, "truncated request");
+
+                auto* target = find_feature(name);
+                if (!target) return this->reply_result(id, false, "unknown feature");
+
+                target->set_enabled(enabled);
+                return this->reply_result(id, true, {});
+            }
+            case message::set_setting: {
+                const auto name = in.get_string();
+                const auto setting_name = in.get_string();
+                const auto setting_type = in.get<std::uint8_t>();
+
+                feature_setting_type value;
+                switch (setting_type) {
+                    case 0: value = in.get<float>(); break;
+                    case 1: value = in.get<std::uint8_t>() != 0; break;
+                    case 2: value = in.get<int>(); break;
+                    case 3: value = in.get<glm::vec4>(); break;
+                    default: return this->reply_result(id, false, "unknown setting type");
+                }
+                if (!in.ok) return this->reply_result(id, false, "truncated request");
+
+                auto* target = find_feature(name);
+                if (!target) return this->reply_result(id, false, "unknown feature");
+
+                const auto settings = target->get_settings();
+                for (std::size_t idx = 0; idx < settings.size(); idx++) {
+                    if (settings[idx].name == setting_name && settings[idx].value.index() == setting_type) {
+                        // marks the config dirty like a change from the click gui, so it is saved too
+                        target->set_setting(idx, value);
+                        return this->reply_result(id, true, {});
+                    }
+                }
+                return this->reply_result(id, false, "unknown setting");
+            }
+            case message::upload_script: {
+                const auto name = in.get_string();
+                if (!in.ok) return this->reply_result(id, false, "truncated request");
+
+                // the record is only ours until the tail moves past it, the source is copied out once
+                const auto* source = reinterpret_cast<const std::byte*>(in.it);
+                std::vector<std::byte> owned(source, reinterpret_cast<const std::byte*>(in.end));
+                if (!selaura::get_component<selaura::script_manager>().upload(name, std::move(owned))) {
+                    return this->reply_result(id, false, "not a .lua file name");
+                }
+
+                // compile errors end up in the log, like a script dropped into the folder
+                return this->reply_result(id, true, "queued");
+            }
+            case message::query_status: {
+                std::uint16_t features = 0;
+                std::uint16_t enabled = 0;
+                selaura::get_component<selaura::feature_manager>().for_each([&](const feature& feat) {
+                    features++;
+                    if (feat.is_enabled()) enabled++;
+                });
+
+                std::uint64_t tracked = 0;
+                for (const auto& usage : memory::snapshot()) tracked += usage.live;
+
+                const auto uptime = std::chrono::steady_clock::now() - selaura::instance::current().get_start_time();
+
+                std::vector<std::uint8_t> payload;
+                byte_writer out{ payload };
+                out.put(id);
+                out.put(features);
+                out.put(enabled);
+                out.put(static_cast<std::uint16_t>(selaura::get_component<selaura::script_manager>().get_scripts().size()));
+                out.put(std::uint16_t{ 0 });
+                out.put(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(uptime).count()));
+                out.put(tracked);
+                out.put_string(CLIENT_VERSION DEVELOPER_MODE);
+                this->reply(message::status, payload);
+                return;
+            }
+            default:
+                return this->reply_result(id, false, "unknown request");
+        }
+    }
+
+    bool launcher_channel::reply(message type, const std::vector<std::uint8_t>& payload) {
+        auto& ring = this->head->outbox;
+        std::atomic_ref<std::uint32_t> head_ref(ring.head);
+        constexpr std::uint32_t capacity = launcher_layout::outbox_capacity;
+
+        std::uint32_t head = head_ref.load(std::memory_order_relaxed);
+        const std::uint32_t tail = std::atomic_ref<std::uint32_t>(ring.tail).load(std::memory_order_acquire);
+
+        const auto size = static_cast<std::uint32_t>(payload.size());
+        const std::uint32_t offset = head & (capacity - 1);
+        const std::uint32_t skip = capacity - offset < padded(size) ? capacity - offset : 0;
+        if (padded(size) + skip > capacity - (head - tail)) {
+            spdlog::warn("The launcher is not reading replies, dropped one");
+            return false;
+        }
+
+        if (skip != 0) {
+            const launcher_layout::record wrap{ static_cast<std::uint16_t>(message::wrap), 0, skip - static_cast<std::uint32_t>(sizeof(launcher_layout::record)) };
+            std::memcpy(this->outbox + offset, &wrap, sizeof(wrap));
+            head += skip;
+        }
+
+        const std::uint32_t at = head & (capacity - 1);
+        const launcher_layout::record record{ static_cast<std::uint16_t>(type), 0, size };
+        std::memcpy(this->outbox + at, &record, sizeof(record));
+        std::memcpy(this->outbox + at + sizeof(record), payload.data(), payload.size());
+
+        head_ref.store(head + padded(size), std::memory_order_release);
+        return true;
+    }
+
+    void launcher_channel::reply_result(std::uint32_t id, bool ok, std::string_view detail) {
+        std::vector<std::uint8_t> payload;
+        byte_writer out{ payload };
+        out.put(id);
+        out.put(static_cast<std::uint8_t>(ok));
+        out.put_string(detail);
+        this->reply(message::result, payload);
+    }
+};
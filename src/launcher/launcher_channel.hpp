@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../util/shared_mapping.hpp"
+
+namespace selaura {
+    struct minecraftgame_update_event;
+
+    // data_folder/control.shm, two single producer single consumer byte rings shared with the launcher
+    // the launcher writes requests into the inbox, the module answers in the outbox, neither side ever waits on the other
+    namespace launcher_layout {
+        inline constexpr std::uint32_t magic = 0x4C435353; // "SSCL"
+        inline constexpr std::uint16_t version = 1;
+        inline constexpr std::uint32_t inbox_capacity = 256 * 1024;
+        inline constexpr std::uint32_t outbox_capacity = 64 * 1024;
+
+        // head and tail count bytes and only ever grow, wrapping at 2^32, head is stored by the producer and tail by the consumer
+        // a side publishes with a release store and reads the other side's counter with an acquire load
+        struct ring {
+            std::uint32_t head;
+            std::uint32_t tail;
+            std::uint32_t capacity;
+            std::uint32_t reserved;
+        };
+
+        // every record starts 8 byte aligned and is padded to 8, one that would run past the end is preceded by a wrap record filling the rest
+        struct record {
+            std::uint16_t type;
+            std::uint16_t reserved;
+            std::uint32_t size;
+        };
+
+        enum class message : std::uint16_t {
+            wrap = 0,
+
+            // launcher to module, every request starts with a u32 id that its reply echoes
+            // u8 enabled, string feature
+            set_feature = 1,
+            // string feature, string setting, u8 type, value as in config.bin
+            set_setting = 2,
+            // string file name, then the source up to the end of the record
+            upload_script = 3,
+            // nothing past the id
+            query_status = 4,
+
+            // module to launcher
+            // u8 ok, string detail
+            result = 128,
+            // u16 features, u16 enabled features, u16 scripts, u16 reserved, u64 uptime ms, u64 tracked bytes, string version
+            status = 129
+        };
+
+        // strings are a u16 length and that many utf-8 bytes, all values little endian
+        struct header {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t header_size;
+            std::uint32_t inbox_offset;
+            std::uint32_t outbox_offset;
+            ring inbox;
+            ring outbox;
+        };
+
+        inline constexpr std::uint32_t inbox_offset = sizeof(header);
+        inline constexpr std::uint32_t outbox_offset = inbox_offset + inbox_capacity;
+        inline constexpr std::size_t total_size = sizeof(header) + inbox_capacity + outbox_capacity;
+
+        static_assert(std::is_standard_layout_v<header> && sizeof(header) == 48 && sizeof(record) == 8);
+        static_assert((inbox_capacity & (inbox_capacity - 1)) == 0 && (outbox_capacity & (outbox_capacity - 1)) == 0, "capacities must be powers of two");
+    };
+
+    // setting changes, script uploads and status queries from the launcher, applied on the game thread within a tick
+    struct launcher_channel {
+        launcher_channel() = default;
+        launcher_channel(const launcher_channel&) = delete;
+        launcher_channel& operator=(const launcher_channel&) = delete;
+
+        // maps the segment, call once features and scripts exist
+        void init();
+
+        // records handled per tick, wrap records included
+        static constexpr std::uint32_t max_requests_per_tick = 32;
+    private:
+        void on_update(minecraftgame_update_event& ev);
+        void handle(launcher_layout::message type, std::span<const std::uint8_t> payload);
+
+        // false when the launcher has stopped draining the outbox, the reply is dropped
+        bool reply(launcher_layout::message type, const std::vector<std::uint8_t>& payload);
+        void reply_result(std::uint32_t id, bool ok, std::string_view detail);
+
+        shared_mapping segment;
+        launcher_layout::header* head = nullptr;
+        std::uint8_t* inbox = nullptr;
+        std::uint8_t* outbox = nullptr;
+    };
+};
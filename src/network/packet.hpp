@@ -0,0 +1,152 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "../event/impl/event_types.hpp"
+
+namespace selaura {
+    // the low ten bits of a packet's header, only the ones something listens to are listed
+    enum class packet_id : std::uint16_t {
+        play_status = 2,
+        disconnect = 5,
+        text = 9,
+        set_time = 10,
+        start_game = 11,
+        move_player = 19,
+        set_health = 42,
+        change_dimension = 61,
+        boss_event = 74,
+        set_title = 88,
+        set_display_objective = 107,
+        set_score = 108,
+        network_stack_latency = 115
+    };
+
+    inline constexpr std::size_t max_packet_ids = 1024;
+
+    enum class packet_direction : std::uint8_t {
+        inbound,
+        outbound
+    };
+
+    // reads straight out of the serialized packet, strings come back as views into it
+    // a read past the end yields zeroes and clears ok, check it once after a batch of reads
+    struct packet_reader {
+        std::span<const std::byte> data;
+        std::size_t offset = 0;
+        bool ok = true;
+
+        template <typename T>
+        T read() {
+            T value{};
+            if (data.size() - offset < sizeof(T)) {
+                ok = false;
+                return value;
+            }
+            std::memcpy(&value, data.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        std::uint64_t read_varuint(std::size_t max_bytes = 10) {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < max_bytes; i++) {
+                if (offset == data.size()) break;
+                const auto byte = static_cast<std::uint8_t>(data[offset++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+                if (!(byte & 0x80)) return value;
+            }
+            ok = false;
+            return 0;
+        }
+
+        // zigzag encoded
+        std::int64_t read_varint(std::size_t max_bytes = 10) {
+            const std::uint64_t raw = read_varuint(max_bytes);
+            return static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+        }
+
+        bool read_bool() {
+            return read<std::uint8_t>() != 0;
+        }
+
+        std::string_view read_string() {
+            const std::uint64_t size = read_varuint(5);
+            if (!ok || data.size() - offset < size) {
+                ok = false;
+                return {};
+            }
+            std::string_view value(reinterpret_cast<const char*>(data.data() + offset), static_cast<std::size_t>(size));
+            offset += static_cast<std::size_t>(size);
+            return value;
+        }
+
+        std::span<const std::byte> remaining() const {
+            return data.subspan(offset);
+        }
+    };
+
+    // what a packet carries, only written for the packets something reads fields of
+    // parse gets a reader at the start of the body and returns nullopt when it is shorter than expected
+    template <packet_id id>
+    struct packet_body;
+
+    template <>
+    struct packet_body<packet_id::set_time> {
+        std::int32_t time;
+
+        static std::optional<packet_body> parse(packet_reader& in) {
+            packet_body out{ static_cast<std::int32_t>(in.read_varint(5)) };
+            return in.ok ? std::optional{ out } : std::nullopt;
+        }
+    };
+
+    template <>
+    struct packet_body<packet_id::set_health> {
+        std::int32_t health;
+
+        static std::optional<packet_body> parse(packet_reader& in) {
+            packet_body out{ static_cast<std::int32_t>(in.read_varint(5)) };
+            return in.ok ? std::optional{ out } : std::nullopt;
+        }
+    };
+
+    // echoed back by the other side, the round trip is the connection's latency
+    template <>
+    struct packet_body<packet_id::network_stack_latency> {
+        std::uint64_t timestamp;
+        bool from_server;
+
+        static std::optional<packet_body> parse(packet_reader& in) {
+            packet_body out{};
+            out.timestamp = in.read<std::uint64_t>();
+            out.from_server = in.read_bool();
+            return in.ok ? std::optional{ out } : std::nullopt;
+        }
+    };
+
+    // one event type per packet id, only dispatched for ids that have a listener and never copied
+    // payload points into the game's buffer and is only valid for the dispatch, cancelling drops the packet
+    template <packet_id id>
+    struct packet_event : public cancellable {
+        packet_direction direction;
+        std::span<const std::byte> payload;
+
+        packet_reader reader() const {
+            return { payload };
+        }
+
+        // nothing is decoded until a listener calls this
+        std::optional<packet_body<id>> parse() const
+            requires requires(packet_reader& in) { packet_body<id>::parse(in); }
+        {
+            auto in = reader();
+            return packet_body<id>::parse(in);
+        }
+    };
+};
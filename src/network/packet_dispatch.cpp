@@ -0,0 +1,50 @@
+#include "packet_dispatch.hpp"
+#include "../instance.hpp"
+
+#include <array>
+#include <utility>
+#include <magic_enum/magic_enum.hpp>
+
+template <>
+struct magic_enum::customize::enum_range<selaura::packet_id> {
+    static constexpr int min = 0;
+    static constexpr int max = static_cast<int>(selaura::max_packet_ids) - 1;
+};
+
+namespace selaura {
+    namespace {
+        using handler_t = bool (*)(packet_direction direction, std::span<const std::byte> payload);
+
+        template <packet_id id>
+        bool dispatch_as(packet_direction direction, std::span<const std::byte> payload) {
+            auto& evm = selaura::get_component<selaura::event_manager>();
+            if (!evm.has_listeners<packet_event<id>>()) return false;
+
+            bool cancelled = false;
+            packet_event<id> ev{ { &cancelled }, direction, payload };
+            evm.dispatch(ev);
+            return cancelled;
+        }
+
+        template <std::size_t... index>
+        constexpr std::array<handler_t, max_packet_ids> make_handlers(std::index_sequence<index...>) {
+            constexpr auto ids = magic_enum::enum_values<packet_id>();
+            std::array<handler_t, max_packet_ids> out{};
+            ((out[static_cast<std::size_t>(ids[index])] = &dispatch_as<ids[index]>), ...);
+            return out;
+        }
+
+        // every listed id has a typed event, the rest stay null and are passed through untouched
+        constexpr auto handlers = make_handlers(std::make_index_sequence<magic_enum::enum_count<packet_id>()>{});
+    }
+
+    bool dispatch_packet(packet_direction direction, std::span<const std::byte> packet) {
+        packet_reader in{ packet };
+        const auto header = in.read_varuint(5);
+        if (!in.ok) return false;
+
+        // the bits above the id name sub-clients for split screen, every one of them shares the listeners
+        const handler_t handler = handlers[header & (max_packet_ids - 1)];
+        return handler && handler(direction, in.remaining());
+    }
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+#include <span>
+
+#include "packet.hpp"
+
+namespace selaura {
+    // packet is the serialized packet, header included, and is only read
+    // ids nothing listens to cost the header read and one table lookup, true when a listener cancelled the packet
+    bool dispatch_packet(packet_direction direction, std::span<const std::byte> packet);
+};
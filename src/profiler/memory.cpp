@@ -0,0 +1,131 @@
+#include "memory.hpp"
+
+#include <cstdlib>
+#include <spdlog/spdlog.h>
+
+namespace selaura::memory {
+    namespace {
+        // one cache line per tag, the renderer and a script allocating at the same time never share one
+        struct alignas(64) counters {
+            std::atomic<std::size_t> live{ 0 };
+            std::atomic<std::size_t> peak{ 0 };
+            std::atomic<bool> over{ false };
+        };
+
+        // constant initialized, allocations made while other statics are still being constructed are counted too
+        std::array<counters, tag_count> tags;
+
+        // sized for a 3 GB phone with the game already holding most of it
+        std::array<std::atomic<std::size_t>, tag_count> budgets{
+            48u << 20,
+            64u << 20,
+            32u << 20,
+            1u << 20,
+            1u << 20
+        };
+
+        struct tracked_resource final : std::pmr::memory_resource {
+            constexpr explicit tracked_resource(tag owner) : owner(owner) {}
+
+            tag owner;
+
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+                void* out = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+                track(this->owner, bytes);
+                return out;
+            }
+
+            void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+                untrack(this->owner, bytes);
+                std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                return this == &other;
+            }
+        };
+
+        // constant initialized and never destroyed, containers in other statics may still hand memory back after exit has run our destructors
+        union immortal_resources {
+            constexpr immortal_resources() : value{
+                tracked_resource{ tag::renderer },
+                tracked_resource{ tag::textures },
+                tracked_resource{ tag::scripting },
+                tracked_resource{ tag::events },
+                tracked_resource{ tag::settings }
+            } {}
+            ~immortal_resources() {}
+
+            std::array<tracked_resource, tag_count> value;
+        };
+
+        constinit immortal_resources resources;
+    }
+
+    void track(tag owner, std::size_t bytes) {
+        auto& counter = tags[static_cast<std::size_t>(owner)];
+        const std::size_t live = counter.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+        std::size_t peak = counter.peak.load(std::memory_order_relaxed);
+        while (live > peak && !counter.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+        const std::size_t budget = budgets[static_cast<std::size_t>(owner)].load(std::memory_order_relaxed);
+        if (budget != 0 && live > budget && !counter.over.exchange(true, std::memory_order_relaxed)) {
+            spdlog::warn("{} is holding {:.1f} MiB, over its {:.1f} MiB budget", tag_names[static_cast<std::size_t>(owner)], live / 1048576.0, budget / 1048576.0);
+        }
+    }
+
+    void untrack(tag owner, std::size_t bytes) {
+        auto& counter = tags[static_cast<std::size_t>(owner)];
+        const std::size_t live = counter.live.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+
+        // hysteresis, a tag hovering right at its budget would otherwise warn on every other allocation
+        if (counter.over.load(std::memory_order_relaxed) && live < budgets[static_cast<std::size_t>(owner)].load(std::memory_order_relaxed) / 8 * 7) {
+            counter.over.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void set_budget(tag owner, std::size_t bytes) {
+        budgets[static_cast<std::size_t>(owner)].store(bytes, std::memory_order_relaxed);
+        tags[static_cast<std::size_t>(owner)].over.store(false, std::memory_order_relaxed);
+    }
+
+    std::size_t get_budget(tag owner) {
+        return budgets[static_cast<std::size_t>(owner)].load(std::memory_order_relaxed);
+    }
+
+    std::array<usage, tag_count> snapshot() {
+        std::array<usage, tag_count> out{};
+        for (std::size_t i = 0; i < tag_count; i++) {
+            out[i] = {
+                tag_names[i],
+                tags[i].live.load(std::memory_order_relaxed),
+                tags[i].peak.load(std::memory_order_relaxed),
+                budgets[i].load(std::memory_order_relaxed)
+            };
+        }
+        return out;
+    }
+
+    std::pmr::memory_resource* resource(tag owner) {
+        return &resources.value[static_cast<std::size_t>(owner)];
+    }
+
+    void* lua_alloc(void*, void* ptr, std::size_t old_size, std::size_t new_size) {
+        // old_size is the block's size only when ptr is set, otherwise it names the type of object lua is creating
+        const std::size_t previous = ptr ? old_size : 0;
+
+        if (new_size == 0) {
+            std::free(ptr);
+            untrack(tag::scripting, previous);
+            return nullptr;
+        }
+
+        void* out = std::realloc(ptr, new_size);
+        if (!out) return nullptr;
+
+        if (new_size > previous) track(tag::scripting, new_size - previous);
+        else untrack(tag::scripting, previous - new_size);
+        return out;
+    }
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+// unlike the profiler this is compiled into release builds, the devices that need it are the ones running release
+namespace selaura::memory {
+    enum class tag : std::uint8_t {
+        renderer,
+        textures,
+        scripting,
+        events,
+        settings,
+        count
+    };
+
+    inline constexpr std::size_t tag_count = static_cast<std::size_t>(tag::count);
+
+    inline constexpr std::array<std::string_view, tag_count> tag_names = {
+        "renderer",
+        "fonts and textures",
+        "scripting",
+        "event listeners",
+        "feature settings"
+    };
+
+    struct usage {
+        std::string_view name;
+        std::size_t live;
+        std::size_t peak;
+        // 0 is no budget
+        std::size_t budget;
+    };
+
+    // two relaxed atomics on the way in, a warning is logged the first time live bytes cross the tag's budget
+    void track(tag owner, std::size_t bytes);
+    void untrack(tag owner, std::size_t bytes);
+
+    // soft, nothing is refused, crossing it only logs, it warns again after dropping back under seven eighths of it
+    void set_budget(tag owner, std::size_t bytes);
+    std::size_t get_budget(tag owner);
+
+    std::array<usage, tag_count> snapshot();
+
+    // new and delete underneath, every byte going through it is counted against owner
+    std::pmr::memory_resource* resource(tag owner);
+
+    // lua_Alloc for a state whose memory is counted as scripting, ud is unused
+    void* lua_alloc(void* ud, void* ptr, std::size_t old_size, std::size_t new_size);
+
+    // for containers whose type is part of an interface, a polymorphic allocator would change it anyway
+    template <typename T, tag owner>
+    struct allocator {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = allocator<U, owner>;
+        };
+
+        allocator() = default;
+        template <typename U>
+        allocator(const allocator<U, owner>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            T* out = std::allocator<T>{}.allocate(n);
+            track(owner, n * sizeof(T));
+            return out;
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept {
+            untrack(owner, n * sizeof(T));
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+
+        template <typename U>
+        bool operator==(const allocator<U, owner>&) const noexcept { return true; }
+    };
+
+    template <typename T, tag owner>
+    using vector = std::vector<T, allocator<T, owner>>;
+
+    // base for heap objects counted against owner, class level new and delete see the full size of whatever derives
+    template <tag owner>
+    struct tracked {
+        static void* operator new(std::size_t bytes) {
+            void* out = ::operator new(bytes);
+            track(owner, bytes);
+            return out;
+        }
+
+        static void operator delete(void* ptr, std::size_t bytes) noexcept {
+            untrack(owner, bytes);
+            ::operator delete(ptr, bytes);
+        }
+    };
+};
@@ -0,0 +1,123 @@
+#include "metrics_export.hpp"
+#include "profiler.hpp"
+#include "../instance.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory_resource>
+#include <string_view>
+
+namespace selaura {
+    namespace {
+        void copy_name(char (&out)[metrics_layout::name_size], std::string_view name) {
+            const std::size_t size = std::min(name.size(), metrics_layout::name_size - 1);
+            std::memcpy(out, name.data(), size);
+            std::memset(out + size, 0, metrics_layout::name_size - size);
+        }
+
+        std::atomic_ref<std::uint32_t> sequence_of(metrics_layout::block& block) {
+            return std::atomic_ref<std::uint32_t>(block.head.sequence);
+        }
+    }
+
+    void metrics_exporter::init() {
+        const auto path = selaura::instance::get()->get_data_folder() / "metrics.shm";
+        if (!this->segment.open(path, sizeof(metrics_layout::block))) {
+            spdlog::warn("Could not map {}, metrics are not exported", path.string());
+            return;
+        }
+
+        // whatever a previous session left behind is stale, the heartbeat included
+        this->block = reinterpret_cast<metrics_layout::block*>(this->segment.bytes().data());
+        std::memset(this->block, 0, sizeof(metrics_layout::block));
+
+        auto& head = this->block->head;
+        head.version = metrics_layout::version;
+        head.header_size = sizeof(metrics_layout::header);
+        head.scopes_offset = offsetof(metrics_layout::block, scopes);
+        head.hooks_offset = offsetof(metrics_layout::block, hooks);
+        head.memory_offset = offsetof(metrics_layout::block, memory);
+        // written last, a collector that sees the magic sees a complete header
+        std::atomic_ref<std::uint32_t>(head.magic).store(metrics_layout::magic, std::memory_order_release);
+
+        selaura::get_component<selaura::event_manager>().subscribe<minecraftgame_update_event>(&metrics_exporter::on_update, this);
+    }
+
+    void metrics_exporter::on_update(minecraftgame_update_event& ev) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now < this->next_check) return;
+        this->next_check = now + interval;
+
+        if (this->consumer_attached(now)) this->publish(now);
+    }
+
+    bool metrics_exporter::consumer_attached(std::chrono::steady_clock::time_point now) {
+        const std::uint64_t heartbeat = std::atomic_ref<std::uint64_t>(this->block->head.consumer_heartbeat).load(std::memory_order_relaxed);
+        if (heartbeat != this->last_heartbeat) {
+            this->last_heartbeat = heartbeat;
+            this->heartbeat_changed = now;
+        }
+
+        return heartbeat != 0 && now - this->heartbeat_changed < consumer_timeout;
+    }
+
+    void metrics_exporter::publish(std::chrono::steady_clock::time_point now) {
+        SELAURA_PROFILE_SCOPE("metrics_exporter::publish");
+        auto& out = *this->block;
+        auto sequence = sequence_of(out);
+
+        // everything the snapshots allocate fits on the stack, nothing reaches the heap once a second
+        std::array<std::byte, 16 * 1024> buffer;
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+
+        const std::uint32_t begin = sequence.load(std::memory_order_relaxed) + 1;
+        sequence.store(begin, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::uint32_t scope_count = 0;
+        std::uint32_t hook_count = 0;
+#if defined(SELAURA_PROFILING)
+        for (const auto& entry : profiler::snapshot(&arena)) {
+            if (scope_count == metrics_layout::max_scopes) break;
+            auto& scope = out.scopes[scope_count++];
+            copy_name(scope.name, entry.name);
+            scope.calls = entry.calls;
+            scope.samples = entry.samples;
+            scope.p50_us = static_cast<float>(entry.p50_us);
+            scope.p99_us = static_cast<float>(entry.p99_us);
+        }
+
+        // empty while hook stats are off, detours skip the clock entirely then
+        if (profiler::hook_stats_enabled.load(std::memory_order_relaxed)) {
+            for (const auto& entry : profiler::hook_snapshot(&arena)) {
+                if (hook_count == metrics_layout::max_hooks) break;
+                auto& hook = out.hooks[hook_count++];
+                copy_name(hook.name, entry.name);
+                hook.calls = entry.calls;
+                hook.before_avg_us = static_cast<float>(entry.before_avg_us);
+                hook.before_p99_us = static_cast<float>(entry.before_p99_us);
+                hook.after_avg_us = static_cast<float>(entry.after_avg_us);
+                hook.after_p99_us = static_cast<float>(entry.after_p99_us);
+            }
+        }
+#endif
+
+        const auto usage = memory::snapshot();
+        for (std::size_t i = 0; i < usage.size(); i++) {
+            auto& tag = out.memory[i];
+            copy_name(tag.name, usage[i].name);
+            tag.live = usage[i].live;
+            tag.peak = usage[i].peak;
+            tag.budget = usage[i].budget;
+        }
+
+        out.head.scope_count = scope_count;
+        out.head.hook_count = hook_count;
+        out.head.memory_count = static_cast<std::uint32_t>(usage.size());
+        out.head.published_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - selaura::instance::current().get_start_time()).count();
+
+        sequence.store(begin + 1, std::memory_order_release);
+    }
+};
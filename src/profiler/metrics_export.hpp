@@ -0,0 +1,103 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "memory.hpp"
+#include "../util/shared_mapping.hpp"
+
+namespace selaura {
+    struct minecraftgame_update_event;
+
+    // data_folder/metrics.shm, laid out exactly like this on every target so a collector can map it and read it in place
+    // everything is little endian and naturally aligned, names are nul padded utf-8
+    namespace metrics_layout {
+        inline constexpr std::uint32_t magic = 0x4D4C4553; // "SELM"
+        inline constexpr std::uint16_t version = 1;
+        inline constexpr std::size_t name_size = 48;
+        inline constexpr std::size_t max_scopes = 64;
+        inline constexpr std::size_t max_hooks = 32;
+        inline constexpr std::size_t max_memory = 8;
+
+        struct scope {
+            char name[name_size];
+            std::uint64_t calls;
+            std::uint32_t samples;
+            float p50_us;
+            float p99_us;
+            std::uint32_t reserved;
+        };
+
+        struct hook {
+            char name[name_size];
+            std::uint64_t calls;
+            float before_avg_us;
+            float before_p99_us;
+            float after_avg_us;
+            float after_p99_us;
+        };
+
+        struct memory_tag {
+            char name[name_size];
+            std::uint64_t live;
+            std::uint64_t peak;
+            std::uint64_t budget;
+        };
+
+        // sequence is a seqlock, odd while a publish is writing, a reader copies and retries until it reads the same even value on both sides
+        // a collector shows it is attached by changing consumer_heartbeat, publishing stops a few seconds after it last changed
+        struct header {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t header_size;
+            std::uint32_t sequence;
+            std::uint32_t scope_count;
+            std::uint32_t hook_count;
+            std::uint32_t memory_count;
+            std::uint32_t scopes_offset;
+            std::uint32_t hooks_offset;
+            std::uint32_t memory_offset;
+            std::uint32_t reserved;
+            // since the instance started
+            std::uint64_t published_ms;
+            std::uint64_t consumer_heartbeat;
+        };
+
+        struct block {
+            header head;
+            scope scopes[max_scopes];
+            hook hooks[max_hooks];
+            memory_tag memory[max_memory];
+        };
+
+        static_assert(std::is_standard_layout_v<block> && std::is_trivially_copyable_v<block>);
+        static_assert(sizeof(scope) == 72 && sizeof(hook) == 72 && sizeof(memory_tag) == 72 && sizeof(header) == 56);
+        static_assert(selaura::memory::tag_count <= max_memory);
+    };
+
+    // publishes the profiler's counters and memory usage once a second, nothing is gathered while no collector is attached
+    // detours and dispatches never see it, it only reads what they already record without locks
+    struct metrics_exporter {
+        metrics_exporter() = default;
+        metrics_exporter(const metrics_exporter&) = delete;
+        metrics_exporter& operator=(const metrics_exporter&) = delete;
+
+        // maps the segment, call once the data folder exists
+        void init();
+
+        static constexpr std::chrono::seconds interval{ 1 };
+        // a collector that stops touching its heartbeat for this long counts as gone
+        static constexpr std::chrono::seconds consumer_timeout{ 5 };
+    private:
+        void on_update(minecraftgame_update_event& ev);
+        bool consumer_attached(std::chrono::steady_clock::time_point now);
+        void publish(std::chrono::steady_clock::time_point now);
+
+        shared_mapping segment;
+        metrics_layout::block* block = nullptr;
+        std::chrono::steady_clock::time_point next_check{};
+        std::uint64_t last_heartbeat = 0;
+        std::chrono::steady_clock::time_point heartbeat_changed{};
+    };
+};
@@ -0,0 +1,206 @@
+#include "profiler.hpp"
+
+#if defined(SELAURA_PROFILING)
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+
+namespace selaura::profiler {
+    namespace {
+        struct scope_data {
+            std::string name;
+            std::atomic<std::uint32_t> head{ 0 };
+            std::array<std::atomic<std::uint32_t>, ring_size> samples{};
+        };
+
+        std::array<scope_data, max_scopes>& scopes() {
+            static std::array<scope_data, max_scopes> storage;
+            return storage;
+        }
+
+        std::atomic<std::uint32_t> scope_count{ 0 };
+        std::mutex register_mutex;
+
+        // one writer per block, relaxed load and store is enough and keeps the hot path free of locked instructions
+        struct hook_counters {
+            std::atomic<std::uint64_t> calls{ 0 };
+            std::atomic<std::uint64_t> before_ns{ 0 };
+            std::atomic<std::uint64_t> after_ns{ 0 };
+            std::array<std::atomic<std::uint64_t>, hook_buckets> before{};
+            std::array<std::atomic<std::uint64_t>, hook_buckets> after{};
+        };
+
+        using thread_hooks = std::array<hook_counters, max_hooks>;
+
+        std::array<std::string, max_hooks> hook_names;
+        std::atomic<std::uint32_t> hook_count{ 0 };
+        // blocks outlive their threads so counts from a finished worker still show up
+        std::vector<std::unique_ptr<thread_hooks>> hook_threads;
+        std::mutex hook_mutex;
+
+        void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        std::size_t hook_bucket(std::uint64_t nanoseconds) {
+            const auto width = static_cast<std::size_t>(std::bit_width(nanoseconds >> 8));
+            return std::min(width, hook_buckets - 1);
+        }
+
+        // upper edge of the bucket holding the 99th percentile, histograms only know ranges
+        double bucket_p99_us(const std::array<std::uint64_t, hook_buckets>& histogram, std::uint64_t total) {
+            if (total == 0) return 0.0;
+
+            const std::uint64_t target = total - total / 100;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < hook_buckets; i++) {
+                seen += histogram[i];
+                if (seen >= target) return static_cast<double>(std::uint64_t{ 256 } << i) / 1000.0;
+            }
+            return static_cast<double>(std::uint64_t{ 256 } << (hook_buckets - 1)) / 1000.0;
+        }
+
+        double percentile_us(std::pmr::vector<std::uint32_t>& values, double fraction) {
+            const auto index = static_cast<std::size_t>(fraction * (values.size() - 1));
+            std::nth_element(values.begin(), values.begin() + index, values.end());
+            return values[index] / 1000.0;
+        }
+    }
+
+    std::uint32_t register_scope(std::string_view name) {
+        std::scoped_lock lock(register_mutex);
+        auto& storage = scopes();
+
+        // slot 0 is reserved for the frame scope so it always shows up first
+        if (scope_count.load(std::memory_order_relaxed) == 0) {
+            storage[frame_scope].name = "frame";
+            scope_count.store(1, std::memory_order_release);
+        }
+
+        const std::uint32_t count = scope_count.load(std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < count; i++) {
+            if (storage[i].name == name) return i;
+        }
+
+        if (count == max_scopes) return frame_scope;
+
+        storage[count].name = name;
+        scope_count.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    void record(std::uint32_t id, std::uint64_t nanoseconds) {
+        auto& scope = scopes()[id];
+        const std::uint32_t slot = scope.head.fetch_add(1, std::memory_order_relaxed) % ring_size;
+        scope.samples[slot].store(static_cast<std::uint32_t>(std::min<std::uint64_t>(nanoseconds, UINT32_MAX)), std::memory_order_relaxed);
+    }
+
+    void mark_frame() {
+        static const std::uint32_t id = register_scope("frame");
+        static std::chrono::steady_clock::time_point last{};
+
+        const auto now = std::chrono::steady_clock::now();
+        if (last.time_since_epoch().count() != 0) {
+            record(id, std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count());
+        }
+        last = now;
+    }
+
+    std::uint32_t register_hook(std::string_view name) {
+        std::scoped_lock lock(hook_mutex);
+
+        const std::uint32_t count = hook_count.load(std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < count; i++) {
+            if (hook_names[i] == name) return i;
+        }
+
+        // past the limit everything shares the last slot rather than writing out of bounds
+        if (count == max_hooks) return max_hooks - 1;
+
+        hook_names[count] = name;
+        hook_count.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    void record_hook(std::uint32_t id, std::uint64_t before_ns, std::uint64_t after_ns) {
+        thread_local thread_hooks* local = [] {
+            std::scoped_lock lock(hook_mutex);
+            return hook_threads.emplace_back(std::make_unique<thread_hooks>()).get();
+        }();
+
+        auto& counters = (*local)[id];
+        bump(counters.calls, 1);
+        bump(counters.before_ns, before_ns);
+        bump(counters.after_ns, after_ns);
+        bump(counters.before[hook_bucket(before_ns)], 1);
+        bump(counters.after[hook_bucket(after_ns)], 1);
+    }
+
+    std::pmr::vector<hook_stats> hook_snapshot(std::pmr::memory_resource* resource) {
+        std::pmr::vector<hook_stats> out(resource);
+
+        std::scoped_lock lock(hook_mutex);
+        const std::uint32_t count = hook_count.load(std::memory_order_acquire);
+        out.reserve(count);
+
+        for (std::uint32_t i = 0; i < count; i++) {
+            std::uint64_t calls = 0, before_ns = 0, after_ns = 0;
+            std::array<std::uint64_t, hook_buckets> before{}, after{};
+
+            for (const auto& thread : hook_threads) {
+                const auto& counters = (*thread)[i];
+                calls += counters.calls.load(std::memory_order_relaxed);
+                before_ns += counters.before_ns.load(std::memory_order_relaxed);
+                after_ns += counters.after_ns.load(std::memory_order_relaxed);
+                for (std::size_t b = 0; b < hook_buckets; b++) {
+                    before[b] += counters.before[b].load(std::memory_order_relaxed);
+                    after[b] += counters.after[b].load(std::memory_order_relaxed);
+                }
+            }
+
+            hook_stats entry{ hook_names[i], calls, 0.0, 0.0, 0.0, 0.0 };
+            if (calls != 0) {
+                entry.before_avg_us = before_ns / 1000.0 / calls;
+                entry.after_avg_us = after_ns / 1000.0 / calls;
+                entry.before_p99_us = bucket_p99_us(before, calls);
+                entry.after_p99_us = bucket_p99_us(after, calls);
+            }
+            out.push_back(entry);
+        }
+
+        return out;
+    }
+
+    std::pmr::vector<stats> snapshot(std::pmr::memory_resource* resource) {
+        std::pmr::vector<stats> out(resource);
+        std::pmr::vector<std::uint32_t> values(resource);
+        auto& storage = scopes();
+
+        const std::uint32_t count = scope_count.load(std::memory_order_acquire);
+        // reserved up front, growth would only leave dead copies behind in an arena
+        out.reserve(count);
+        values.reserve(ring_size);
+
+        for (std::uint32_t i = 0; i < count; i++) {
+            const auto& scope = storage[i];
+            const std::uint32_t calls = scope.head.load(std::memory_order_relaxed);
+            const std::uint32_t recorded = std::min<std::uint32_t>(calls, ring_size);
+
+            values.clear();
+            for (std::uint32_t s = 0; s < recorded; s++) {
+                values.push_back(scope.samples[s].load(std::memory_order_relaxed));
+            }
+
+            stats entry{ scope.name, recorded, 0.0, 0.0, calls };
+            if (!values.empty()) {
+                entry.p50_us = percentile_us(values, 0.50);
+                entry.p99_us = percentile_us(values, 0.99);
+            }
+            out.push_back(entry);
+        }
+
+        return out;
+    }
+};
+#endif
@@ -0,0 +1,199 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory_resource>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// the profiler only exists in development builds, release builds see empty macros and no symbols
+#if !defined(BUILD_TYPE_RELEASE)
+#define SELAURA_PROFILING
+#endif
+
+#define SELAURA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SELAURA_PROFILE_CONCAT(a, b) SELAURA_PROFILE_CONCAT_IMPL(a, b)
+
+// configured with -DSELAURA_TRACING=ON, zones go to a chrome trace_event file in the data folder at unload
+#if defined(SELAURA_TRACING)
+#define SELAURA_TRACE_SCOPE(name) ::selaura::profiler::trace_zone SELAURA_PROFILE_CONCAT(selaura_trace_zone_, __LINE__){ name }
+#else
+#define SELAURA_TRACE_SCOPE(name) ((void)0)
+#endif
+
+#if defined(SELAURA_PROFILING)
+#define SELAURA_PROFILE_SCOPE(name) \
+    static const std::uint32_t SELAURA_PROFILE_CONCAT(selaura_profile_id_, __LINE__) = ::selaura::profiler::register_scope(name); \
+    ::selaura::profiler::scope_timer SELAURA_PROFILE_CONCAT(selaura_profile_scope_, __LINE__){ SELAURA_PROFILE_CONCAT(selaura_profile_id_, __LINE__) }; \
+    SELAURA_TRACE_SCOPE(name)
+#define SELAURA_PROFILE_FRAME() ::selaura::profiler::mark_frame()
+// first line of a detour, SELAURA_PROFILE_ORIGINAL right before calling the original splits our time into before and after
+#define SELAURA_PROFILE_HOOK(name) \
+    static const std::uint32_t selaura_profile_hook_id = ::selaura::profiler::register_hook(name); \
+    ::selaura::profiler::hook_timer selaura_profile_hook{ selaura_profile_hook_id }
+#define SELAURA_PROFILE_ORIGINAL() ::selaura::profiler::original_timer SELAURA_PROFILE_CONCAT(selaura_profile_original_, __LINE__){ selaura_profile_hook }
+#else
+// release builds can still be traced, scopes then only open a zone
+#define SELAURA_PROFILE_SCOPE(name) SELAURA_TRACE_SCOPE(name)
+#define SELAURA_PROFILE_FRAME() ((void)0)
+#define SELAURA_PROFILE_HOOK(name) ((void)0)
+#define SELAURA_PROFILE_ORIGINAL() ((void)0)
+#endif
+
+#if defined(SELAURA_PROFILING) || defined(SELAURA_TRACING)
+namespace selaura::profiler {
+    template <typename T>
+    std::string_view type_name() {
+#if defined(_MSC_VER)
+        constexpr std::string_view signature = __FUNCSIG__;
+        const auto begin = signature.find("type_name<") + 10;
+        return signature.substr(begin, signature.rfind(">(") - begin);
+#else
+        constexpr std::string_view signature = __PRETTY_FUNCTION__;
+        const auto begin = signature.find("T = ") + 4;
+        return signature.substr(begin, signature.find_first_of(";]", begin) - begin);
+#endif
+    }
+};
+#endif
+
+#if defined(SELAURA_TRACING)
+namespace selaura::profiler {
+    // buffered per thread, nothing touches the disk until write_trace
+    void record_trace(std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    // every zone recorded so far as chrome trace_event json, opens in chrome://tracing, perfetto or tracy's importer
+    bool write_trace(const std::filesystem::path& file);
+
+    struct trace_zone {
+        explicit trace_zone(std::string_view name) : name(name), start(std::chrono::steady_clock::now()) {}
+        ~trace_zone() {
+            record_trace(name, start, std::chrono::steady_clock::now());
+        }
+
+        trace_zone(const trace_zone&) = delete;
+        trace_zone& operator=(const trace_zone&) = delete;
+
+    private:
+        std::string_view name;
+        std::chrono::steady_clock::time_point start;
+    };
+};
+#endif
+
+#if defined(SELAURA_PROFILING)
+namespace selaura::profiler {
+    inline constexpr std::size_t max_scopes = 64;
+    inline constexpr std::size_t ring_size = 256;
+    inline constexpr std::uint32_t frame_scope = 0;
+
+    struct stats {
+        std::string_view name;
+        std::uint32_t samples;
+        double p50_us;
+        double p99_us;
+        // every record since startup, for event scopes that is the number of dispatches
+        std::uint32_t calls;
+    };
+
+    // returns a stable id for name, the same name always maps to the same slot
+    std::uint32_t register_scope(std::string_view name);
+
+    // lock free, any thread may record into any scope
+    void record(std::uint32_t id, std::uint64_t nanoseconds);
+
+    // records the time since the previous call into the frame scope
+    void mark_frame();
+
+    // percentiles over the last ring_size samples of every registered scope, frame first
+    std::pmr::vector<stats> snapshot(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    inline constexpr std::size_t max_hooks = 32;
+    // log2 buckets from 256ns, the last one takes everything slower
+    inline constexpr std::size_t hook_buckets = 16;
+
+    struct hook_stats {
+        std::string_view name;
+        std::uint64_t calls;
+        double before_avg_us;
+        double before_p99_us;
+        double after_avg_us;
+        double after_p99_us;
+    };
+
+    // off by default, detours only read the clock while this is set
+    inline std::atomic<bool> hook_stats_enabled{ false };
+
+    std::uint32_t register_hook(std::string_view name);
+
+    // counted per calling thread, nothing is shared until hook_snapshot merges them
+    void record_hook(std::uint32_t id, std::uint64_t before_ns, std::uint64_t after_ns);
+
+    // every registered detour with the counters of all threads merged
+    std::pmr::vector<hook_stats> hook_snapshot(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    struct scope_timer {
+        explicit scope_timer(std::uint32_t id) : id(id), start(std::chrono::steady_clock::now()) {}
+        ~scope_timer() {
+            record(id, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        scope_timer(const scope_timer&) = delete;
+        scope_timer& operator=(const scope_timer&) = delete;
+
+    private:
+        std::uint32_t id;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    struct hook_timer {
+        explicit hook_timer(std::uint32_t id) : id(id), active(hook_stats_enabled.load(std::memory_order_relaxed)) {
+            if (active) start = std::chrono::steady_clock::now();
+        }
+
+        ~hook_timer() {
+            if (!active) return;
+            const auto end = std::chrono::steady_clock::now();
+
+            // a detour that never reached its original spent all of its time before it
+            if (original_start.time_since_epoch().count() == 0) {
+                record_hook(id, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), 0);
+                return;
+            }
+            record_hook(id, std::chrono::duration_cast<std::chrono::nanoseconds>(original_start - start).count(), std::chrono::duration_cast<std::chrono::nanoseconds>(end - original_end).count());
+        }
+
+        hook_timer(const hook_timer&) = delete;
+        hook_timer& operator=(const hook_timer&) = delete;
+
+    private:
+        friend struct original_timer;
+
+        std::uint32_t id;
+        bool active;
+        std::chrono::steady_clock::time_point start{};
+        std::chrono::steady_clock::time_point original_start{};
+        std::chrono::steady_clock::time_point original_end{};
+    };
+
+    // spans the call to the original, which is the game's time rather than ours
+    struct original_timer {
+        explicit original_timer(hook_timer& hook) : hook(hook) {
+            if (hook.active) hook.original_start = std::chrono::steady_clock::now();
+        }
+
+        ~original_timer() {
+            if (hook.active) hook.original_end = std::chrono::steady_clock::now();
+        }
+
+        original_timer(const original_timer&) = delete;
+        original_timer& operator=(const original_timer&) = delete;
+
+    private:
+        hook_timer& hook;
+    };
+};
+#endif
@@ -0,0 +1,88 @@
+#include "profiler.hpp"
+
+#if defined(SELAURA_TRACING)
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+namespace selaura::profiler {
+    namespace {
+        // a few minutes of every zone at 60fps, later zones are dropped instead of growing without bound
+        constexpr std::size_t max_thread_events = 1 << 20;
+
+        struct trace_event {
+            std::string_view name;
+            std::int64_t start_ns;
+            std::int64_t duration_ns;
+        };
+
+        struct trace_thread {
+            std::uint32_t tid;
+            // only ever contended while write_trace copies the buffer out
+            std::mutex mutex;
+            std::vector<trace_event> events;
+        };
+
+        const auto trace_epoch = std::chrono::steady_clock::now();
+        // buffers outlive their threads so zones from a finished worker still end up in the file
+        std::vector<std::unique_ptr<trace_thread>> trace_threads;
+        std::mutex trace_mutex;
+
+        std::int64_t to_ns(std::chrono::steady_clock::duration duration) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        }
+
+        void write_escaped(std::ofstream& out, std::string_view text) {
+            for (const char c : text) {
+                if (c == '"' || c == '\\') out.put('\\');
+                out.put(c);
+            }
+        }
+    }
+
+    void record_trace(std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        thread_local trace_thread* local = [] {
+            std::scoped_lock lock(trace_mutex);
+            auto& thread = trace_threads.emplace_back(std::make_unique<trace_thread>());
+            thread->tid = static_cast<std::uint32_t>(trace_threads.size());
+            thread->events.reserve(4096);
+            return thread.get();
+        }();
+
+        std::scoped_lock lock(local->mutex);
+        if (local->events.size() == max_thread_events) return;
+        local->events.push_back({ name, to_ns(start - trace_epoch), to_ns(end - start) });
+    }
+
+    bool write_trace(const std::filesystem::path& file) {
+        std::ofstream out(file, std::ios::trunc);
+        if (!out) return false;
+
+        std::scoped_lock lock(trace_mutex);
+        std::vector<trace_event> events;
+        bool first = true;
+
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        for (const auto& thread : trace_threads) {
+            {
+                std::scoped_lock thread_lock(thread->mutex);
+                events.assign(thread->events.begin(), thread->events.end());
+            }
+
+            // timestamps are microseconds, the fraction keeps nanosecond zones from collapsing to zero width
+            for (const auto& event : events) {
+                out << (first ? "\n" : ",\n") << "{\"name\":\"";
+                write_escaped(out, event.name);
+                std::format_to(std::ostreambuf_iterator<char>(out), "\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                    thread->tid, event.start_ns / 1000.0, event.duration_ns / 1000.0);
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+
+        return static_cast<bool>(out);
+    }
+};
+#endif
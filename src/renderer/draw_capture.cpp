@@ -0,0 +1,212 @@
+#include "draw_capture.hpp"
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+
+namespace selaura {
+	namespace {
+		constexpr char capture_magic[8] = { 'S', 'L', 'D', 'R', 'A', 'W', '0', '1' };
+
+		// raw copies, a capture is only ever read back by a build of the same client
+		struct capture_header {
+			char magic[8];
+			std::uint32_t vertex_size;
+			std::uint32_t index_size;
+		};
+
+		struct list_header {
+			std::uint64_t id;
+			std::uint32_t commands;
+			std::uint32_t vertices;
+			std::uint32_t indices;
+		};
+
+		template <typename T>
+		void put(std::ofstream& out, const T& value) {
+			out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		template <typename T>
+		void put_span(std::ofstream& out, const T* data, std::size_t count) {
+			out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+		}
+
+		template <typename T>
+		bool get(std::ifstream& in, T& value) {
+			return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+
+		template <typename T>
+		bool get_vector(std::ifstream& in, std::vector<T>& values, std::size_t count) {
+			values.resize(count);
+			return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T))));
+		}
+	}
+
+	bool draw_capture::start(const std::filesystem::path& path, std::uint32_t frames) {
+		this->stop();
+
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+		this->out.open(path, std::ios::binary | std::ios::trunc);
+		if (!this->out) {
+			spdlog::error("Failed to open draw capture {}", path.string());
+			return false;
+		}
+
+		capture_header header{};
+		std::memcpy(header.magic, capture_magic, sizeof(capture_magic));
+		header.vertex_size = sizeof(ImDrawVert);
+		header.index_size = sizeof(ImDrawIdx);
+		put(this->out, header);
+
+		this->textures.clear();
+		this->remaining = frames;
+		spdlog::info("Capturing {} frames of draw data to {}", frames, path.string());
+		return true;
+	}
+
+	void draw_capture::stop() {
+		if (!this->out.is_open()) return;
+
+		this->out.close();
+		this->remaining = 0;
+	}
+
+	void draw_capture::record(const ImDrawData& data, bool replayed) {
+		if (!this->active()) return;
+
+		put(this->out, static_cast<std::uint8_t>(replayed));
+		put(this->out, data.DisplayPos);
+		put(this->out, data.DisplaySize);
+		put(this->out, data.FramebufferScale);
+		put(this->out, static_cast<std::uint32_t>(data.CmdListsCount));
+
+		for (int n = 0; n < data.CmdListsCount; n++) {
+			const ImDrawList* cmd_list = data.CmdLists[n];
+			put(this->out, list_header{
+				reinterpret_cast<std::uint64_t>(cmd_list),
+				static_cast<std::uint32_t>(cmd_list->CmdBuffer.Size),
+				static_cast<std::uint32_t>(cmd_list->VtxBuffer.Size),
+				static_cast<std::uint32_t>(cmd_list->IdxBuffer.Size)
+			});
+
+			for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+				std::uint32_t texture = captured_command::callback;
+				std::uint32_t elem_count = cmd.ElemCount;
+				if (is_material_command(cmd)) {
+					texture = captured_command::material_switch;
+					elem_count = static_cast<std::uint32_t>(material_of(cmd));
+				}
+				else if (!cmd.UserCallback) {
+					texture = this->textures.try_emplace(cmd.TextureId, static_cast<std::uint32_t>(this->textures.size())).first->second;
+				}
+				put(this->out, captured_command{ cmd.ClipRect, texture, cmd.VtxOffset, cmd.IdxOffset, elem_count });
+			}
+
+			put_span(this->out, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size);
+			put_span(this->out, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size);
+		}
+
+		if (--this->remaining == 0) {
+			this->out.close();
+			spdlog::info("Draw capture finished");
+		}
+	}
+
+	std::vector<captured_frame> load_draw_capture(const std::filesystem::path& path) {
+		std::vector<captured_frame> frames;
+
+		std::ifstream in(path, std::ios::binary);
+		capture_header header{};
+		if (!in || !get(in, header) || std::memcmp(header.magic, capture_magic, sizeof(capture_magic)) != 0) {
+			spdlog::error("Not a draw capture: {}", path.string());
+			return frames;
+		}
+		if (header.vertex_size != sizeof(ImDrawVert) || header.index_size != sizeof(ImDrawIdx)) {
+			spdlog::error("Draw capture {} was made with a different vertex layout", path.string());
+			return frames;
+		}
+
+		while (true) {
+			std::uint8_t replayed = 0;
+			if (!get(in, replayed)) break;
+
+			auto& frame = frames.emplace_back();
+			frame.replayed = replayed != 0;
+
+			std::uint32_t list_count = 0;
+			bool ok = get(in, frame.display_pos) && get(in, frame.display_size) && get(in, frame.framebuffer_scale) && get(in, list_count);
+
+			for (std::uint32_t n = 0; ok && n < list_count; n++) {
+				list_header list{};
+				ok = get(in, list);
+				if (!ok) break;
+
+				auto& captured = frame.lists.emplace_back();
+				captured.id = list.id;
+				ok = get_vector(in, captured.commands, list.commands)
+					&& get_vector(in, captured.vertices, list.vertices)
+					&& get_vector(in, captured.indices, list.indices);
+			}
+
+			// a capture cut short by unloading mid frame keeps every complete frame before it
+			if (!ok) {
+				frames.pop_back();
+				break;
+			}
+		}
+
+		return frames;
+	}
+
+	draw_replay::~draw_replay() {
+		for (auto& [id, list] : this->lists) {
+			IM_DELETE(list);
+		}
+	}
+
+	ImDrawData* draw_replay::prepare(const captured_frame& frame, std::span<const ImTextureID> textures) {
+		this->data.Clear();
+		this->data.Valid = true;
+		this->data.DisplayPos = frame.display_pos;
+		this->data.DisplaySize = frame.display_size;
+		this->data.FramebufferScale = frame.framebuffer_scale;
+
+		for (const auto& captured : frame.lists) {
+			auto& list = this->lists[captured.id];
+			if (!list) list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+
+			list->CmdBuffer.resize(static_cast<int>(captured.commands.size()));
+			for (std::size_t i = 0; i < captured.commands.size(); i++) {
+				const auto& command = captured.commands[i];
+				ImDrawCmd& cmd = list->CmdBuffer[static_cast<int>(i)];
+				cmd = ImDrawCmd();
+				cmd.ClipRect = command.clip;
+				cmd.VtxOffset = command.vtx_offset;
+				cmd.IdxOffset = command.idx_offset;
+				cmd.ElemCount = command.elem_count;
+
+				if (command.texture == captured_command::callback) cmd.UserCallback = ImDrawCallback_ResetRenderState;
+				else if (command.texture == captured_command::material_switch) {
+					cmd.UserCallback = &ui_material_callback;
+					cmd.UserCallbackData = reinterpret_cast<void*>(static_cast<std::uintptr_t>(command.elem_count));
+					cmd.ElemCount = 0;
+				}
+				else if (!textures.empty()) cmd.TextureId = textures[command.texture % textures.size()];
+			}
+
+			list->VtxBuffer.resize(static_cast<int>(captured.vertices.size()));
+			std::copy(captured.vertices.begin(), captured.vertices.end(), list->VtxBuffer.Data);
+			list->IdxBuffer.resize(static_cast<int>(captured.indices.size()));
+			std::copy(captured.indices.begin(), captured.indices.end(), list->IdxBuffer.Data);
+
+			this->data.CmdLists.push_back(list);
+		}
+
+		this->data.CmdListsCount = this->data.CmdLists.Size;
+		return &this->data;
+	}
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui.h>
+#include "ui_material.hpp"
+
+namespace selaura {
+	// a command as it was drawn, textures become indices in order of first use and callbacks become ImDrawCallback_ResetRenderState
+	// material switches are kept, with the material in elem_count
+	struct captured_command {
+		static constexpr std::uint32_t callback = ~std::uint32_t{ 0 };
+		static constexpr std::uint32_t material_switch = callback - 1;
+
+		ImVec4 clip;
+		std::uint32_t texture;
+		std::uint32_t vtx_offset;
+		std::uint32_t idx_offset;
+		std::uint32_t elem_count;
+	};
+
+	struct captured_list {
+		// the list's address when it was captured, the same window keeps the same list from frame to frame
+		std::uint64_t id;
+		std::vector<captured_command> commands;
+		std::vector<ImDrawVert> vertices;
+		std::vector<ImDrawIdx> indices;
+	};
+
+	struct captured_frame {
+		// drawn from the previous draw data without an imgui rebuild
+		bool replayed;
+		ImVec2 display_pos;
+		ImVec2 display_size;
+		ImVec2 framebuffer_scale;
+		std::vector<captured_list> lists;
+	};
+
+	// writes the overlay's draw data to a file for a number of frames, for the renderer benchmarks to replay
+	struct draw_capture {
+		// overwrites path, any capture still running is finished first
+		bool start(const std::filesystem::path& path, std::uint32_t frames);
+		void stop();
+
+		bool active() const {
+			return this->remaining != 0;
+		}
+
+		std::uint32_t get_remaining() const {
+			return this->remaining;
+		}
+
+		// render thread, right before the draw data is handed to the renderer
+		void record(const ImDrawData& data, bool replayed);
+	private:
+		std::ofstream out;
+		std::uint32_t remaining = 0;
+		std::unordered_map<ImTextureID, std::uint32_t> textures;
+	};
+
+	// every frame of a capture file, empty if it could not be read or came from a build with another vertex layout
+	std::vector<captured_frame> load_draw_capture(const std::filesystem::path& path);
+
+	// turns captured frames back into draw data, one persistent ImDrawList per captured list so retained lists behave as in game
+	// needs a current imgui context for as long as it lives
+	struct draw_replay {
+		draw_replay() = default;
+		draw_replay(const draw_replay&) = delete;
+		draw_replay& operator=(const draw_replay&) = delete;
+		~draw_replay();
+
+		// textures are indexed by the captured texture index, wrapping around if there are fewer
+		ImDrawData* prepare(const captured_frame& frame, std::span<const ImTextureID> textures);
+	private:
+		std::unordered_map<std::uint64_t, ImDrawList*> lists;
+		ImDrawData data;
+	};
+};
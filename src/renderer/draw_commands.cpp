@@ -0,0 +1,91 @@
+#include "draw_commands.hpp"
+
+#include <atomic>
+
+namespace selaura {
+	namespace {
+		std::atomic<std::uint64_t> next_id{ 1 };
+
+		ImU32 to_color(glm::vec4 color) {
+			return IM_COL32(color.x, color.y, color.z, color.w);
+		}
+	}
+
+	draw_commands::draw_commands() : id(next_id.fetch_add(1, std::memory_order_relaxed)) {}
+
+	void draw_commands::rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float stroke_width, float radius) {
+		this->push({ draw_command::kind::rect, ui_material::plain, 0, pos, size, to_color(color), radius, stroke_width });
+	}
+
+	void draw_commands::filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius, ImDrawFlags flags, ui_material material) {
+		this->push({ draw_command::kind::filled_rect, material, flags, pos, size, to_color(color), radius, 0.f });
+	}
+
+	void draw_commands::shadow(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius, float blur) {
+		this->push({ draw_command::kind::shadow, ui_material::plain, 0, pos, size, to_color(color), radius, blur });
+	}
+
+	draw_commands::thread_buffer& draw_commands::local() {
+		thread_local std::uint64_t owner = 0;
+		thread_local thread_buffer* buffer = nullptr;
+
+		if (owner != this->id) {
+			std::scoped_lock lock(this->buffers_mutex);
+			buffer = this->buffers.emplace_back(std::make_unique<thread_buffer>()).get();
+			owner = this->id;
+		}
+		return *buffer;
+	}
+
+	void draw_commands::push(const draw_command& command) {
+		// only contended for the moment swap takes this thread's commands
+		auto& buffer = this->local();
+		std::scoped_lock lock(buffer.mutex);
+		buffer.back.push_back(command);
+	}
+
+	bool draw_commands::swap() {
+		this->gathered.clear();
+		{
+			std::scoped_lock lock(this->buffers_mutex);
+			for (auto& buffer : this->buffers) {
+				std::scoped_lock buffer_lock(buffer->mutex);
+				this->gathered.insert(this->gathered.end(), buffer->back.begin(), buffer->back.end());
+				buffer->back.clear();
+			}
+		}
+
+		// producers usually redraw the same hud every frame, that shouldn't force the pacer to rebuild
+		if (this->gathered == this->front) return false;
+		this->front.swap(this->gathered);
+		return true;
+	}
+
+	void draw_commands::merge(ImDrawList* list, const shape_atlas& shapes) const {
+		// commands wanting the same material in a row share one switch
+		ui_material current = ui_material::plain;
+		for (const auto& command : this->front) {
+			const ImVec2 min{ command.pos.x, command.pos.y };
+			const ImVec2 max{ command.pos.x + command.size.x, command.pos.y + command.size.y };
+
+			if (command.material != current) {
+				set_ui_material(list, command.material);
+				current = command.material;
+			}
+
+			switch (command.type) {
+				case draw_command::kind::rect:
+					list->AddRect(min, max, command.color, command.radius, command.flags, command.stroke_width);
+					break;
+				case draw_command::kind::filled_rect:
+					shapes.fill_rect(list, min, max, command.color, command.radius, command.flags);
+					break;
+				case draw_command::kind::shadow:
+					shapes.shadow_rect(list, min, max, command.color, command.radius, command.stroke_width);
+					break;
+			}
+		}
+
+		if (current != ui_material::plain) set_ui_material(list, ui_material::plain);
+	}
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <imgui.h>
+#include <glm/glm.hpp>
+#include "shape_atlas.hpp"
+#include "ui_material.hpp"
+
+namespace selaura {
+	struct draw_command {
+		enum class kind : std::uint8_t {
+			rect,
+			filled_rect,
+			shadow
+		};
+
+		kind type;
+		ui_material material;
+		ImDrawFlags flags;
+		glm::vec2 pos;
+		glm::vec2 size;
+		ImU32 color;
+		float radius;
+		// the blur for shadows
+		float stroke_width;
+
+		bool operator==(const draw_command&) const = default;
+	};
+
+	// drawing from any thread, e.g. hud layout computed on the job system
+	// each thread records into its own buffer, once per game frame those are published and the next rebuilt frame draws them
+	struct draw_commands {
+		draw_commands();
+		draw_commands(const draw_commands&) = delete;
+		draw_commands& operator=(const draw_commands&) = delete;
+
+		// colors are 0-255 per channel, like renderer::draw_rect
+		void rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float stroke_width, float radius = 0.f);
+		void filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius = 0.f, ImDrawFlags flags = 0, ui_material material = ui_material::plain);
+		void shadow(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius, float blur);
+
+		// game thread, once per game frame, true when the published commands differ from the last ones
+		bool swap();
+
+		// render thread inside an imgui frame
+		void merge(ImDrawList* list, const shape_atlas& shapes) const;
+	private:
+		struct thread_buffer {
+			std::mutex mutex;
+			std::vector<draw_command> back;
+		};
+
+		thread_buffer& local();
+		void push(const draw_command& command);
+
+		// threads keep a pointer to their buffer, the id tells them apart from a previous instance at the same address
+		std::uint64_t id;
+		std::mutex buffers_mutex;
+		std::vector<std::unique_ptr<thread_buffer>> buffers;
+
+		std::vector<draw_command> front;
+		std::vector<draw_command> gathered;
+	};
+};
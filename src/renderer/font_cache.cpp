@@ -0,0 +1,211 @@
+#include "font_cache.hpp"
+#include "../util/hash.hpp"
+
+#include <imgui_internal.h>
+#include <spdlog/spdlog.h>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <vector>
+
+namespace selaura {
+	namespace {
+		constexpr char cache_magic[8] = { 'S', 'L', 'F', 'O', 'N', 'T', '0', '1' };
+
+		struct cache_header {
+			char magic[8];
+			std::uint64_t key;
+			std::uint32_t glyph_size;
+			std::int32_t width;
+			std::int32_t height;
+			std::uint32_t rects;
+			std::uint32_t fonts;
+		};
+
+		struct baked_font {
+			float ascent;
+			float descent;
+			std::int32_t metrics_total_surface;
+			std::vector<ImFontGlyph> glyphs;
+		};
+
+		struct baked_atlas {
+			std::int32_t width = 0;
+			std::int32_t height = 0;
+			// pack positions of the atlas' custom rects, the white pixel, line textures and whatever else ImFontAtlasBuildInit registers
+			std::vector<ImVec2ih> rects;
+			std::vector<baked_font> fonts;
+			std::vector<unsigned char> pixels;
+		};
+
+		// everything that changes what the builder produces, font sources are hashed by content since the fallback is user supplied
+		std::uint64_t cache_key(const ImFontAtlas& atlas) {
+			std::uint64_t h = hash_bytes(0, IMGUI_VERSION, sizeof(IMGUI_VERSION));
+			h = hash_bytes(h, &atlas.Flags, sizeof(atlas.Flags));
+			h = hash_bytes(h, &atlas.TexDesiredWidth, sizeof(atlas.TexDesiredWidth));
+			h = hash_bytes(h, &atlas.TexGlyphPadding, sizeof(atlas.TexGlyphPadding));
+
+			for (const ImFontConfig& cfg : atlas.ConfigData) {
+				h = hash_bytes(h, cfg.FontData, static_cast<std::size_t>(cfg.FontDataSize));
+
+				const int dst = atlas.Fonts.index_from_ptr(atlas.Fonts.find(cfg.DstFont));
+				const float params[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y,
+					cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply };
+				const int flags[] = { cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, static_cast<int>(cfg.FontBuilderFlags), dst };
+				h = hash_bytes(h, params, sizeof(params));
+				h = hash_bytes(h, flags, sizeof(flags));
+
+				for (const ImWchar* range = cfg.GlyphRanges; range && range[0]; range += 2) {
+					h = hash_bytes(h, range, sizeof(ImWchar) * 2);
+				}
+			}
+
+			// custom rects are packed along with the glyphs, their positions are only valid for the same set of sizes
+			for (const ImFontAtlasCustomRect& rect : atlas.CustomRects) {
+				const unsigned short size[] = { rect.Width, rect.Height };
+				h = hash_bytes(h, size, sizeof(size));
+			}
+			return h;
+		}
+
+		template <typename T>
+		bool get(std::ifstream& in, T* data, std::size_t count = 1) {
+			return static_cast<bool>(in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(sizeof(T) * count)));
+		}
+
+		template <typename T>
+		void put(std::ofstream& out, const T* data, std::size_t count = 1) {
+			out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+		}
+
+		bool load(const std::filesystem::path& path, std::uint64_t key, baked_atlas& out) {
+			std::ifstream in(path, std::ios::binary);
+			if (!in) return false;
+
+			cache_header header{};
+			if (!get(in, &header) || std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0) return false;
+			if (header.key != key || header.glyph_size != sizeof(ImFontGlyph) || header.width <= 0 || header.height <= 0) return false;
+
+			out.width = header.width;
+			out.height = header.height;
+			out.rects.resize(header.rects);
+			if (!get(in, out.rects.data(), out.rects.size())) return false;
+
+			out.fonts.resize(header.fonts);
+			for (auto& font : out.fonts) {
+				std::uint32_t glyphs = 0;
+				if (!get(in, &font.ascent) || !get(in, &font.descent) || !get(in, &font.metrics_total_surface) || !get(in, &glyphs)) return false;
+				font.glyphs.resize(glyphs);
+				if (!get(in, font.glyphs.data(), font.glyphs.size())) return false;
+			}
+
+			out.pixels.resize(static_cast<std::size_t>(out.width) * out.height);
+			return get(in, out.pixels.data(), out.pixels.size());
+		}
+
+		void store(const std::filesystem::path& path, std::uint64_t key, const ImFontAtlas& atlas) {
+			std::error_code ec;
+			std::filesystem::create_directories(path.parent_path(), ec);
+
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			if (!out) {
+				spdlog::error("Failed to write font cache {}", path.string());
+				return;
+			}
+
+			cache_header header{};
+			std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+			header.key = key;
+			header.glyph_size = sizeof(ImFontGlyph);
+			header.width = atlas.TexWidth;
+			header.height = atlas.TexHeight;
+			header.rects = static_cast<std::uint32_t>(atlas.CustomRects.Size);
+			header.fonts = static_cast<std::uint32_t>(atlas.Fonts.Size);
+			put(out, &header);
+
+			for (const auto& rect : atlas.CustomRects) {
+				const ImVec2ih position(static_cast<short>(rect.X), static_cast<short>(rect.Y));
+				put(out, &position);
+			}
+
+			for (const ImFont* font : atlas.Fonts) {
+				const auto glyphs = static_cast<std::uint32_t>(font->Glyphs.Size);
+				put(out, &font->Ascent);
+				put(out, &font->Descent);
+				const std::int32_t surface = font->MetricsTotalSurface;
+				put(out, &surface);
+				put(out, &glyphs);
+				put(out, font->Glyphs.Data, font->Glyphs.Size);
+			}
+
+			put(out, atlas.TexPixelsAlpha8, static_cast<std::size_t>(atlas.TexWidth) * atlas.TexHeight);
+		}
+
+		// ImFontAtlas::Build calls this on the thread building the atlas, the bake it restores is handed over through here
+		const baked_atlas* restoring = nullptr;
+
+		// does what the stb_truetype builder does minus rasterizing and packing, both come from the bake instead
+		bool build_from_bake(ImFontAtlas* atlas) {
+			const baked_atlas& bake = *restoring;
+			ImFontAtlasBuildInit(atlas);
+
+			if (atlas->CustomRects.Size != static_cast<int>(bake.rects.size()) || atlas->Fonts.Size != static_cast<int>(bake.fonts.size())) {
+				return ImFontAtlasGetBuilderForStbTruetype()->FontBuilder_Build(atlas);
+			}
+
+			atlas->TexWidth = bake.width;
+			atlas->TexHeight = bake.height;
+			atlas->TexUvScale = ImVec2(1.0f / bake.width, 1.0f / bake.height);
+			for (int i = 0; i < atlas->CustomRects.Size; i++) {
+				atlas->CustomRects[i].X = static_cast<unsigned short>(bake.rects[i].x);
+				atlas->CustomRects[i].Y = static_cast<unsigned short>(bake.rects[i].y);
+			}
+
+			atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(bake.pixels.size()));
+			std::memcpy(atlas->TexPixelsAlpha8, bake.pixels.data(), bake.pixels.size());
+
+			for (int n = 0; n < atlas->Fonts.Size; n++) {
+				ImFont* font = atlas->Fonts[n];
+				const baked_font& baked = bake.fonts[n];
+
+				// the first config of a font sets it up, merged ones only add to its config count
+				for (ImFontConfig& cfg : atlas->ConfigData) {
+					if (cfg.DstFont == font) ImFontAtlasBuildSetupFont(atlas, font, &cfg, baked.ascent, baked.descent);
+				}
+
+				font->Glyphs.resize(static_cast<int>(baked.glyphs.size()));
+				std::memcpy(font->Glyphs.Data, baked.glyphs.data(), baked.glyphs.size() * sizeof(ImFontGlyph));
+				font->MetricsTotalSurface = baked.metrics_total_surface;
+				font->DirtyLookupTables = true;
+			}
+
+			// draws the custom rects into the pixels, works out their uvs and builds every font's lookup tables
+			ImFontAtlasBuildFinish(atlas);
+			return true;
+		}
+	}
+
+	bool build_font_atlas(ImFontAtlas& atlas, const std::filesystem::path& folder) {
+		const std::uint64_t key = cache_key(atlas);
+		const auto path = folder / std::format("{:016x}.bin", key);
+
+		baked_atlas bake;
+		if (load(path, key, bake)) {
+			static const ImFontBuilderIO cached_builder{ &build_from_bake };
+			const ImFontBuilderIO* previous = atlas.FontBuilderIO;
+
+			restoring = &bake;
+			atlas.FontBuilderIO = &cached_builder;
+			const bool built = atlas.Build();
+			atlas.FontBuilderIO = previous;
+			restoring = nullptr;
+
+			if (built) return true;
+			spdlog::error("Font cache {} could not be restored, rebaking", path.string());
+		}
+
+		if (!atlas.Build()) return false;
+		store(path, key, atlas);
+		return true;
+	}
+};
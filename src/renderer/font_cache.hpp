@@ -0,0 +1,10 @@
+#pragma once
+#include <filesystem>
+
+#include <imgui.h>
+
+namespace selaura {
+	// builds atlas from the fonts already added to it, restoring the baked pixels and glyphs from folder when nothing changed
+	// a miss rasterizes as ImFontAtlas::Build would and writes what it baked for next time
+	bool build_font_atlas(ImFontAtlas& atlas, const std::filesystem::path& folder);
+};
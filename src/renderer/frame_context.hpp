@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include "../sdk/mc/renderer/screen/MinecraftUIRenderContext.hpp"
+#include "../sdk/mc/renderer/Tessellator.hpp"
+
+namespace selaura {
+	// what a frame reads from the game, every field is an offset lookup so it is resolved once per SetupAndRender
+	struct frame_context {
+		MinecraftUIRenderContext* ctx;
+		ClientInstance* client_instance;
+		ScreenContext* screen_context;
+		Tessellator* tessellator;
+		Vec2 screen_size;
+		float gui_scale;
+		// root layer of the view hosting the overlay
+		std::uint64_t layer;
+
+		static frame_context capture(MinecraftUIRenderContext& ctx, std::uint64_t layer) {
+			ClientInstance* client_instance = ctx.getClientInstance();
+			GuiData* gui_data = client_instance->getGuiData();
+			ScreenContext* screen_context = ctx.getScreenContext();
+
+			return {
+				&ctx,
+				client_instance,
+				screen_context,
+				screen_context->getTessellator(),
+				gui_data->getScreenSize(),
+				gui_data->getGuiScale(),
+				layer
+			};
+		}
+	};
+};
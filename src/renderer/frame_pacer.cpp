@@ -0,0 +1,74 @@
+#include "frame_pacer.hpp"
+
+#include <algorithm>
+
+namespace selaura {
+	void frame_pacer::set_refresh_rate(std::uint32_t hz) {
+		this->refresh_rate = hz;
+		this->interval = hz ? clock::duration(std::chrono::microseconds(1000000 / hz)) : clock::duration::zero();
+		this->invalidate();
+	}
+
+	std::uint32_t frame_pacer::get_refresh_rate() const {
+		return this->refresh_rate;
+	}
+
+	void frame_pacer::begin_game_frame() {
+		this->game_frame.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::uint64_t frame_pacer::get_game_frame() const {
+		return this->game_frame.load(std::memory_order_relaxed);
+	}
+
+	bool frame_pacer::claim_view(ScreenView* view) {
+		const std::uint64_t frame = this->game_frame.load(std::memory_order_relaxed);
+
+		// the same view coming back without a game frame in between means update isn't reaching us, treat it as a new frame
+		if (frame == this->claimed_frame && view != this->claimed_view) return false;
+
+		this->claimed_frame = frame;
+		this->claimed_view = view;
+		return true;
+	}
+
+	void frame_pacer::invalidate() {
+		this->dirty.store(true, std::memory_order_relaxed);
+	}
+
+	bool frame_pacer::should_rebuild(float& delta) {
+		const auto now = clock::now();
+		const auto elapsed = now - this->last_rebuild;
+
+		if (!this->dirty.exchange(false, std::memory_order_relaxed) && elapsed < this->interval) {
+			this->replays++;
+			return false;
+		}
+
+		// imgui asserts on a zero delta, and the first frame has nothing to measure against
+		const float seconds = std::chrono::duration<float>(elapsed).count();
+		delta = (this->rebuilds == 0 || seconds <= 0.0f) ? 1.0f / 60.0f : std::min(seconds, 0.25f);
+
+		this->last_rebuild = now;
+		this->rebuilds++;
+		return true;
+	}
+
+	void frame_pacer::set_suspended(bool suspended) {
+		this->suspended.store(suspended, std::memory_order_relaxed);
+		// the last draw data is stale by the time the overlay comes back
+		if (!suspended) this->invalidate();
+	}
+
+	bool frame_pacer::is_suspended() const {
+		return this->suspended.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t frame_pacer::get_rebuilds() const {
+		return this->rebuilds;
+	}
+
+	std::uint64_t frame_pacer::get_replays() const {
+		return this->replays;
+	}
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+struct ScreenView;
+
+namespace selaura {
+	// decides when SetupAndRender rebuilds the imgui frame and when it only replays the last draw data
+	struct frame_pacer {
+		using clock = std::chrono::steady_clock;
+
+		// 0 rebuilds on every frame the overlay is drawn
+		void set_refresh_rate(std::uint32_t hz);
+		std::uint32_t get_refresh_rate() const;
+
+		// called from MinecraftGame::update, once per game frame
+		void begin_game_frame();
+		std::uint64_t get_game_frame() const;
+
+		// false when the overlay was already drawn this game frame by another wanted view
+		bool claim_view(ScreenView* view);
+
+		// input or state changed, the next drawn frame rebuilds regardless of the refresh rate
+		void invalidate();
+
+		// true when this frame has to rebuild, delta is the time since the last rebuild
+		bool should_rebuild(float& delta);
+
+		// while suspended views go straight to the game, nothing of ours is built or drawn
+		void set_suspended(bool suspended);
+		bool is_suspended() const;
+
+		std::uint64_t get_rebuilds() const;
+		std::uint64_t get_replays() const;
+	private:
+		std::atomic<std::uint64_t> game_frame{ 0 };
+		std::atomic<bool> dirty{ true };
+		std::atomic<bool> suspended{ false };
+
+		std::uint32_t refresh_rate = 60;
+		clock::duration interval = std::chrono::microseconds(1000000 / 60);
+		clock::time_point last_rebuild{};
+
+		std::uint64_t claimed_frame = ~std::uint64_t{ 0 };
+		ScreenView* claimed_view = nullptr;
+
+		std::uint64_t rebuilds = 0;
+		std::uint64_t replays = 0;
+	};
+};
@@ -0,0 +1,60 @@
+#include "hud_cache.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace selaura {
+	hud_cache::~hud_cache() {
+		for (auto& entry : this->modules) {
+			IM_DELETE(entry.list);
+		}
+	}
+
+	void hud_cache::draw(const void* owner, std::uint64_t version, const std::function<void(ImDrawList&)>& record) {
+		auto it = std::ranges::find(this->modules, owner, &module::owner);
+		if (it == this->modules.end()) {
+			it = this->modules.insert(this->modules.end(), { owner, IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()) });
+		}
+
+		it->drawn = true;
+		if (it->version == version && it->atlas_generation == this->atlas_generation && !it->list->CmdBuffer.empty()) return;
+
+		ImDrawList& list = *it->list;
+		list._ResetForNewFrame();
+		// same antialiasing as everything else imgui draws this frame
+		list.Flags = ImGui::GetBackgroundDrawList()->Flags;
+		list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+		list.PushClipRectFullScreen();
+		record(list);
+		list._PopUnusedDrawCmd();
+
+		it->version = version;
+		it->atlas_generation = this->atlas_generation;
+		it->fresh = true;
+	}
+
+	void hud_cache::submit(ImDrawData& data) {
+		std::erase_if(this->modules, [](const module& entry) {
+			if (!entry.drawn) IM_DELETE(entry.list);
+			return !entry.drawn;
+		});
+
+		// ImGui::Render puts the background list first, modules go between it and the windows
+		int at = data.CmdListsCount > 0 ? 1 : 0;
+		for (auto& entry : this->modules) {
+			entry.drawn = false;
+			if (entry.list->CmdBuffer.empty()) continue;
+
+			data.CmdLists.insert(data.CmdLists.Data + at++, entry.list);
+			data.TotalVtxCount += entry.list->VtxBuffer.Size;
+			data.TotalIdxCount += entry.list->IdxBuffer.Size;
+		}
+		data.CmdListsCount = data.CmdLists.Size;
+	}
+
+	bool hud_cache::take_unchanged(const ImDrawList* list) {
+		auto it = std::ranges::find(this->modules, list, &module::list);
+		if (it == this->modules.end()) return false;
+		return !std::exchange(it->fresh, false);
+	}
+};
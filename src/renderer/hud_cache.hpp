@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <imgui.h>
+
+namespace selaura {
+	// one retained draw list per hud module, recorded again only when the module's version changes
+	// an unchanged module costs neither its draw code nor the renderer's hashing and conversion, only the copy into the frame's mesh
+	struct hud_cache {
+		hud_cache() = default;
+		hud_cache(const hud_cache&) = delete;
+		hud_cache& operator=(const hud_cache&) = delete;
+		~hud_cache();
+
+		// render thread inside a rebuilt frame, record draws the module into an empty list
+		void draw(const void* owner, std::uint64_t version, const std::function<void(ImDrawList&)>& record);
+
+		// after ImGui::Render, adds this frame's modules right above the background list and forgets modules that stopped drawing
+		void submit(ImDrawData& data);
+
+		// for the renderer, true when list is a module list nothing was recorded into since the renderer last saw it
+		bool take_unchanged(const ImDrawList* list);
+
+		// the font atlas was rebuilt or swapped, recorded lists hold stale uvs and texture ids and are all recorded again
+		void atlas_changed() {
+			this->atlas_generation++;
+		}
+
+		std::size_t size() const {
+			return this->modules.size();
+		}
+	private:
+		struct module {
+			const void* owner;
+			ImDrawList* list;
+			std::uint64_t version = 0;
+			std::uint64_t atlas_generation = 0;
+			bool drawn = false;
+			bool fresh = false;
+		};
+
+		std::vector<module> modules;
+		std::uint64_t atlas_generation = 1;
+	};
+};
@@ -0,0 +1,79 @@
+#include "quad_list.hpp"
+
+#include <cmath>
+
+namespace selaura {
+	void quad_list::clear() {
+		this->recorded.clear();
+		this->runs.clear();
+		this->converted_stale = true;
+	}
+
+	void quad_list::quad(ImTextureID texture, const Tessellator::vertex (&corners)[4]) {
+		if (this->runs.empty() || this->runs.back().texture != texture) {
+			this->runs.push_back({ texture, static_cast<std::uint32_t>(this->recorded.size()), 0 });
+		}
+
+		this->recorded.insert(this->recorded.end(), std::begin(corners), std::end(corners));
+		this->runs.back().count += 4;
+		this->converted_stale = true;
+	}
+
+	// corners go top left, bottom left, bottom right, top right, the reverse of imgui's, like the triangles build_list flips
+	void quad_list::fill(ImVec2 min, ImVec2 max, ImU32 color) {
+		const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+		const ImVec2 white = atlas->TexUvWhitePixel;
+
+		this->quad(atlas->TexID, {
+			{ min.x, min.y, 0.0f, white.x, white.y, color },
+			{ min.x, max.y, 0.0f, white.x, white.y, color },
+			{ max.x, max.y, 0.0f, white.x, white.y, color },
+			{ max.x, min.y, 0.0f, white.x, white.y, color }
+		});
+	}
+
+	void quad_list::line(ImVec2 from, ImVec2 to, ImU32 color, float thickness) {
+		const float dx = to.x - from.x;
+		const float dy = to.y - from.y;
+		const float length = std::sqrt(dx * dx + dy * dy);
+		if (length <= 0.0f) return;
+
+		// half the thickness to either side of the segment
+		const float nx = -dy / length * thickness * 0.5f;
+		const float ny = dx / length * thickness * 0.5f;
+
+		const ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+		const ImVec2 white = atlas->TexUvWhitePixel;
+
+		this->quad(atlas->TexID, {
+			{ from.x - nx, from.y - ny, 0.0f, white.x, white.y, color },
+			{ from.x + nx, from.y + ny, 0.0f, white.x, white.y, color },
+			{ to.x + nx, to.y + ny, 0.0f, white.x, white.y, color },
+			{ to.x - nx, to.y - ny, 0.0f, white.x, white.y, color }
+		});
+	}
+
+	void quad_list::image(ImTextureID texture, ImVec2 min, ImVec2 max, ImVec2 uv_min, ImVec2 uv_max, ImU32 tint) {
+		if (!texture) return;
+
+		this->quad(texture, {
+			{ min.x, min.y, 0.0f, uv_min.x, uv_min.y, tint },
+			{ min.x, max.y, 0.0f, uv_min.x, uv_max.y, tint },
+			{ max.x, max.y, 0.0f, uv_max.x, uv_max.y, tint },
+			{ max.x, min.y, 0.0f, uv_max.x, uv_min.y, tint }
+		});
+	}
+
+	std::span<const Tessellator::vertex> quad_list::vertices(float inv_scale) {
+		if (this->converted_stale || this->converted_scale != inv_scale) {
+			this->converted.resize(this->recorded.size());
+			for (std::size_t i = 0; i < this->recorded.size(); i++) {
+				const auto& vtx = this->recorded[i];
+				this->converted[i] = { vtx.x * inv_scale, vtx.y * inv_scale, 0.0f, vtx.u, vtx.v, vtx.color };
+			}
+			this->converted_scale = inv_scale;
+			this->converted_stale = false;
+		}
+		return this->converted;
+	}
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <imgui.h>
+#include "../sdk/mc/renderer/Tessellator.hpp"
+#include "../profiler/memory.hpp"
+
+namespace selaura {
+	// flat fills, lines and images that skip imgui and reach the tessellator as a QuadList, four vertices a quad instead of six
+	// drawn right after imgui's background list so windows stay on top, and kept between rebuilds like the rest of the draw data
+	// render thread inside a rebuilt frame only, there is no clipping and no rounding, anything fancier goes through imgui
+	struct quad_list {
+		struct run {
+			ImTextureID texture;
+			std::uint32_t first;
+			std::uint32_t count;
+		};
+
+		// the current frame's quads are dropped at the start of every rebuilt frame
+		void clear();
+
+		// sampled from the font atlas' white pixel, so fills batch with each other whatever their color
+		void fill(ImVec2 min, ImVec2 max, ImU32 color);
+		// any direction, thickness in pixels
+		void line(ImVec2 from, ImVec2 to, ImU32 color, float thickness = 1.0f);
+		void image(ImTextureID texture, ImVec2 min, ImVec2 max, ImVec2 uv_min = { 0.0f, 0.0f }, ImVec2 uv_max = { 1.0f, 1.0f }, ImU32 tint = IM_COL32_WHITE);
+
+		bool empty() const {
+			return this->runs.empty();
+		}
+
+		// in gui units, converted once per rebuild or scale change
+		std::span<const Tessellator::vertex> vertices(float inv_scale);
+		std::span<const run> get_runs() const {
+			return this->runs;
+		}
+	private:
+		void quad(ImTextureID texture, const Tessellator::vertex (&corners)[4]);
+
+		// in pixels as recorded, in the game's winding
+		memory::vector<Tessellator::vertex, memory::tag::renderer> recorded;
+		std::vector<run> runs;
+
+		memory::vector<Tessellator::vertex, memory::tag::renderer> converted;
+		float converted_scale = 0.0f;
+		bool converted_stale = true;
+	};
+};
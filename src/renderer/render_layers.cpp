@@ -0,0 +1,46 @@
+#include "render_layers.hpp"
+
+#include <algorithm>
+
+namespace selaura {
+	void render_layers::want(std::span<const layer_hash> layers) {
+		for (layer_hash layer : layers) {
+			auto it = std::ranges::find(this->wanted_layers, layer, &wanted_layer::hash);
+			if (it != this->wanted_layers.end()) it->count++;
+			else this->wanted_layers.push_back({ layer, 1 });
+		}
+	}
+
+	void render_layers::release(std::span<const layer_hash> layers) {
+		for (layer_hash layer : layers) {
+			auto it = std::ranges::find(this->wanted_layers, layer, &wanted_layer::hash);
+			if (it == this->wanted_layers.end()) continue;
+			if (--it->count == 0) this->wanted_layers.erase(it);
+		}
+	}
+
+	bool render_layers::wanted(layer_hash layer) const {
+		return std::ranges::find(this->wanted_layers, layer, &wanted_layer::hash) != this->wanted_layers.end();
+	}
+
+	void render_layers::observe(layer_hash layer, std::uint64_t frame) {
+		auto it = std::ranges::find(this->seen_layers, layer, &seen_layer::hash);
+		if (it != this->seen_layers.end()) it->frame = frame;
+		else this->seen_layers.push_back({ layer, frame });
+	}
+
+	bool render_layers::visible(layer_hash layer, std::uint64_t frame) const {
+		auto it = std::ranges::find(this->seen_layers, layer, &seen_layer::hash);
+		return it != this->seen_layers.end() && it->frame + 1 >= frame;
+	}
+
+	bool render_layers::any_visible(std::span<const layer_hash> layers, std::uint64_t frame) const {
+		return std::ranges::any_of(layers, [&](layer_hash layer) { return this->visible(layer, frame); });
+	}
+
+	bool render_layers::other_visible(std::span<const layer_hash> layers, std::uint64_t frame) const {
+		return std::ranges::any_of(this->seen_layers, [&](const seen_layer& seen) {
+			return seen.frame + 1 >= frame && std::ranges::find(layers, seen.hash) == layers.end();
+		});
+	}
+};
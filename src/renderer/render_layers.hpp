@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace selaura {
+	// root layer names views draw on, hashed the same way UIControl::getLayerHash does
+	using layer_hash = std::uint64_t;
+
+	// which layers anything wants to draw on, and which ones the game actually showed recently
+	struct render_layers {
+		// counted, so screens and features sharing a layer can come and go independently
+		void want(std::span<const layer_hash> layers);
+		void release(std::span<const layer_hash> layers);
+		bool wanted(layer_hash layer) const;
+
+		// a view with this root layer ran during the given game frame
+		void observe(layer_hash layer, std::uint64_t frame);
+
+		// shown this frame or the one before, views of one frame arrive one by one so a frame of slack is kept
+		bool visible(layer_hash layer, std::uint64_t frame) const;
+		bool any_visible(std::span<const layer_hash> layers, std::uint64_t frame) const;
+		// something other than these was shown, e.g. a screen opened on top of the hud
+		bool other_visible(std::span<const layer_hash> layers, std::uint64_t frame) const;
+	private:
+		struct wanted_layer {
+			layer_hash hash;
+			std::uint32_t count;
+		};
+
+		struct seen_layer {
+			layer_hash hash;
+			std::uint64_t frame;
+		};
+
+		std::vector<wanted_layer> wanted_layers;
+		std::vector<seen_layer> seen_layers;
+	};
+};
@@ -1,6 +1,15 @@
 ﻿#include "renderer.hpp"
 
 #include "instance.hpp"
+#include "vertex_convert.hpp"
+#include "font_cache.hpp"
+#include "../util/hash.hpp"
+#include <imgui_internal.h>
+#include "../profiler/profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
 
 int i = 0;
 
@@ -9,7 +18,69 @@ namespace selaura {
 	mce::TexturePtr renderer::texturePtr;
 
 	void renderer::set_textures_unloaded() {
-		this->textures_unloaded = false;
+		this->textures_unloaded = true;
+		this->materials.clear();
+		this->pacer.invalidate();
+	}
+
+	frame_pacer& renderer::get_pacer() {
+		return this->pacer;
+	}
+
+	hud_cache& renderer::get_hud() {
+		return this->hud;
+	}
+
+	quad_list& renderer::get_quads() {
+		return this->quads;
+	}
+
+	draw_commands& renderer::get_commands() {
+		return this->commands;
+	}
+
+	draw_capture& renderer::get_capture() {
+		return this->capture;
+	}
+
+	const shape_atlas& renderer::get_shapes() const {
+		return this->shapes;
+	}
+
+	frame_arena& renderer::get_frame_arena() {
+		return this->arena;
+	}
+
+	render_layers& renderer::get_layers() {
+		return this->layers;
+	}
+
+	bool renderer::layers_visible(std::span<const layer_hash> layers) const {
+		return this->layers.any_visible(layers, this->pacer.get_game_frame());
+	}
+
+	mce::MaterialPtr* renderer::get_material(HashedStringView name) {
+		for (const auto& entry : this->materials) {
+			if (entry.hash == name.hash) return entry.material;
+		}
+
+		auto* material = mce::MaterialPtr::createMaterial(HashedString(name));
+		this->materials.push_back({ name.hash, material });
+		return material;
+	}
+
+	mce::MaterialPtr* renderer::resolve_material(ImTextureID texture, ui_material material) {
+		mce::MaterialPtr* blur = get_material("ui_texture_and_color_blur"_hs);
+
+		// without the resource pack that defines it the text is still drawn, just with soft edges
+		if (this->sdf_enabled && texture == static_cast<ImTextureID>(&this->sdf_texture)) {
+			if (auto* sdf_material = get_material("selaura_ui_sdf_text"_hs)) return sdf_material;
+		}
+
+		if (material == ui_material::blur) return blur;
+		// every vanilla ui pack has it, but a pack that drops it should not cost us everything we draw
+		auto* plain = get_material("ui_texture_and_color"_hs);
+		return plain ? plain : blur;
 	}
 
 	bool renderer::initialize_imgui(MinecraftUIRenderContext& ctx) {
@@ -21,79 +92,466 @@ namespace selaura {
 		return true;
 	}
 
-	void renderer::load_fonts(MinecraftUIRenderContext& ctx) {
+	void renderer::build_atlas() {
 		auto& io = ImGui::GetIO();
 
-		unsigned char* pixels;
-		int width, height, bytesPerPixel;
+		ImFontGlyphRangesBuilder builder;
+		builder.AddRanges(io.Fonts->GetGlyphRangesDefault());
+		for (ImWchar c : this->requested_glyphs) {
+			builder.AddChar(c);
+		}
+
+		// the atlas keeps pointing at these ranges, so they live on the renderer rather than the stack
+		this->glyph_ranges.clear();
+		builder.BuildRanges(&this->glyph_ranges);
+
+		io.Fonts->Clear();
 
 		//io.Fonts->AddFontFromMemoryCompressedTTF(ProductSans::compressed_data, ProductSans::compressed_size, 16.f);
-		//io.Fonts->Build();
+		ImFontConfig config;
+		config.GlyphRanges = this->glyph_ranges.Data;
+		io.Fonts->AddFontDefault(&config);
 
-		io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height, &bytesPerPixel);
+		// the default font is latin only, anything else comes from an optional fallback merged into it
+		// the bundled one is read straight from the mapping, the atlas must not free it
+		ImFontConfig merge;
+		merge.MergeMode = true;
+		merge.GlyphRanges = this->glyph_ranges.Data;
+		auto fallback = selaura::instance::get()->get_data_folder() / "fonts" / "fallback.ttf";
+		if (const auto bundled = selaura::get_component<selaura::asset_bundle>().find("fonts/fallback.ttf"); !bundled.empty()) {
+			merge.FontDataOwnedByAtlas = false;
+			io.Fonts->AddFontFromMemoryTTF(const_cast<std::byte*>(bundled.data()), static_cast<int>(bundled.size()), 13.0f, &merge);
+		}
+		else if (std::filesystem::exists(fallback)) {
+			io.Fonts->AddFontFromFileTTF(fallback.string().c_str(), 13.0f, &merge);
+		}
 
-		mce::Blob blob(pixels, width * height * bytesPerPixel);
-		cg::ImageDescription description(width, height, mce::TextureFormat::R8G8B8A8_UNORM_SRGB, cg::ColorSpace::sRGB, cg::ImageType::Texture2D, 1);
-		cg::ImageBuffer imageBuffer(std::move(blob), std::move(description));
+		this->shapes.add_rects(*io.Fonts);
 
-		auto inst = selaura::instance::get();
+		// restored from the data folder when the fonts, sizes and ranges are what they were last time
+		build_font_atlas(*io.Fonts, selaura::instance::get()->get_data_folder() / "cache" / "fonts");
+		// baked after the cache either way, they are cheap and the cached pixels never need to include them
+		this->shapes.bake(*io.Fonts);
+		this->atlas_pixels.clear();
+		this->atlas_dirty = false;
+		this->hud.atlas_changed();
+	}
+
+	void renderer::load_fonts(MinecraftUIRenderContext& ctx) {
+		auto& io = ImGui::GetIO();
+
+		const bool rebuilt = this->atlas_dirty;
+		if (rebuilt) {
+			build_atlas();
+		}
+
+		// every imgui atlas texel is white with coverage in alpha, so either format converts to the other without loss
+		// switched there and back between two frames leaves nothing to convert
+		const auto wanted = this->alpha8_atlas ? mce::TextureFormat::A8_UNORM : mce::TextureFormat::R8G8B8A8_UNORM_SRGB;
+		const bool converted = std::exchange(this->atlas_format_dirty, false) && !this->atlas_pixels.empty() && this->atlas_format != wanted;
+		if (converted) {
+			if (this->alpha8_atlas) {
+				for (std::size_t i = 0; i < this->atlas_pixels.size() / 4; i++) this->atlas_pixels[i] = this->atlas_pixels[i * 4 + 3];
+				this->atlas_pixels.resize(this->atlas_pixels.size() / 4);
+			}
+			else {
+				const std::size_t count = this->atlas_pixels.size();
+				this->atlas_pixels.resize(count * 4);
+				for (std::size_t i = count; i-- > 0;) {
+					const unsigned char alpha = this->atlas_pixels[i];
+					this->atlas_pixels[i * 4 + 0] = 255;
+					this->atlas_pixels[i * 4 + 1] = 255;
+					this->atlas_pixels[i * 4 + 2] = 255;
+					this->atlas_pixels[i * 4 + 3] = alpha;
+				}
+			}
+			this->atlas_format = wanted;
+		}
+
+		// kept in the final format across texture reloads so a resource pack change is an upload and nothing else
+		if (this->atlas_pixels.empty()) {
+			unsigned char* pixels;
+			int bytesPerPixel;
+			if (this->alpha8_atlas) {
+				io.Fonts->GetTexDataAsAlpha8(&pixels, &this->atlas_width, &this->atlas_height, &bytesPerPixel);
+				this->atlas_format = mce::TextureFormat::A8_UNORM;
+			}
+			else {
+				io.Fonts->GetTexDataAsRGBA32(&pixels, &this->atlas_width, &this->atlas_height, &bytesPerPixel);
+				this->atlas_format = mce::TextureFormat::R8G8B8A8_UNORM_SRGB;
+			}
+
+			this->atlas_pixels.assign(pixels, pixels + static_cast<size_t>(this->atlas_width) * this->atlas_height * bytesPerPixel);
+			// the glyphs stay, imgui's own copies of the pixels are not needed again
+			io.Fonts->ClearTexData();
+		}
+
+		// the game owns the blob from here on and may keep it past a reload, so it gets its own copy rather than ours
+		auto* upload = static_cast<mce::Blob::value_type*>(ImGui::MemAlloc(this->atlas_pixels.size()));
+		std::memcpy(upload, this->atlas_pixels.data(), this->atlas_pixels.size());
+
+		mce::Blob blob(upload, this->atlas_pixels.size(), [](mce::Blob::value_type* data) { ImGui::MemFree(data); });
+		cg::ImageDescription description(this->atlas_width, this->atlas_height, this->atlas_format, cg::ColorSpace::sRGB, cg::ImageType::Texture2D, 1);
+		cg::ImageBuffer imageBuffer(std::move(blob), std::move(description));
 
 		ResourceLocation resource("imgui_font");
 
-		inst->get<selaura::globals>().mc_game->getTextureGroup()->uploadTexture(resource, imageBuffer);
-		this->texturePtr = ctx.getTexture(resource, false);
+		selaura::get_component<selaura::globals>().mc_game->getTextureGroup()->uploadTexture(resource, std::move(imageBuffer));
+		this->texturePtr = ctx.getTexture(resource, rebuilt || converted);
 		io.Fonts->TexID = (void*)&texturePtr;
 
+		if (this->sdf_enabled) this->upload_sdf_font(ctx, rebuilt);
+
+		this->textures_unloaded = false;
+	}
+
+	void renderer::upload_sdf_font(MinecraftUIRenderContext& ctx, bool rebuilt) {
+		const bool baked = this->sdf_dirty;
+		if (baked) {
+			this->sdf_dirty = false;
+			// the same range the bitmap font covers, sized so the fields still hold detail when drawn a few times larger
+			const ImWchar* ranges = ImGui::GetIO().Fonts->GetGlyphRangesDefault();
+			if (!this->sdf.build(ProductSans::compressed_data, ProductSans::compressed_size, 32.0f, ranges)) {
+				this->sdf_enabled = false;
+				return;
+			}
+			this->hud.atlas_changed();
+		}
+
+		const auto& pixels = this->sdf.get_pixels();
+		auto* upload = static_cast<mce::Blob::value_type*>(ImGui::MemAlloc(pixels.size()));
+		std::memcpy(upload, pixels.data(), pixels.size());
+
+		mce::Blob blob(upload, pixels.size(), [](mce::Blob::value_type* data) { ImGui::MemFree(data); });
+		cg::ImageDescription description(this->sdf.get_width(), this->sdf.get_height(), mce::TextureFormat::R8G8B8A8_UNORM, cg::ColorSpace::Linear, cg::ImageType::Texture2D, 1);
+		cg::ImageBuffer imageBuffer(std::move(blob), std::move(description));
+
+		ResourceLocation resource("imgui_sdf_font");
+		selaura::get_component<selaura::globals>().mc_game->getTextureGroup()->uploadTexture(resource, std::move(imageBuffer));
+		this->sdf_texture = ctx.getTexture(resource, baked || rebuilt);
+		this->sdf.get_atlas().TexID = static_cast<ImTextureID>(&this->sdf_texture);
+	}
+
+	void renderer::set_sdf_text(bool enabled) {
+		if (this->sdf_enabled == enabled) return;
+		this->sdf_enabled = enabled;
+		this->sdf_dirty = enabled;
+		// modules drawing sdf text fall back to the bitmap font or pick the sdf one up, either way they record again
+		this->hud.atlas_changed();
+		this->pacer.invalidate();
+	}
+
+	ImFont* renderer::get_sdf_font() const {
+		return this->sdf_enabled && !this->sdf_dirty ? this->sdf.get_font() : nullptr;
+	}
+
+	void renderer::draw_sdf_text(ImDrawList* list, glm::vec2 pos, float size, ImU32 color, std::string_view text) {
+		ImFont* font = this->get_sdf_font();
+		if (!font) return;
+
+		// imgui only draws text with the current texture, the sdf atlas is a texture of its own
+		list->PushTextureID(font->ContainerAtlas->TexID);
+		list->AddText(font, size, { pos.x, pos.y }, color, text.data(), text.data() + text.size());
+		list->PopTextureID();
+	}
+
+	void renderer::set_font_texture(const mce::TexturePtr& texture) {
+		this->texturePtr = texture;
+		ImGui::GetIO().Fonts->TexID = (void*)&texturePtr;
+		this->atlas_dirty = false;
 		this->textures_unloaded = false;
 	}
 
-	void renderer::new_frame(MinecraftUIRenderContext& ctx) {
+	void renderer::request_glyphs(std::string_view text) {
+		// before the first frame there is no atlas yet, everything asked for goes into the first build
+		const ImFont* font = ImGui::GetCurrentContext() && !ImGui::GetIO().Fonts->Fonts.empty() ? ImGui::GetIO().Fonts->Fonts[0] : nullptr;
+
+		const char* it = text.data();
+		const char* end = text.data() + text.size();
+		while (it < end) {
+			unsigned int c = 0;
+			const int length = ImTextCharFromUtf8(&c, it, end);
+			if (length <= 0) break;
+			it += length;
+
+			if (c < 0x80 || c > IM_UNICODE_CODEPOINT_MAX) continue;
+			if (font && font->FindGlyphNoFallback(static_cast<ImWchar>(c))) continue;
+
+			// each codepoint only ever triggers one rebuild, even if no font has it
+			if (this->requested_glyphs.insert(static_cast<ImWchar>(c)).second) {
+				this->atlas_dirty = true;
+			}
+		}
+	}
+
+	void renderer::set_alpha8_atlas(bool enabled) {
+		if (this->alpha8_atlas == enabled) return;
+		this->alpha8_atlas = enabled;
+		this->atlas_format_dirty = true;
+		this->hud.atlas_changed();
+	}
+
+	void renderer::new_frame(const frame_context& frame) {
 		auto& io = ImGui::GetIO();
 
-		Vec2 screenSize = ctx.getClientInstance()->getGuiData()->getScreenSize();
+		const Vec2 screenSize = frame.screen_size;
+		if (io.DisplaySize.x != screenSize.x || io.DisplaySize.y != screenSize.y) {
+			this->pacer.invalidate();
+		}
 		io.DisplaySize.x = screenSize.x;
 		io.DisplaySize.y = screenSize.y;
+
+		// new glyphs were requested last frame, the atlas has to change before NewFrame picks up the fonts
+		if (this->atlas_dirty || this->sdf_dirty || this->atlas_format_dirty) {
+			load_fonts(*frame.ctx);
+			this->pacer.invalidate();
+		}
+	}
+
+	namespace {
+		uint32_t lerp_color(uint32_t a, uint32_t b, float t) {
+			uint32_t out = 0;
+			for (int shift = 0; shift < 32; shift += 8) {
+				const float ca = static_cast<float>((a >> shift) & 0xFF);
+				const float cb = static_cast<float>((b >> shift) & 0xFF);
+				out |= static_cast<uint32_t>(ca + (cb - ca) * t + 0.5f) << shift;
+			}
+			return out;
+		}
+
+		Tessellator::vertex lerp_vertex(const Tessellator::vertex& a, const Tessellator::vertex& b, float t) {
+			return {
+				a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, 0.0f,
+				a.u + (b.u - a.u) * t, a.v + (b.v - a.v) * t,
+				lerp_color(a.color, b.color, t)
+			};
+		}
+
+		// sutherland-hodgman against one edge of the clip rect, a triangle never grows past 7 points
+		template <typename inside_fn, typename cross_fn>
+		size_t clip_edge(const Tessellator::vertex* in, size_t count, Tessellator::vertex* out, inside_fn inside, cross_fn cross) {
+			size_t written = 0;
+			for (size_t i = 0; i < count; i++) {
+				const auto& cur = in[i];
+				const auto& next = in[(i + 1) % count];
+				const bool cur_in = inside(cur);
+				const bool next_in = inside(next);
+
+				if (cur_in) out[written++] = cur;
+				if (cur_in != next_in) out[written++] = lerp_vertex(cur, next, cross(cur, next));
+			}
+			return written;
+		}
+
+		void append_clipped(memory::vector<Tessellator::vertex, memory::tag::renderer>& vertices, const Tessellator::vertex (&tri)[3], const ImVec4& clip) {
+			const float min_x = std::min({ tri[0].x, tri[1].x, tri[2].x });
+			const float max_x = std::max({ tri[0].x, tri[1].x, tri[2].x });
+			const float min_y = std::min({ tri[0].y, tri[1].y, tri[2].y });
+			const float max_y = std::max({ tri[0].y, tri[1].y, tri[2].y });
+
+			if (max_x <= clip.x || min_x >= clip.z || max_y <= clip.y || min_y >= clip.w) return;
+			if (min_x >= clip.x && max_x <= clip.z && min_y >= clip.y && max_y <= clip.w) {
+				vertices.insert(vertices.end(), std::begin(tri), std::end(tri));
+				return;
+			}
+
+			Tessellator::vertex a[8], b[8];
+			size_t count = 3;
+			std::copy(std::begin(tri), std::end(tri), a);
+
+			count = clip_edge(a, count, b, [&](const auto& v) { return v.x >= clip.x; }, [&](const auto& p, const auto& q) { return (clip.x - p.x) / (q.x - p.x); });
+			count = clip_edge(b, count, a, [&](const auto& v) { return v.x <= clip.z; }, [&](const auto& p, const auto& q) { return (clip.z - p.x) / (q.x - p.x); });
+			count = clip_edge(a, count, b, [&](const auto& v) { return v.y >= clip.y; }, [&](const auto& p, const auto& q) { return (clip.y - p.y) / (q.y - p.y); });
+			count = clip_edge(b, count, a, [&](const auto& v) { return v.y <= clip.w; }, [&](const auto& p, const auto& q) { return (clip.w - p.y) / (q.y - p.y); });
+
+			// fan the clipped polygon back into triangles, keeping the winding of the input
+			for (size_t i = 1; i + 1 < count; i++) {
+				vertices.push_back(a[0]);
+				vertices.push_back(a[i]);
+				vertices.push_back(a[i + 1]);
+			}
+		}
+	}
+
+	void renderer::flush_batch(ScreenContext* screen_context, Tessellator* tess, mce::MaterialPtr* material, ImTextureID texture) {
+		if (this->vertices.empty() || !texture) {
+			this->vertices.clear();
+			return;
+		}
+
+		auto* texture_ptr = static_cast<mce::TexturePtr*>(texture);
+		if (texture_ptr->mClientTexture) {
+			tess->begin(mce::PrimitiveMode::TriangleList, static_cast<int>(this->vertices.size()));
+			tess->vertices(this->vertices);
+			MeshHelpers::renderMeshImmediately(screen_context, tess, material, *texture_ptr->mClientTexture);
+		}
+
+		this->vertices.clear();
+	}
+
+	void renderer::draw_quads(ScreenContext* screen_context, Tessellator* tess, float inv_scale) {
+		const auto vertices = this->quads.vertices(inv_scale);
+
+		// one mesh per texture run, nothing here goes through imgui's index buffer or the clipper
+		for (const auto& run : this->quads.get_runs()) {
+			auto* texture_ptr = static_cast<mce::TexturePtr*>(run.texture);
+			if (!texture_ptr->mClientTexture) continue;
+
+			tess->begin(mce::PrimitiveMode::QuadList, static_cast<int>(run.count));
+			tess->vertices(vertices.subspan(run.first, run.count));
+			MeshHelpers::renderMeshImmediately(screen_context, tess, resolve_material(run.texture, ui_material::plain), *texture_ptr->mClientTexture);
+		}
 	}
 
-	void renderer::render_draw_data(ImDrawData* data, MinecraftUIRenderContext& ctx) {
+	uint64_t renderer::hash_list(const ImDrawList* cmd_list, float inv_scale) {
+		uint64_t h = hash_bytes(0, &inv_scale, sizeof(inv_scale));
+		h = hash_bytes(h, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.size_in_bytes());
+		h = hash_bytes(h, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.size_in_bytes());
+
+		for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+			if (is_material_command(cmd)) {
+				const ui_material material = material_of(cmd);
+				h = hash_bytes(h, &material, sizeof(material));
+				continue;
+			}
+
+			// callbacks can do anything, so lists that carry them are rebuilt every frame
+			if (cmd.UserCallback) return 0;
+
+			h = hash_bytes(h, &cmd.ClipRect, sizeof(cmd.ClipRect));
+			h = hash_bytes(h, &cmd.TextureId, sizeof(cmd.TextureId));
+			h = hash_bytes(h, &cmd.VtxOffset, sizeof(cmd.VtxOffset));
+			h = hash_bytes(h, &cmd.IdxOffset, sizeof(cmd.IdxOffset));
+			h = hash_bytes(h, &cmd.ElemCount, sizeof(cmd.ElemCount));
+		}
+
+		return h | 1;
+	}
+
+	void renderer::build_list(const ImDrawList* cmd_list, float inv_scale, retained_list& out) {
+		out.vertices.clear();
+		out.batches.clear();
+
+		// convert the shared vertex buffer once, commands then only gather by index
+		this->converted.resize(cmd_list->VtxBuffer.Size);
+		convert_vertices({ cmd_list->VtxBuffer.Data, static_cast<size_t>(cmd_list->VtxBuffer.Size) }, inv_scale, this->converted.data());
+
+		for (const ImDrawCmd& cmd : cmd_list->CmdBuffer) {
+			if (is_material_command(cmd)) {
+				out.batches.push_back({ nullptr, nullptr, static_cast<uint32_t>(out.vertices.size()), 0, true, material_of(cmd) });
+				continue;
+			}
+
+			if (cmd.UserCallback) {
+				out.batches.push_back({ nullptr, &cmd, static_cast<uint32_t>(out.vertices.size()), 0 });
+				continue;
+			}
+
+			if (cmd.ClipRect.z <= cmd.ClipRect.x || cmd.ClipRect.w <= cmd.ClipRect.y) continue;
+
+			if (out.batches.empty() || out.batches.back().callback || out.batches.back().switches_material || out.batches.back().texture != cmd.TextureId) {
+				out.batches.push_back({ cmd.TextureId, nullptr, static_cast<uint32_t>(out.vertices.size()), 0 });
+			}
+
+			const Tessellator::vertex* vtx_buffer = this->converted.data() + cmd.VtxOffset;
+			const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data + cmd.IdxOffset;
+			const ImVec4 clip = { cmd.ClipRect.x * inv_scale, cmd.ClipRect.y * inv_scale, cmd.ClipRect.z * inv_scale, cmd.ClipRect.w * inv_scale };
+
+			for (unsigned int i = 0; i < cmd.ElemCount; i += 3) {
+				Tessellator::vertex tri[3];
+				for (unsigned int corner = 0; corner < 3; corner++) {
+					tri[corner] = vtx_buffer[idx_buffer[i + 2 - corner]];
+				}
+				append_clipped(out.vertices, tri, clip);
+			}
+
+			out.batches.back().count = static_cast<uint32_t>(out.vertices.size()) - out.batches.back().first;
+		}
+	}
+
+	void renderer::render_draw_data(ImDrawData* data, const frame_context& frame, bool replay) {
+		SELAURA_PROFILE_SCOPE("renderer::render_draw_data");
 		if (this->textures_unloaded) {
-			load_fonts(ctx);
+			load_fonts(*frame.ctx);
 		}
 
-		float scale = ctx.getClientInstance()->getGuiData()->getGuiScale();
-		ScreenContext* screen_context = ctx.getScreenContext();
-		Tessellator* tess = screen_context->getTessellator();
+		const float inv_scale = 1.0f / frame.gui_scale;
+		ScreenContext* screen_context = frame.screen_context;
+		Tessellator* tess = frame.tessellator;
 
-		for (int n = 0; n < data->CmdListsCount; n++) {
-			ImDrawList* cmd_list = data->CmdLists[n];
-			
-			for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
-				const ImDrawCmd& cmd = cmd_list->CmdBuffer[cmd_i];
-				const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
-				const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
+		// clipping is baked into the vertices, so consecutive commands only split when the texture or material changes
+		ImTextureID batch_texture = nullptr;
+		ui_material batch_material = ui_material::plain;
+		this->vertices.clear();
+		this->frame_index++;
 
-				tess->begin(mce::PrimitiveMode::TriangleList, 0);
+		auto flush = [&] {
+			flush_batch(screen_context, tess, resolve_material(batch_texture, batch_material), batch_texture);
+		};
+		auto switch_material = [&](ui_material material) {
+			if (material == batch_material) return;
+			flush();
+			batch_material = material;
+		};
 
-				for (unsigned int i = 0; i < cmd.ElemCount; i += 3) {
-					const ImDrawVert& v0 = vtx_buffer[idx_buffer[i + 2]];
-					const ImDrawVert& v1 = vtx_buffer[idx_buffer[i + 1]];
-					const ImDrawVert& v2 = vtx_buffer[idx_buffer[i + 0]];
+		// quads go between the background list and whatever comes after it
+		const ImDrawList* background = ImGui::GetBackgroundDrawList();
+		bool quads_drawn = this->quads.empty();
+		auto emit_quads = [&] {
+			flush();
+			this->draw_quads(screen_context, tess, inv_scale);
+			quads_drawn = true;
+		};
 
-					tess->color(v0.col);
-					tess->vertexUV(v0.pos.x / scale, v0.pos.y / scale, 0.0f, v0.uv.x, v0.uv.y);
+		for (int n = 0; n < data->CmdListsCount; n++) {
+			const ImDrawList* cmd_list = data->CmdLists[n];
+			if (!quads_drawn && cmd_list != background) emit_quads();
 
-					tess->color(v1.col);
-					tess->vertexUV(v1.pos.x / scale, v1.pos.y / scale, 0.0f, v1.uv.x, v1.uv.y);
+			// unchanged lists replay the vertices converted on a previous frame
+			auto& retained = this->retained_lists[cmd_list];
+			const bool unchanged = (this->hud.take_unchanged(cmd_list) || replay) && retained.inv_scale == inv_scale;
+			const uint64_t hash = unchanged && retained.hash ? retained.hash : hash_list(cmd_list, inv_scale);
+			if (hash == 0 || hash != retained.hash) {
+				build_list(cmd_list, inv_scale, retained);
+				retained.hash = hash;
+				retained.inv_scale = inv_scale;
+			}
+			retained.last_frame = this->frame_index;
+			switch_material(ui_material::plain);
+
+			for (const auto& batch : retained.batches) {
+				if (batch.switches_material) {
+					switch_material(batch.material);
+					continue;
+				}
 
-					tess->color(v2.col);
-					tess->vertexUV(v2.pos.x / scale, v2.pos.y / scale, 0.0f, v2.uv.x, v2.uv.y);
+				if (batch.callback) {
+					flush();
+					if (batch.callback->UserCallback != ImDrawCallback_ResetRenderState) {
+						batch.callback->UserCallback(cmd_list, batch.callback);
+					}
+					else {
+						batch_material = ui_material::plain;
+					}
+					continue;
 				}
 
-				
-				mce::MaterialPtr* material = mce::MaterialPtr::createMaterial(HashedString("ui_texture_and_color_blur"));
-				MeshHelpers::renderMeshImmediately(screen_context, tess, material, *texturePtr.mClientTexture);
+				if (batch.texture != batch_texture) {
+					flush();
+					batch_texture = batch.texture;
+				}
+
+				const auto* first = retained.vertices.data() + batch.first;
+				this->vertices.insert(this->vertices.end(), first, first + batch.count);
 			}
 		}
+
+		flush();
+		if (!quads_drawn) emit_quads();
+
+		std::erase_if(this->retained_lists, [this](const auto& entry) {
+			return entry.second.last_frame != this->frame_index;
+		});
 	}
 
 	void renderer::draw_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float stroke_width, float radius) {
@@ -104,11 +562,23 @@ namespace selaura {
 		draw_rect(pos, size, glm::vec4(color, 1.0f), stroke_width, radius);
 	}
 
-	void renderer::draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius, ImDrawFlags flags) {
+	void renderer::draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius, ImDrawFlags flags, ui_material material) {
 		auto drawlist = ImGui::GetBackgroundDrawList();
-		drawlist->AddRectFilled({ pos.x, pos.y }, { pos.x + size.x, pos.y + size.y }, IM_COL32(color.x, color.y, color.z, color.w), radius, flags);
+		if (material != ui_material::plain) set_ui_material(drawlist, material);
+		this->shapes.fill_rect(drawlist, { pos.x, pos.y }, { pos.x + size.x, pos.y + size.y }, IM_COL32(color.x, color.y, color.z, color.w), radius, flags);
+		if (material != ui_material::plain) set_ui_material(drawlist, ui_material::plain);
+	}
+	void renderer::draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec3 color, float radius, ImDrawFlags flags, ui_material material) {
+		draw_filled_rect(pos, size, glm::vec4(color, 1.0f), radius, flags, material);
 	}
-	void renderer::draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec3 color, float radius, ImDrawFlags flags) {
-		draw_filled_rect(pos, size, glm::vec4(color, 1.0f), radius);
+
+	void renderer::draw_region(glm::vec2 pos, glm::vec2 size, const atlas_region& region, ImU32 tint) {
+		if (!region.ready()) return;
+		ImGui::GetBackgroundDrawList()->AddImage(region.texture, { pos.x, pos.y }, { pos.x + size.x, pos.y + size.y }, region.uv_min, region.uv_max, tint);
+	}
+
+	void renderer::draw_shadow(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius, float blur) {
+		auto drawlist = ImGui::GetBackgroundDrawList();
+		this->shapes.shadow_rect(drawlist, { pos.x, pos.y }, { pos.x + size.x, pos.y + size.y }, IM_COL32(color.x, color.y, color.z, color.w), radius, blur);
 	}
 }
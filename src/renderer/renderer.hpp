@@ -10,26 +10,164 @@
 #include "../sdk/mc/deps/minecraftrenderer/renderer/BedrockTexture.hpp"
 #include "../sdk/mc/renderer/TextureGroup.hpp"
 #include <spdlog/spdlog.h>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <glm/glm.hpp>
+#include <libhat/fixed_string.hpp>
 #include "font.hpp"
+#include "sdf_font.hpp"
+#include "shape_atlas.hpp"
+#include "ui_material.hpp"
+#include "texture_atlas.hpp"
+#include "hud_cache.hpp"
+#include "quad_list.hpp"
+#include "frame_context.hpp"
+#include "frame_pacer.hpp"
+#include "render_layers.hpp"
+#include "draw_commands.hpp"
+#include "draw_capture.hpp"
+#include "../util/frame_arena.hpp"
+#include "../profiler/memory.hpp"
 
 namespace selaura {
 	struct renderer {
+		renderer() = default;
+		renderer(const renderer&) = delete;
+		renderer& operator=(const renderer&) = delete;
+
 		void set_textures_unloaded();
 
 		bool initialize_imgui(MinecraftUIRenderContext& ctx);
 		void load_fonts(MinecraftUIRenderContext& ctx);
-		void new_frame(MinecraftUIRenderContext& ctx);
-		void render_draw_data(ImDrawData* data, MinecraftUIRenderContext& ctx);
+		// adopts an atlas texture uploaded elsewhere, selaura_bench has no texture group for load_fonts to upload to
+		void set_font_texture(const mce::TexturePtr& texture);
+
+		// codepoints the atlas is missing are queued and rasterized before the next frame
+		void request_glyphs(std::string_view text);
+
+		// A8 is a quarter of the size, but the ui material reads the texture's rgb, which is black for alpha-only formats
+		// switching converts the kept pixels and uploads them again, the glyphs are not rebuilt
+		void set_alpha8_atlas(bool enabled);
+
+		// one distance field atlas for text at any size, drawn with the sdf material from the client's resource pack
+		void set_sdf_text(bool enabled);
+		// null until sdf text is enabled and the first frame has baked it
+		ImFont* get_sdf_font() const;
+		// render thread inside a frame only, size is in pixels and any size is as sharp as the material allows
+		void draw_sdf_text(ImDrawList* list, glm::vec2 pos, float size, ImU32 color, std::string_view text);
+		void new_frame(const frame_context& frame);
+		// replayed draw data is known to be unchanged, so its lists skip hashing
+		void render_draw_data(ImDrawData* data, const frame_context& frame, bool replay = false);
+
+		frame_pacer& get_pacer();
+		// thread-safe counterpart of draw_rect and draw_filled_rect, drawn a frame later
+		draw_commands& get_commands();
+		render_layers& get_layers();
+		// hud modules drawn through feature::draw_hud, added to the draw data of every rebuilt frame
+		hud_cache& get_hud();
+		// dumps the draw data of the next frames to a file, replayed by selaura_bench
+		draw_capture& get_capture();
+		// flat rects, lines and images straight to the tessellator as quads, cleared at the start of every rebuilt frame
+		quad_list& get_quads();
+		// rounded rects and shadows as nine quads on the font atlas, falls back to imgui's tessellation until the atlas is baked
+		const shape_atlas& get_shapes() const;
+		// transient allocations for the current SetupAndRender, everything in it is gone once the frame is drawn
+		frame_arena& get_frame_arena();
+		// any of these was on screen this game frame or the last one
+		bool layers_visible(std::span<const layer_hash> layers) const;
 
+		// render thread inside a frame only, other threads go through get_commands
 		void draw_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float stroke_width, float radius = 0.f);
 		void draw_rect(glm::vec2 pos, glm::vec2 size, glm::vec3 color, float stroke_width, float radius = 0.f);
 
-		void draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius = 0.f, ImDrawFlags flags = 0);
-		void draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec3 color, float radius = 0.f, ImDrawFlags flags = 0);
+		// blur is for panels that want the frosted look, it splits the batch and costs a lot more to draw
+		void draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius = 0.f, ImDrawFlags flags = 0, ui_material material = ui_material::plain);
+		void draw_filled_rect(glm::vec2 pos, glm::vec2 size, glm::vec3 color, float radius = 0.f, ImDrawFlags flags = 0, ui_material material = ui_material::plain);
+
+		// icons from the same texture_atlas page batch together, nothing is drawn until the region is ready
+		void draw_region(glm::vec2 pos, glm::vec2 size, const atlas_region& region, ImU32 tint = IM_COL32_WHITE);
+
+		// blur pixels of falloff around the rect, draw it before the rect it belongs to
+		void draw_shadow(glm::vec2 pos, glm::vec2 size, glm::vec4 color, float radius, float blur);
+
+		// the batch texture's material for the given ui_material, sdf text keeps its own either way
+		mce::MaterialPtr* resolve_material(ImTextureID texture, ui_material material);
+
+		// materials are looked up once per name and dropped whenever the game unloads its textures
+		// takes "name"_hs, the engine's owning HashedString is only built the first time a name is seen
+		mce::MaterialPtr* get_material(HashedStringView name);
 	private:
+		struct cached_material {
+			uint64_t hash;
+			mce::MaterialPtr* material;
+		};
+
+		void flush_batch(ScreenContext* screen_context, Tessellator* tess, mce::MaterialPtr* material, ImTextureID texture);
+		void draw_quads(ScreenContext* screen_context, Tessellator* tess, float inv_scale);
+
+		struct retained_batch {
+			ImTextureID texture;
+			const ImDrawCmd* callback;
+			uint32_t first;
+			uint32_t count;
+			// a set_ui_material command, kept by value so lists carrying them can still be replayed
+			bool switches_material = false;
+			ui_material material = ui_material::plain;
+		};
+
+		struct retained_list {
+			uint64_t hash = 0;
+			// hud module lists skip hashing, their vertices are only good for the scale they were converted at
+			float inv_scale = 0.0f;
+			uint64_t last_frame = 0;
+			memory::vector<Tessellator::vertex, memory::tag::renderer> vertices;
+			std::vector<retained_batch> batches;
+		};
+
+		static uint64_t hash_list(const ImDrawList* cmd_list, float inv_scale);
+		void build_list(const ImDrawList* cmd_list, float inv_scale, retained_list& out);
+
+		std::unordered_map<const ImDrawList*, retained_list> retained_lists;
+		frame_pacer pacer;
+		render_layers layers;
+		hud_cache hud;
+		quad_list quads;
+		draw_commands commands;
+		draw_capture capture;
+		frame_arena arena{ 64 * 1024, memory::resource(memory::tag::renderer) };
+		uint64_t frame_index = 0;
+		std::vector<cached_material> materials;
+
+		void build_atlas();
+
 		static mce::TexturePtr texturePtr;
 		bool textures_unloaded = true;
+
+		bool atlas_dirty = true;
+		bool alpha8_atlas = false;
+		// the kept pixels are in the other format, they are converted and uploaded before the next frame
+		bool atlas_format_dirty = false;
+		std::unordered_set<ImWchar> requested_glyphs;
+		ImVector<ImWchar> glyph_ranges;
+		void upload_sdf_font(MinecraftUIRenderContext& ctx, bool rebuilt);
+
+		shape_atlas shapes;
+		sdf_font sdf;
+		mce::TexturePtr sdf_texture;
+		bool sdf_enabled = false;
+		bool sdf_dirty = false;
+
+		// the baked atlas in the format it is uploaded in, empty until the first upload after a rebuild
+		memory::vector<unsigned char, memory::tag::textures> atlas_pixels;
+		int atlas_width = 0;
+		int atlas_height = 0;
+		mce::TextureFormat atlas_format = mce::TextureFormat::R8G8B8A8_UNORM_SRGB;
+
+		memory::vector<Tessellator::vertex, memory::tag::renderer> vertices;
+		memory::vector<Tessellator::vertex, memory::tag::renderer> converted;
 	};
 };
\ No newline at end of file
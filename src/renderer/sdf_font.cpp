@@ -0,0 +1,107 @@
+#include "sdf_font.hpp"
+
+#include <imgui_internal.h>
+#include <spdlog/spdlog.h>
+#include <cstring>
+
+// imgui keeps its own copy static, this one is private to this file as well
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb_truetype.h>
+
+namespace selaura {
+	namespace {
+		// texels of distance around each glyph, enough for outlines and soft shadows a few pixels wide at the base size
+		constexpr int padding = 6;
+		constexpr unsigned char on_edge = 128;
+		constexpr float distance_scale = static_cast<float>(on_edge) / padding;
+
+		// only the space is rasterized the normal way, every other glyph is a custom rect filled with its field
+		constexpr ImWchar space_range[] = { 0x20, 0x20, 0 };
+
+		struct pending_glyph {
+			int rect;
+			unsigned char* field;
+			int width;
+			int height;
+		};
+	}
+
+	sdf_font::sdf_font() : atlas(IM_NEW(ImFontAtlas)()) {}
+
+	sdf_font::~sdf_font() {
+		IM_DELETE(this->atlas);
+	}
+
+	bool sdf_font::build(const void* compressed_ttf, int compressed_size, float size, const ImWchar* ranges) {
+		this->atlas->Clear();
+		this->pixels.clear();
+		this->font = nullptr;
+
+		ImFontConfig config;
+		config.GlyphRanges = space_range;
+		ImFont* target = this->atlas->AddFontFromMemoryCompressedTTF(compressed_ttf, compressed_size, size, &config);
+		if (!target) return false;
+
+		// the atlas decompressed the font for the space glyph, the fields are sampled from the same copy
+		const auto* ttf = static_cast<const unsigned char*>(this->atlas->ConfigData.back().FontData);
+		stbtt_fontinfo info;
+		if (!stbtt_InitFont(&info, ttf, stbtt_GetFontOffsetForIndex(ttf, 0))) {
+			spdlog::error("Failed to read the sdf font");
+			return false;
+		}
+
+		const float scale = stbtt_ScaleForPixelHeight(&info, size);
+		int ascent, descent, line_gap;
+		stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
+		// imgui places glyphs from the rounded ascent, the fields follow it so both kinds of glyph share a baseline
+		const float baseline = IM_ROUND(ImFloor(ascent * scale + 1.0f));
+
+		std::vector<pending_glyph> pending;
+		for (const ImWchar* range = ranges; range[0]; range += 2) {
+			for (unsigned int c = range[0]; c <= range[1]; c++) {
+				if (c == ' ' || stbtt_FindGlyphIndex(&info, static_cast<int>(c)) == 0) continue;
+
+				int field_width, field_height, x_off, y_off;
+				unsigned char* field = stbtt_GetCodepointSDF(&info, scale, static_cast<int>(c), padding, on_edge, distance_scale, &field_width, &field_height, &x_off, &y_off);
+				if (!field) continue;
+
+				int advance, bearing;
+				stbtt_GetCodepointHMetrics(&info, static_cast<int>(c), &advance, &bearing);
+				const int rect = this->atlas->AddCustomRectFontGlyph(target, static_cast<ImWchar>(c), field_width, field_height, advance * scale, ImVec2(static_cast<float>(x_off), y_off + baseline));
+				pending.push_back({ rect, field, field_width, field_height });
+			}
+		}
+
+		const bool built = this->atlas->Build();
+
+		unsigned char* alpha = nullptr;
+		int bytes_per_pixel;
+		if (built) this->atlas->GetTexDataAsAlpha8(&alpha, &this->width, &this->height, &bytes_per_pixel);
+
+		for (const auto& glyph : pending) {
+			if (alpha) {
+				const ImFontAtlasCustomRect* rect = this->atlas->GetCustomRectByIndex(glyph.rect);
+				for (int y = 0; y < glyph.height; y++) {
+					std::memcpy(alpha + (rect->Y + y) * this->width + rect->X, glyph.field + y * glyph.width, glyph.width);
+				}
+			}
+			stbtt_FreeSDF(glyph.field, nullptr);
+		}
+
+		if (!alpha) {
+			spdlog::error("Failed to build the sdf atlas");
+			return false;
+		}
+
+		// converted only now so the fields copied in above make it into the rgba copy
+		unsigned char* rgba;
+		this->atlas->GetTexDataAsRGBA32(&rgba, &this->width, &this->height, &bytes_per_pixel);
+		this->pixels.assign(rgba, rgba + static_cast<std::size_t>(this->width) * this->height * bytes_per_pixel);
+		this->atlas->ClearTexData();
+
+		this->font = target;
+		spdlog::info("Baked {} sdf glyphs into {}x{}", pending.size(), this->width, this->height);
+		return true;
+	}
+};
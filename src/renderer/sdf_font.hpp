@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <imgui.h>
+#include "../profiler/memory.hpp"
+
+namespace selaura {
+	// one font baked once as signed distance fields, drawn at any size from the same small atlas
+	// the texture needs a material that thresholds the distance, with the usual ui material the edges come out soft
+	struct sdf_font {
+		sdf_font();
+		~sdf_font();
+		sdf_font(const sdf_font&) = delete;
+		sdf_font& operator=(const sdf_font&) = delete;
+
+		// size is the pixel height the fields are sampled at, ranges pairs up codepoints like imgui's glyph ranges
+		bool build(const void* compressed_ttf, int compressed_size, float size, const ImWchar* ranges);
+
+		ImFont* get_font() const {
+			return this->font;
+		}
+
+		ImFontAtlas& get_atlas() {
+			return *this->atlas;
+		}
+
+		// rgba, white with the distance in alpha since the ui materials read the texture's rgb
+		const memory::vector<unsigned char, memory::tag::textures>& get_pixels() const {
+			return this->pixels;
+		}
+
+		int get_width() const {
+			return this->width;
+		}
+
+		int get_height() const {
+			return this->height;
+		}
+	private:
+		ImFontAtlas* atlas;
+		ImFont* font = nullptr;
+		memory::vector<unsigned char, memory::tag::textures> pixels;
+		int width = 0;
+		int height = 0;
+	};
+};
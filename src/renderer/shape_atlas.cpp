@@ -0,0 +1,113 @@
+#include "shape_atlas.hpp"
+
+#include <imgui_internal.h>
+#include <algorithm>
+#include <cmath>
+
+namespace selaura {
+	namespace {
+		// big enough that a 32px corner is drawn from texels one to one, corners above that are magnified and soften slightly
+		constexpr int disc_size = 64;
+		constexpr float disc_radius = disc_size * 0.5f;
+		constexpr int samples = 4;
+
+		// edge coverage of a disc filling the square, supersampled so the rim is antialiased in the texture itself
+		unsigned char fill_texel(int x, int y) {
+			int inside = 0;
+			for (int sy = 0; sy < samples; sy++) {
+				for (int sx = 0; sx < samples; sx++) {
+					const float px = x + (sx + 0.5f) / samples - disc_radius;
+					const float py = y + (sy + 0.5f) / samples - disc_radius;
+					if (px * px + py * py <= (disc_radius - 0.5f) * (disc_radius - 0.5f)) inside++;
+				}
+			}
+			return static_cast<unsigned char>(inside * 255 / (samples * samples));
+		}
+
+		// gaussian-like falloff from the center out to the rim, squared smoothstep keeps the tail long like a real blur
+		unsigned char shadow_texel(int x, int y) {
+			const float px = x + 0.5f - disc_radius;
+			const float py = y + 0.5f - disc_radius;
+			const float t = std::clamp(std::sqrt(px * px + py * py) / disc_radius, 0.0f, 1.0f);
+			const float falloff = 1.0f - t * t * (3.0f - 2.0f * t);
+			return static_cast<unsigned char>(falloff * falloff * 255.0f + 0.5f);
+		}
+	}
+
+	void shape_atlas::add_rects(ImFontAtlas& atlas) {
+		this->baked = false;
+		this->fill_id = atlas.AddCustomRectRegular(disc_size, disc_size);
+		this->shadow_id = atlas.AddCustomRectRegular(disc_size, disc_size);
+	}
+
+	void shape_atlas::bake(ImFontAtlas& atlas) {
+		unsigned char* pixels = atlas.TexPixelsAlpha8;
+		if (!pixels || this->fill_id < 0 || this->shadow_id < 0) return;
+
+		auto fill = [&](int id, unsigned char (*texel)(int, int), disc_uv& uv) {
+			const ImFontAtlasCustomRect* rect = atlas.GetCustomRectByIndex(id);
+			for (int y = 0; y < disc_size; y++) {
+				for (int x = 0; x < disc_size; x++) {
+					pixels[(rect->Y + y) * atlas.TexWidth + rect->X + x] = texel(x, y);
+				}
+			}
+
+			ImVec2 uv_min, uv_max;
+			atlas.CalcCustomRectUV(rect, &uv_min, &uv_max);
+			uv = { uv_min, { (uv_min.x + uv_max.x) * 0.5f, (uv_min.y + uv_max.y) * 0.5f }, uv_max };
+		};
+
+		fill(this->fill_id, &fill_texel, this->fill_uv);
+		fill(this->shadow_id, &shadow_texel, this->shadow_uv);
+		this->baked = true;
+	}
+
+	void shape_atlas::nine_slice(ImDrawList* list, ImVec2 min, ImVec2 max, ImU32 color, float corner, const disc_uv& uv, ImDrawFlags flags) const {
+		const float xs[] = { min.x, min.x + corner, max.x - corner, max.x };
+		const float ys[] = { min.y, min.y + corner, max.y - corner, max.y };
+		// the middle column and row sample the disc's center line, so edges get the same profile as the corners
+		const float us[] = { uv.min.x, uv.center.x, uv.center.x, uv.max.x };
+		const float vs[] = { uv.min.y, uv.center.y, uv.center.y, uv.max.y };
+
+		const ImDrawFlags corners[] = { ImDrawFlags_RoundCornersTopLeft, ImDrawFlags_RoundCornersTopRight, ImDrawFlags_RoundCornersBottomLeft, ImDrawFlags_RoundCornersBottomRight };
+		const ImDrawFlags rounded = (flags & ImDrawFlags_RoundCornersMask_) ? (flags & ImDrawFlags_RoundCornersMask_) : ImDrawFlags_RoundCornersAll;
+
+		list->PrimReserve(9 * 6, 9 * 4);
+		for (int row = 0; row < 3; row++) {
+			for (int col = 0; col < 3; col++) {
+				ImVec2 uv_a{ us[col], vs[row] };
+				ImVec2 uv_b{ us[col + 1], vs[row + 1] };
+
+				// a square corner is a solid quad, sampled from the disc's opaque center
+				if (row != 1 && col != 1 && !(rounded & corners[(row / 2) * 2 + col / 2])) {
+					uv_a = uv_b = uv.center;
+				}
+
+				list->PrimRectUV({ xs[col], ys[row] }, { xs[col + 1], ys[row + 1] }, uv_a, uv_b, color);
+			}
+		}
+	}
+
+	void shape_atlas::fill_rect(ImDrawList* list, ImVec2 min, ImVec2 max, ImU32 color, float radius, ImDrawFlags flags) const {
+		if ((color & IM_COL32_A_MASK) == 0) return;
+
+		const float corner = std::min({ radius, (max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f });
+		if (!this->baked || corner < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone) {
+			list->AddRectFilled(min, max, color, corner, flags);
+			return;
+		}
+
+		this->nine_slice(list, min, max, color, corner, this->fill_uv, flags);
+	}
+
+	void shape_atlas::shadow_rect(ImDrawList* list, ImVec2 min, ImVec2 max, ImU32 color, float radius, float blur) const {
+		if (!this->baked || (color & IM_COL32_A_MASK) == 0) return;
+
+		const ImVec2 outer_min{ min.x - blur, min.y - blur };
+		const ImVec2 outer_max{ max.x + blur, max.y + blur };
+		const float corner = std::min({ radius + blur, (outer_max.x - outer_min.x) * 0.5f, (outer_max.y - outer_min.y) * 0.5f });
+		if (corner < 0.5f) return;
+
+		this->nine_slice(list, outer_min, outer_max, color, corner, this->shadow_uv, ImDrawFlags_RoundCornersAll);
+	}
+};
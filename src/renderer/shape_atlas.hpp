@@ -0,0 +1,36 @@
+#pragma once
+#include <imgui.h>
+
+namespace selaura {
+	// a filled disc and a soft falloff disc baked into the font atlas, rounded rects and shadows are nine quads sampling them
+	// same texture as every glyph and imgui's white pixel, so shapes never split a batch
+	struct shape_atlas {
+		// before the atlas is built
+		void add_rects(ImFontAtlas& atlas);
+		// after it is built, while its alpha pixels are still around
+		void bake(ImFontAtlas& atlas);
+
+		bool ready() const {
+			return this->baked;
+		}
+
+		// flags take ImDrawFlags_RoundCorners*, corners left out stay square
+		void fill_rect(ImDrawList* list, ImVec2 min, ImVec2 max, ImU32 color, float radius, ImDrawFlags flags = 0) const;
+		// a soft shadow spilling blur pixels out of the rect, the corner radius is the rect's plus the blur
+		void shadow_rect(ImDrawList* list, ImVec2 min, ImVec2 max, ImU32 color, float radius, float blur) const;
+	private:
+		struct disc_uv {
+			ImVec2 min;
+			ImVec2 center;
+			ImVec2 max;
+		};
+
+		void nine_slice(ImDrawList* list, ImVec2 min, ImVec2 max, ImU32 color, float corner, const disc_uv& uv, ImDrawFlags flags) const;
+
+		int fill_id = -1;
+		int shadow_id = -1;
+		disc_uv fill_uv{};
+		disc_uv shadow_uv{};
+		bool baked = false;
+	};
+};
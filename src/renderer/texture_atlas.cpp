@@ -0,0 +1,323 @@
+#include "texture_atlas.hpp"
+
+#include "../instance.hpp"
+#include "../util/hash.hpp"
+#include "../sdk/mc/deps/core/container/Blob.hpp"
+#include "../sdk/mc/deps/coregraphics/ImageBuffer.hpp"
+#include "../sdk/mc/deps/coregraphics/ImageDescription.hpp"
+#include "../sdk/mc/renderer/TextureGroup.hpp"
+
+// the implementation lives in texture_manager.cpp
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+
+namespace selaura {
+	namespace {
+		// a transparent texel on every side, so linear filtering never pulls in a neighbour
+		constexpr uint32_t padding = 1;
+
+		uint64_t name_key(std::string_view name) {
+			return hash_bytes(0, name.data(), name.size());
+		}
+
+		bool from_stbi(uint8_t* pixels, int width, int height, memory::vector<uint8_t, memory::tag::textures>& out, uint32_t& out_width, uint32_t& out_height) {
+			if (!pixels) return false;
+			out.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+			out_width = static_cast<uint32_t>(width);
+			out_height = static_cast<uint32_t>(height);
+			stbi_image_free(pixels);
+			return true;
+		}
+	}
+
+	texture_atlas::~texture_atlas() = default;
+
+	bool texture_atlas::page::pack(uint32_t width, uint32_t height, uint32_t& out_x, uint32_t& out_y) {
+		if (this->skyline.empty()) this->skyline.push_back({ 0, 0, page_size });
+
+		// lowest spot the rect fits on top of the skyline, leftmost on ties
+		size_t best = this->skyline.size();
+		uint32_t best_y = page_size;
+		for (size_t i = 0; i < this->skyline.size(); i++) {
+			const uint32_t x = this->skyline[i].x;
+			if (x + width > page_size) break;
+
+			uint32_t y = 0;
+			uint32_t remaining = width;
+			for (size_t j = i; remaining > 0; j++) {
+				y = std::max(y, this->skyline[j].y);
+				if (this->skyline[j].width >= remaining) break;
+				remaining -= this->skyline[j].width;
+			}
+
+			if (y + height <= page_size && y < best_y) {
+				best = i;
+				best_y = y;
+			}
+		}
+		if (best == this->skyline.size()) return false;
+
+		out_x = this->skyline[best].x;
+		out_y = best_y;
+
+		// the new segment covers whatever part of the nodes after it lies under the rect
+		this->skyline.insert(this->skyline.begin() + best, { out_x, best_y + height, width });
+		const uint32_t end = out_x + width;
+		for (size_t k = best + 1; k < this->skyline.size();) {
+			auto& node = this->skyline[k];
+			if (node.x >= end) break;
+
+			const uint32_t covered = end - node.x;
+			if (node.width <= covered) {
+				this->skyline.erase(this->skyline.begin() + k);
+				continue;
+			}
+			node.x += covered;
+			node.width -= covered;
+			break;
+		}
+
+		for (size_t k = 0; k + 1 < this->skyline.size();) {
+			if (this->skyline[k].y == this->skyline[k + 1].y) {
+				this->skyline[k].width += this->skyline[k + 1].width;
+				this->skyline.erase(this->skyline.begin() + k + 1);
+			}
+			else {
+				k++;
+			}
+		}
+
+		this->used_area += static_cast<uint64_t>(width) * height;
+		this->dirty = true;
+		return true;
+	}
+
+	void texture_atlas::page::clear() {
+		std::fill(this->pixels.begin(), this->pixels.end(), uint8_t{ 0 });
+		this->skyline.clear();
+		this->used_area = 0;
+		this->dead_area = 0;
+		this->dirty = true;
+	}
+
+	const atlas_region* texture_atlas::add(std::string_view name, const std::filesystem::path& file) {
+		return queue(name, [file](image& out) {
+			int width = 0, height = 0, channels = 0;
+			return from_stbi(stbi_load(file.string().c_str(), &width, &height, &channels, 4), width, height, out.pixels, out.width, out.height);
+		});
+	}
+
+	const atlas_region* texture_atlas::add(std::string_view name, std::vector<uint8_t> encoded) {
+		return queue(name, [encoded = std::move(encoded)](image& out) {
+			int width = 0, height = 0, channels = 0;
+			uint8_t* pixels = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()), &width, &height, &channels, 4);
+			return from_stbi(pixels, width, height, out.pixels, out.width, out.height);
+		});
+	}
+
+	const atlas_region* texture_atlas::add_rgba(std::string_view name, std::vector<uint8_t> rgba, uint32_t width, uint32_t height) {
+		return queue(name, [rgba = std::move(rgba), width, height](image& out) {
+			if (rgba.size() < static_cast<size_t>(width) * height * 4) return false;
+			out = { { rgba.begin(), rgba.end() }, width, height };
+			return true;
+		});
+	}
+
+	const atlas_region* texture_atlas::queue(std::string_view name, std::function<bool(image&)> decode) {
+		uint32_t generation;
+		asset* target;
+		{
+			std::scoped_lock lock(this->mutex);
+			auto& slot = this->assets[name_key(name)];
+			if (slot && !slot->removed) return &slot->region;
+			if (!slot) slot = std::make_unique<asset>();
+
+			target = slot.get();
+			target->removed = false;
+			generation = ++target->generation;
+		}
+
+		selaura::get_component<selaura::job_system>().submit([this, target, generation, decode = std::move(decode), name = std::string(name)] {
+			image pixels;
+			if (!decode(pixels)) {
+				spdlog::error("Failed to decode atlas image {}: {}", name, stbi_failure_reason() ? stbi_failure_reason() : "bad size");
+				return this->fail(target, generation);
+			}
+			if (pixels.width + padding * 2 > page_size || pixels.height + padding * 2 > page_size) {
+				spdlog::error("Atlas image {} is {}x{}, bigger than a page", name, pixels.width, pixels.height);
+				return this->fail(target, generation);
+			}
+
+			std::scoped_lock lock(this->mutex);
+			this->packing_queue.push_back({ target, generation, std::move(pixels) });
+		});
+		return &target->region;
+	}
+
+	void texture_atlas::fail(asset* target, uint32_t generation) {
+		std::scoped_lock lock(this->mutex);
+		// removed or added again since, the newer request decides
+		if (target->generation != generation) return;
+
+		target->removed = true;
+		this->packing_queue.push_back({ target, generation, {}, true, true });
+	}
+
+	void texture_atlas::remove(std::string_view name) {
+		std::scoped_lock lock(this->mutex);
+		auto it = this->assets.find(name_key(name));
+		if (it == this->assets.end() || it->second->removed) return;
+
+		it->second->removed = true;
+		this->packing_queue.push_back({ it->second.get(), ++it->second->generation, {}, true });
+	}
+
+	const atlas_region* texture_atlas::find(std::string_view name) const {
+		std::scoped_lock lock(this->mutex);
+		auto it = this->assets.find(name_key(name));
+		return it == this->assets.end() || it->second->removed ? nullptr : &it->second->region;
+	}
+
+	void texture_atlas::unplace(asset& target) {
+		if (target.page < 0) return;
+
+		auto& owner = *this->pages[target.page];
+		owner.dead_area += static_cast<uint64_t>(target.pixels.width + padding * 2) * (target.pixels.height + padding * 2);
+		target.page = -1;
+		target.region = {};
+		target.pixels = {};
+	}
+
+	bool texture_atlas::place_in(int32_t index, asset& target) {
+		auto& owner = *this->pages[index];
+		uint32_t x, y;
+		if (!owner.pack(target.pixels.width + padding * 2, target.pixels.height + padding * 2, x, y)) return false;
+
+		target.page = index;
+		target.x = x + padding;
+		target.y = y + padding;
+
+		const uint32_t row_bytes = target.pixels.width * 4;
+		for (uint32_t row = 0; row < target.pixels.height; row++) {
+			std::memcpy(owner.pixels.data() + (static_cast<size_t>(target.y + row) * page_size + target.x) * 4, target.pixels.pixels.data() + static_cast<size_t>(row) * row_bytes, row_bytes);
+		}
+
+		constexpr float scale = 1.0f / page_size;
+		target.region.uv_min = { target.x * scale, target.y * scale };
+		target.region.uv_max = { (target.x + target.pixels.width) * scale, (target.y + target.pixels.height) * scale };
+		target.region.width = target.pixels.width;
+		target.region.height = target.pixels.height;
+		return true;
+	}
+
+	void texture_atlas::place(asset& target) {
+		for (int32_t i = 0; i < static_cast<int32_t>(this->pages.size()); i++) {
+			if (place_in(i, target)) return;
+		}
+
+		// reclaiming a page full of removed assets is cheaper than another page of texture memory
+		auto wasted = std::max_element(this->pages.begin(), this->pages.end(), [](const auto& a, const auto& b) { return a->dead_area < b->dead_area; });
+		if (wasted != this->pages.end() && (*wasted)->dead_area != 0) {
+			const auto index = static_cast<int32_t>(wasted - this->pages.begin());
+			repack(index);
+			if (place_in(index, target)) return;
+		}
+
+		auto& created = *this->pages.emplace_back(std::make_unique<page>());
+		created.location = ResourceLocation(std::format("selaura/atlas/page{}", this->pages.size() - 1));
+		created.pixels.resize(static_cast<size_t>(page_size) * page_size * 4);
+		place_in(static_cast<int32_t>(this->pages.size()) - 1, target);
+	}
+
+	void texture_atlas::repack(int32_t index) {
+		std::vector<asset*> live;
+		for (auto& [key, entry] : this->assets) {
+			if (entry->page == index) live.push_back(entry.get());
+		}
+
+		// tallest first packs tightest on a skyline
+		std::sort(live.begin(), live.end(), [](const asset* a, const asset* b) { return a->pixels.height > b->pixels.height; });
+
+		this->pages[index]->clear();
+		for (asset* entry : live) {
+			entry->page = -1;
+			if (!place_in(index, *entry)) place(*entry);
+		}
+	}
+
+	void texture_atlas::upload(MinecraftUIRenderContext& ctx, int32_t index) {
+		auto* game = selaura::get_component<selaura::globals>().mc_game;
+		if (!game) return;
+
+		auto& target = *this->pages[index];
+		target.dirty = false;
+
+		// the game frees the blob whenever it likes, the page keeps its own pixels for the next change
+		auto* copy = static_cast<mce::Blob::value_type*>(std::malloc(target.pixels.size()));
+		if (!copy) return;
+		std::memcpy(copy, target.pixels.data(), target.pixels.size());
+
+		mce::Blob blob(copy, target.pixels.size(), [](mce::Blob::value_type* data) { std::free(data); });
+		cg::ImageDescription description(page_size, page_size, mce::TextureFormat::R8G8B8A8_UNORM, cg::ColorSpace::sRGB, cg::ImageType::Texture2D, 1);
+		cg::ImageBuffer buffer(std::move(blob), std::move(description));
+
+		game->getTextureGroup()->uploadTexture(target.location, std::move(buffer));
+		target.texture = ctx.getTexture(target.location, true);
+
+		for (auto& [key, entry] : this->assets) {
+			if (entry->page == index) entry->region.texture = static_cast<ImTextureID>(&target.texture);
+		}
+	}
+
+	void texture_atlas::process(MinecraftUIRenderContext& ctx) {
+		std::scoped_lock lock(this->mutex);
+
+		bool changed = false;
+		while (!this->packing_queue.empty()) {
+			pending next = std::move(this->packing_queue.front());
+			this->packing_queue.pop_front();
+			if (next.generation != next.target->generation) continue;
+
+			if (next.remove) {
+				const int32_t index = next.target->page;
+				this->unplace(*next.target);
+				next.target->region.failed = next.failed;
+
+				// half of it gone, moving the rest together frees room for what comes next
+				if (index >= 0 && this->pages[index]->dead_area * 2 >= this->pages[index]->used_area) repack(index);
+				continue;
+			}
+
+			this->unplace(*next.target);
+			next.target->region.failed = false;
+			next.target->pixels = std::move(next.pixels);
+			place(*next.target);
+			changed = true;
+		}
+
+		for (int32_t i = 0; i < static_cast<int32_t>(this->pages.size()); i++) {
+			if (this->pages[i]->dirty) {
+				upload(ctx, i);
+				changed = true;
+			}
+		}
+
+		// new icons should not wait for whatever else makes the overlay rebuild
+		if (changed) selaura::get_component<selaura::renderer>().get_pacer().invalidate();
+	}
+
+	void texture_atlas::on_textures_unloaded() {
+		std::scoped_lock lock(this->mutex);
+		for (auto& target : this->pages) {
+			target->texture = {};
+			target->dirty = true;
+		}
+		for (auto& [key, entry] : this->assets) {
+			entry->region.texture = nullptr;
+		}
+	}
+};
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui.h>
+#include "../sdk/mc/renderer/screen/MinecraftUIRenderContext.hpp"
+#include "../sdk/mc/renderer/helpers/MeshHelpers.hpp"
+#include "../sdk/mc/deps/core/resource/ResourceHelper.hpp"
+#include "../profiler/memory.hpp"
+
+namespace selaura {
+	// where an asset ended up, stable for as long as the atlas lives, the texture and uvs change when its page is repacked
+	struct atlas_region {
+		ImTextureID texture = nullptr;
+		ImVec2 uv_min{};
+		ImVec2 uv_max{};
+		uint32_t width = 0;
+		uint32_t height = 0;
+		// the image could not be decoded or is bigger than a page, it never becomes ready and adding it again retries
+		bool failed = false;
+
+		// null until the page holding it has been uploaded
+		bool ready() const {
+			return this->texture != nullptr;
+		}
+	};
+
+	// small images packed into a few large pages, one upload and one batch per page however many icons are drawn from it
+	// anything bigger than a page belongs in texture_manager instead
+	struct texture_atlas {
+		static constexpr uint32_t page_size = 1024;
+
+		texture_atlas() = default;
+		~texture_atlas();
+		texture_atlas(const texture_atlas&) = delete;
+		texture_atlas& operator=(const texture_atlas&) = delete;
+
+		// any thread, decoded on the job system and packed on the render thread, adding the same name twice returns the first region
+		const atlas_region* add(std::string_view name, const std::filesystem::path& file);
+		const atlas_region* add(std::string_view name, std::vector<uint8_t> encoded);
+		const atlas_region* add_rgba(std::string_view name, std::vector<uint8_t> rgba, uint32_t width, uint32_t height);
+		// the space is reclaimed the next time its page is repacked, the region reads as not ready from here on
+		void remove(std::string_view name);
+
+		const atlas_region* find(std::string_view name) const;
+
+		// render thread only, packs what finished decoding and uploads the pages that changed
+		void process(MinecraftUIRenderContext& ctx);
+
+		// the game dropped every texture, the pages are still in memory and only need uploading again
+		void on_textures_unloaded();
+	private:
+		struct image {
+			memory::vector<uint8_t, memory::tag::textures> pixels;
+			uint32_t width = 0;
+			uint32_t height = 0;
+		};
+
+		struct asset {
+			atlas_region region;
+			// kept so a repack can move it without decoding again
+			image pixels;
+			// render thread only, -1 until it is packed
+			int32_t page = -1;
+			uint32_t x = 0;
+			uint32_t y = 0;
+			// under the mutex, generation is bumped by every remove and re-add, decodes finishing for an older one are dropped
+			bool removed = false;
+			uint32_t generation = 0;
+		};
+
+		// bottom-left skyline, good enough for icons of mixed sizes and cheap to extend one rect at a time
+		struct page {
+			struct skyline_node {
+				uint32_t x;
+				uint32_t y;
+				uint32_t width;
+			};
+
+			ResourceLocation location;
+			mce::TexturePtr texture;
+			memory::vector<uint8_t, memory::tag::textures> pixels;
+			std::vector<skyline_node> skyline;
+			uint64_t used_area = 0;
+			uint64_t dead_area = 0;
+			bool dirty = false;
+
+			bool pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+			void clear();
+		};
+
+		// a finished decode, or a removal when remove is set, failed marks a removal that came from a decode that went wrong
+		struct pending {
+			asset* target;
+			uint32_t generation;
+			image pixels;
+			bool remove = false;
+			bool failed = false;
+		};
+
+		const atlas_region* queue(std::string_view name, std::function<bool(image&)> decode);
+		// job thread, gives the name back so a later add retries instead of returning a region that never gets ready
+		void fail(asset* target, uint32_t generation);
+		void unplace(asset& target);
+		void place(asset& target);
+		bool place_in(int32_t index, asset& target);
+		void repack(int32_t index);
+		void upload(MinecraftUIRenderContext& ctx, int32_t index);
+
+		mutable std::mutex mutex;
+		std::unordered_map<uint64_t, std::unique_ptr<asset>> assets;
+		std::deque<pending> packing_queue;
+
+		// render thread only from here on
+		std::vector<std::unique_ptr<page>> pages;
+	};
+};
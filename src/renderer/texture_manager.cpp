@@ -0,0 +1,142 @@
+#include "texture_manager.hpp"
+
+#include "../instance.hpp"
+#include "../sdk/mc/deps/core/container/Blob.hpp"
+#include "../sdk/mc/deps/coregraphics/ImageBuffer.hpp"
+#include "../sdk/mc/deps/coregraphics/ImageDescription.hpp"
+#include "../sdk/mc/renderer/TextureGroup.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include <stb_image.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace selaura {
+	texture_manager::~texture_manager() {
+		// the job system is torn down first, every decode has finished by now
+		for (auto& image : this->upload_queue) {
+			free_pixels(image.pixels);
+		}
+	}
+
+	ImTextureID texture_manager::load(std::string_view name, const std::filesystem::path& file) {
+		return add(name, file);
+	}
+
+	ImTextureID texture_manager::load(std::string_view name, std::vector<uint8_t> encoded) {
+		return add(name, std::move(encoded));
+	}
+
+	ImTextureID texture_manager::load_rgba(std::string_view name, std::vector<uint8_t> rgba, uint32_t width, uint32_t height) {
+		// the upload hands the game a blob of exactly width * height * 4 bytes, anything else would be read past or left short
+		if (width == 0 || height == 0 || rgba.size() != size_t(width) * height * 4) {
+			spdlog::error("Rejected texture {}: {} bytes of rgba for {}x{}", name, rgba.size(), width, height);
+			return nullptr;
+		}
+
+		return add(name, raw_image{ std::move(rgba), width, height });
+	}
+
+	bool texture_manager::is_ready(ImTextureID id) const {
+		return id && static_cast<const mce::TexturePtr*>(id)->mClientTexture != nullptr;
+	}
+
+	ImTextureID texture_manager::add(std::string_view name, source_t&& source) {
+		ResourceLocation location(std::string("selaura/") + std::string(name));
+
+		std::scoped_lock lock(this->mutex);
+		auto [it, inserted] = this->entries.try_emplace(location.mFullHash);
+		if (!inserted) return &it->second->texture;
+
+		it->second = std::make_unique<entry>();
+		it->second->location = std::move(location);
+		it->second->source = std::move(source);
+
+		queue_decode(*it->second);
+		return &it->second->texture;
+	}
+
+	void texture_manager::queue_decode(entry& target) {
+		selaura::get_component<selaura::job_system>().submit([this, target = &target, generation = target.generation] {
+			this->decode(target, generation);
+		});
+	}
+
+	void texture_manager::free_pixels(uint8_t* pixels) {
+		stbi_image_free(pixels);
+	}
+
+	void texture_manager::decode(entry* target, uint32_t generation) {
+		// sources are never touched after the entry is created, so reading them unlocked is fine
+		int width = 0, height = 0, channels = 0;
+		uint8_t* pixels = std::visit([&]<typename T>(const T& source) -> uint8_t* {
+			if constexpr (std::is_same_v<T, std::filesystem::path>) {
+				return stbi_load(source.string().c_str(), &width, &height, &channels, 4);
+			}
+			else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+				return stbi_load_from_memory(source.data(), static_cast<int>(source.size()), &width, &height, &channels, 4);
+			}
+			else {
+				// stbi_image_free is plain free, keep raw copies on the same allocator
+				auto* copy = static_cast<uint8_t*>(std::malloc(source.pixels.size()));
+				if (copy) std::memcpy(copy, source.pixels.data(), source.pixels.size());
+				width = static_cast<int>(source.width);
+				height = static_cast<int>(source.height);
+				return copy;
+			}
+		}, target->source);
+
+		if (!pixels) {
+			spdlog::error("Failed to decode texture {}: {}", target->location.mPath, stbi_failure_reason() ? stbi_failure_reason() : "out of memory");
+			return;
+		}
+
+		std::scoped_lock lock(this->mutex);
+		this->upload_queue.push_back({ target, generation, pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+	}
+
+	void texture_manager::process_uploads(MinecraftUIRenderContext& ctx) {
+		auto* game = selaura::get_component<selaura::globals>().mc_game;
+		if (!game) return;
+
+		for (size_t uploaded = 0; uploaded < this->uploads_per_frame; uploaded++) {
+			decoded image;
+			bool stale;
+			{
+				std::scoped_lock lock(this->mutex);
+				if (this->upload_queue.empty()) return;
+				image = this->upload_queue.front();
+				this->upload_queue.pop_front();
+				stale = image.generation != image.target->generation;
+			}
+
+			// a reload started while this one was decoding, the newer decode is already queued
+			if (stale) {
+				free_pixels(image.pixels);
+				continue;
+			}
+
+			mce::Blob blob(image.pixels, static_cast<size_t>(image.width) * image.height * 4, free_pixels);
+			cg::ImageDescription description(image.width, image.height, mce::TextureFormat::R8G8B8A8_UNORM, cg::ColorSpace::sRGB, cg::ImageType::Texture2D, 1);
+			cg::ImageBuffer buffer(std::move(blob), std::move(description));
+
+			game->getTextureGroup()->uploadTexture(image.target->location, std::move(buffer));
+			image.target->texture = ctx.getTexture(image.target->location, false);
+		}
+	}
+
+	void texture_manager::on_textures_unloaded() {
+		std::scoped_lock lock(this->mutex);
+		for (auto& [hash, target] : this->entries) {
+			target->texture = {};
+			target->generation++;
+			queue_decode(*target);
+		}
+	}
+
+	void texture_manager::set_uploads_per_frame(size_t count) {
+		this->uploads_per_frame = count;
+	}
+};
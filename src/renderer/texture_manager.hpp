@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <imgui.h>
+#include "../sdk/mc/renderer/screen/MinecraftUIRenderContext.hpp"
+#include "../sdk/mc/renderer/helpers/MeshHelpers.hpp"
+#include "../sdk/mc/deps/core/resource/ResourceHelper.hpp"
+
+namespace selaura {
+	struct texture_manager {
+		texture_manager() = default;
+		~texture_manager();
+		texture_manager(const texture_manager&) = delete;
+		texture_manager& operator=(const texture_manager&) = delete;
+
+		// all loads return straight away, the id draws nothing until the upload has gone through
+		// load_rgba returns nullptr when the pixels don't match the size
+		ImTextureID load(std::string_view name, const std::filesystem::path& file);
+		ImTextureID load(std::string_view name, std::vector<uint8_t> encoded);
+		ImTextureID load_rgba(std::string_view name, std::vector<uint8_t> rgba, uint32_t width, uint32_t height);
+
+		bool is_ready(ImTextureID id) const;
+
+		// render thread only, applies at most uploads_per_frame finished decodes
+		void process_uploads(MinecraftUIRenderContext& ctx);
+
+		// the game dropped every texture, everything we own is decoded and uploaded again
+		void on_textures_unloaded();
+
+		void set_uploads_per_frame(size_t count);
+	private:
+		struct raw_image {
+			std::vector<uint8_t> pixels;
+			uint32_t width;
+			uint32_t height;
+		};
+
+		using source_t = std::variant<std::filesystem::path, std::vector<uint8_t>, raw_image>;
+
+		struct entry {
+			ResourceLocation location;
+			source_t source;
+			mce::TexturePtr texture;
+			uint32_t generation = 0;
+		};
+
+		struct decoded {
+			entry* target;
+			uint32_t generation;
+			uint8_t* pixels;
+			uint32_t width;
+			uint32_t height;
+		};
+
+		ImTextureID add(std::string_view name, source_t&& source);
+		void queue_decode(entry& target);
+		void decode(entry* target, uint32_t generation);
+		static void free_pixels(uint8_t* pixels);
+
+		// keyed by ResourceLocation::mFullHash, entries never move so their texture doubles as the ImTextureID
+		std::unordered_map<uint64_t, std::unique_ptr<entry>> entries;
+		size_t uploads_per_frame = 2;
+
+		std::mutex mutex;
+		std::deque<decoded> upload_queue;
+	};
+};
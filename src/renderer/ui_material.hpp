@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <imgui.h>
+
+namespace selaura {
+	// which engine material a draw list's commands go out with, plain unless a command asks otherwise
+	enum class ui_material : std::uint8_t {
+		// textured and colored, what text, lines and most widgets need
+		plain,
+		// blurs what is behind it, expensive on mobile gpus so only for panels that want the frosted look
+		blur
+	};
+
+	// never called, the renderer recognises it and switches materials instead
+	inline void ui_material_callback(const ImDrawList*, const ImDrawCmd*) {}
+
+	// applies to everything drawn into the list afterwards, every list starts out plain again
+	inline void set_ui_material(ImDrawList* list, ui_material material) {
+		list->AddCallback(&ui_material_callback, reinterpret_cast<void*>(static_cast<std::uintptr_t>(material)));
+	}
+
+	inline bool is_material_command(const ImDrawCmd& cmd) {
+		return cmd.UserCallback == &ui_material_callback;
+	}
+
+	inline ui_material material_of(const ImDrawCmd& cmd) {
+		return static_cast<ui_material>(reinterpret_cast<std::uintptr_t>(cmd.UserCallbackData));
+	}
+};
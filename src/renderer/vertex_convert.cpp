@@ -0,0 +1,48 @@
+#include "vertex_convert.hpp"
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SELAURA_CONVERT_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SELAURA_CONVERT_NEON
+#endif
+
+// the simd paths load pos and uv as one 16 byte lane and store x, y, z, u in one go
+static_assert(offsetof(ImDrawVert, pos) == 0 && offsetof(ImDrawVert, uv) == 8);
+static_assert(offsetof(Tessellator::vertex, x) == 0 && offsetof(Tessellator::vertex, u) == 12 && offsetof(Tessellator::vertex, v) == 16);
+
+namespace selaura {
+	void convert_vertices(std::span<const ImDrawVert> in, float inv_scale, Tessellator::vertex* out) {
+#if defined(SELAURA_CONVERT_SSE2)
+		const __m128 scale = _mm_setr_ps(inv_scale, inv_scale, 1.0f, 1.0f);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (const ImDrawVert& vtx : in) {
+			const __m128 m = _mm_mul_ps(_mm_loadu_ps(&vtx.pos.x), scale);
+			const __m128 zu = _mm_shuffle_ps(zero, m, _MM_SHUFFLE(3, 2, 0, 0));
+			_mm_storeu_ps(&out->x, _mm_shuffle_ps(m, zu, _MM_SHUFFLE(2, 1, 1, 0)));
+			out->v = vtx.uv.y;
+			out->color = vtx.col;
+			out++;
+		}
+#elif defined(SELAURA_CONVERT_NEON)
+		const float32x4_t scale = { inv_scale, inv_scale, 1.0f, 1.0f };
+
+		for (const ImDrawVert& vtx : in) {
+			const float32x4_t m = vmulq_f32(vld1q_f32(&vtx.pos.x), scale);
+			const float32x2_t zu = vset_lane_f32(vgetq_lane_f32(m, 2), vdup_n_f32(0.0f), 1);
+			vst1q_f32(&out->x, vcombine_f32(vget_low_f32(m), zu));
+			out->v = vtx.uv.y;
+			out->color = vtx.col;
+			out++;
+		}
+#else
+		for (const ImDrawVert& vtx : in) {
+			*out++ = { vtx.pos.x * inv_scale, vtx.pos.y * inv_scale, 0.0f, vtx.uv.x, vtx.uv.y, vtx.col };
+		}
+#endif
+	}
+};
@@ -0,0 +1,10 @@
+#pragma once
+#include <span>
+
+#include <imgui.h>
+#include "../sdk/mc/renderer/Tessellator.hpp"
+
+namespace selaura {
+	// converts a whole imgui vertex buffer in one pass, positions are multiplied by inv_scale
+	void convert_vertices(std::span<const ImDrawVert> in, float inv_scale, Tessellator::vertex* out);
+};
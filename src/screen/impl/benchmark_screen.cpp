@@ -0,0 +1,153 @@
+#include "benchmark_screen.hpp"
+
+#include "../../instance.hpp"
+#include "../../hook/hook_manager.hpp"
+#include "../../renderer/renderer.hpp"
+#include <imgui.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <utility>
+
+namespace selaura {
+    namespace {
+        // frames right after a switch carry the cost of switching, hooks being patched and the overlay rebuilding
+        constexpr auto settle_time = std::chrono::seconds(1);
+
+        struct frame_stats {
+            double mean_ms = 0.0;
+            double p99_ms = 0.0;
+            std::size_t frames = 0;
+        };
+
+        frame_stats summarize(std::vector<float>& frames) {
+            frame_stats stats;
+            if (frames.empty()) return stats;
+
+            double total = 0.0;
+            for (float frame : frames) total += frame;
+            stats.mean_ms = total / static_cast<double>(frames.size());
+            stats.frames = frames.size();
+
+            const auto p99 = frames.begin() + static_cast<std::ptrdiff_t>((frames.size() - 1) * 99 / 100);
+            std::nth_element(frames.begin(), p99, frames.end());
+            stats.p99_ms = *p99;
+            return stats;
+        }
+    }
+
+    benchmark_screen::benchmark_screen() : screen() {
+        this->draw_on("hud_screen");
+        this->draw_on("start_screen");
+        this->listen(&benchmark_screen::on_update);
+        this->set_hotkey(selaura::key::F9);
+        this->set_enabled(false);
+    }
+
+    void benchmark_screen::on_disable() {
+        if (this->running) {
+            spdlog::info("Benchmark aborted");
+            this->stop();
+        }
+    }
+
+    // on, off, off, on so drift over the run (chunks loading, the device warming up) lands on both sides equally
+    bool benchmark_screen::overlay_on(std::uint32_t window) {
+        return (window % 2 == 0) != ((window / 2) % 2 == 1);
+    }
+
+    void benchmark_screen::apply(bool on) {
+        selaura::get_component<selaura::renderer>().get_pacer().set_suspended(!on);
+        if (this->toggle_hooks) selaura::get_component<selaura::hook_manager>().set_suspended(!on);
+    }
+
+    void benchmark_screen::start() {
+        this->samples.clear();
+        this->samples.reserve(static_cast<std::size_t>(this->window_seconds) * this->rounds * 2 * 240);
+        this->window = 0;
+        this->window_start = clock::now();
+        this->last_frame = {};
+        this->running = true;
+        this->apply(overlay_on(0));
+        spdlog::info("Benchmark started, {} rounds of {} s{}", this->rounds, this->window_seconds, this->toggle_hooks ? " with hooks" : "");
+    }
+
+    void benchmark_screen::stop() {
+        this->running = false;
+        selaura::get_component<selaura::renderer>().get_pacer().set_suspended(false);
+        selaura::get_component<selaura::hook_manager>().set_suspended(false);
+    }
+
+    void benchmark_screen::finish() {
+        this->stop();
+
+        std::vector<float> on, off;
+        for (const auto& entry : this->samples) (entry.overlay ? on : off).push_back(entry.frame_ms);
+        const auto with = summarize(on);
+        const auto without = summarize(off);
+
+        spdlog::info("Benchmark: on {:.3f} ms mean {:.3f} ms p99 ({} frames), off {:.3f} ms mean {:.3f} ms p99 ({} frames)",
+            with.mean_ms, with.p99_ms, with.frames, without.mean_ms, without.p99_ms, without.frames);
+        spdlog::info("Benchmark: selaura costs {:+.3f} ms mean, {:+.3f} ms p99", with.mean_ms - without.mean_ms, with.p99_ms - without.p99_ms);
+
+        const auto folder = selaura::instance::get()->get_data_folder() / "benchmarks";
+        std::error_code ec;
+        std::filesystem::create_directories(folder, ec);
+
+        const auto path = folder / std::format("ab-{:%Y%m%d-%H%M%S}.csv", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+        std::ofstream out(path);
+        if (!out) {
+            spdlog::error("Failed to write benchmark results to {}", path.string());
+            return;
+        }
+
+        out << "window,overlay,frame_ms\n";
+        for (const auto& entry : this->samples) {
+            out << std::format("{},{},{:.4f}\n", entry.window, entry.overlay ? 1 : 0, entry.frame_ms);
+        }
+        spdlog::info("Benchmark results written to {}", path.string());
+    }
+
+    // frames are timed at the MinecraftGame::update cadence, SetupAndRender stops being called once the render hooks are suspended
+    void benchmark_screen::on_update(selaura::minecraftgame_update_event& ev) {
+        if (!this->running) return;
+
+        const auto now = clock::now();
+        const auto previous = std::exchange(this->last_frame, now);
+        const auto window_length = std::chrono::seconds(this->window_seconds);
+
+        if (now - this->window_start >= window_length) {
+            this->window++;
+            this->window_start = now;
+            if (this->window >= static_cast<std::uint32_t>(this->rounds) * 2) {
+                this->finish();
+                return;
+            }
+            this->apply(overlay_on(this->window));
+        }
+
+        // the first update of a run is inside the settle time too, previous is always a real frame here
+        if (now - this->window_start < settle_time) return;
+        this->samples.push_back({ this->window, overlay_on(this->window), std::chrono::duration<float, std::milli>(now - previous).count() });
+    }
+
+    void benchmark_screen::on_render(selaura::setupandrender_event& ev) {
+        ImGui::SetNextWindowSize({ 320.0f, 0.0f }, ImGuiCond_FirstUseEver);
+        ImGui::Begin("Benchmark", nullptr, ImGuiWindowFlags_NoCollapse);
+
+        // as little as possible while running, whatever this window costs is counted against the overlay
+        if (this->running) {
+            ImGui::Text("window %u of %d", this->window + 1, this->rounds * 2);
+            ImGui::End();
+            return;
+        }
+
+        ImGui::SliderInt("window (s)", &this->window_seconds, 2, 60);
+        ImGui::SliderInt("rounds", &this->rounds, 1, 10);
+        ImGui::Checkbox("toggle all hooks", &this->toggle_hooks);
+        if (ImGui::Button("start")) this->start();
+
+        ImGui::End();
+    }
+};
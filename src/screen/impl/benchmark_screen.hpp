@@ -0,0 +1,44 @@
+#pragma once
+#include "../screen.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace selaura {
+    // alternates the overlay, and optionally every on-demand hook, on and off in timed windows to measure what the client costs
+    struct benchmark_screen : public screen {
+        DEFINE_SCREEN_TRAITS("Benchmark");
+
+        benchmark_screen();
+
+        void on_render(selaura::setupandrender_event& ev) override;
+        void on_disable() override;
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct sample {
+            std::uint32_t window;
+            bool overlay;
+            float frame_ms;
+        };
+
+        void on_update(selaura::minecraftgame_update_event& ev);
+
+        void start();
+        // puts the overlay and hooks back, finish also writes the results
+        void stop();
+        void finish();
+        static bool overlay_on(std::uint32_t window);
+        void apply(bool on);
+
+        int window_seconds = 10;
+        int rounds = 3;
+        bool toggle_hooks = false;
+
+        bool running = false;
+        std::uint32_t window = 0;
+        clock::time_point window_start;
+        clock::time_point last_frame;
+        std::vector<sample> samples;
+    };
+};
@@ -1,5 +1,9 @@
 #pragma once
 #include "../screen.hpp"
+#include "../../feature/feature_search.hpp"
+
+#include <cstdint>
+#include <memory_resource>
 
 namespace selaura {
     struct click_gui : public screen {
@@ -8,5 +12,22 @@ namespace selaura {
         click_gui();
 
         void on_render(selaura::setupandrender_event& ev) override;
+        void on_layers_hidden() override;
+    private:
+        // a feature's button, or one of its settings when setting isn't feature_row
+        struct row {
+            static constexpr std::uint32_t feature_row = ~std::uint32_t{ 0 };
+
+            feature* target;
+            std::uint32_t setting;
+        };
+
+        void on_update(selaura::minecraftgame_update_event& ev);
+        void draw_feature(feature& target);
+        void draw_setting(feature& target, std::size_t setting, std::pmr::memory_resource* arena);
+
+        std::size_t selected_category = 0;
+        char query[64]{};
+        feature_search search;
     };
 };
\ No newline at end of file
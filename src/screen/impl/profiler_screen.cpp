@@ -0,0 +1,157 @@
+#include "profiler_screen.hpp"
+
+#include "../../profiler/profiler.hpp"
+#include "../../profiler/memory.hpp"
+#include "../../instance.hpp"
+#include <imgui.h>
+
+namespace selaura {
+    profiler_screen::profiler_screen() : screen() {
+        this->draw_on("hud_screen");
+        this->draw_on("start_screen");
+        this->set_hotkey(selaura::key::F10);
+        this->set_enabled(false);
+    }
+
+    void profiler_screen::on_render(selaura::setupandrender_event& ev) {
+#if defined(SELAURA_PROFILING)
+        ImGui::SetNextWindowSize({ 420.0f, 0.0f }, ImGuiCond_FirstUseEver);
+        ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_NoCollapse);
+
+        // 0 rebuilds the overlay on every game frame
+        auto& pacer = ev.renderer.get_pacer();
+        int refresh_rate = static_cast<int>(pacer.get_refresh_rate());
+        if (ImGui::SliderInt("overlay hz", &refresh_rate, 0, 240)) pacer.set_refresh_rate(static_cast<std::uint32_t>(refresh_rate));
+        ImGui::Text("%llu rebuilt, %llu replayed", static_cast<unsigned long long>(pacer.get_rebuilds()), static_cast<unsigned long long>(pacer.get_replays()));
+        ImGui::Text("frame arena peak %.1f KiB", ev.renderer.get_frame_arena().get_peak() / 1024.0);
+
+        const auto game = selaura::get_component<selaura::globals>().snapshot();
+        ImGui::Text("tick %llu, %.1f ms, gui %.0fx%.0f at %.1fx", static_cast<unsigned long long>(game.tick), game.delta * 1000.0f, game.gui_size.x, game.gui_size.y, game.gui_scale);
+
+        // five seconds at 60 fps, enough to cover a menu opening or a hud layout change
+        auto& capture = ev.renderer.get_capture();
+        if (capture.active()) {
+            ImGui::Text("capturing, %u frames left", capture.get_remaining());
+        }
+        else if (ImGui::Button("capture draw data")) {
+            capture.start(selaura::instance::get()->get_data_folder() / "captures" / "draws.bin", 300);
+        }
+
+        if (ImGui::BeginTable("scopes", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+            ImGui::TableSetupColumn("scope");
+            ImGui::TableSetupColumn("p50 (us)");
+            ImGui::TableSetupColumn("p99 (us)");
+            ImGui::TableSetupColumn("samples");
+            ImGui::TableHeadersRow();
+
+            for (const auto& entry : profiler::snapshot(ev.arena)) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(entry.name.data(), entry.name.data() + entry.name.size());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", entry.p50_us);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", entry.p99_us);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", entry.samples);
+            }
+
+            ImGui::EndTable();
+        }
+
+        bool hooks = profiler::hook_stats_enabled.load(std::memory_order_relaxed);
+        if (ImGui::Checkbox("hook stats", &hooks)) profiler::hook_stats_enabled.store(hooks, std::memory_order_relaxed);
+
+        if (hooks && ImGui::BeginTable("hooks", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+            ImGui::TableSetupColumn("hook");
+            ImGui::TableSetupColumn("calls");
+            ImGui::TableSetupColumn("before avg");
+            ImGui::TableSetupColumn("before p99");
+            ImGui::TableSetupColumn("after avg");
+            ImGui::TableSetupColumn("after p99");
+            ImGui::TableHeadersRow();
+
+            for (const auto& entry : profiler::hook_snapshot(ev.arena)) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(entry.name.data(), entry.name.data() + entry.name.size());
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(entry.calls));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", entry.before_avg_us);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", entry.before_p99_us);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", entry.after_avg_us);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", entry.after_p99_us);
+            }
+
+            ImGui::EndTable();
+        }
+
+        if (ImGui::BeginTable("memory", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+            ImGui::TableSetupColumn("memory");
+            ImGui::TableSetupColumn("live (KiB)");
+            ImGui::TableSetupColumn("peak (KiB)");
+            ImGui::TableSetupColumn("budget (MiB)");
+            ImGui::TableHeadersRow();
+
+            const auto usage = memory::snapshot();
+            for (std::size_t i = 0; i < usage.size(); i++) {
+                const auto& entry = usage[i];
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(entry.name.data(), entry.name.data() + entry.name.size());
+                ImGui::TableNextColumn();
+                if (entry.budget != 0 && entry.live > entry.budget) ImGui::TextColored({ 1.0f, 0.4f, 0.4f, 1.0f }, "%.1f", entry.live / 1024.0);
+                else ImGui::Text("%.1f", entry.live / 1024.0);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", entry.peak / 1024.0);
+                ImGui::TableNextColumn();
+
+                // 0 turns the warning off for that subsystem
+                int budget_mib = static_cast<int>(entry.budget >> 20);
+                ImGui::PushID(static_cast<int>(i));
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::DragInt("##budget", &budget_mib, 1.0f, 0, 1024)) memory::set_budget(static_cast<memory::tag>(i), static_cast<std::size_t>(budget_mib) << 20);
+                ImGui::PopID();
+            }
+
+            ImGui::EndTable();
+        }
+
+        const auto scripts = selaura::get_component<selaura::script_manager>().get_scripts();
+        if (!scripts.empty() && ImGui::BeginTable("scripts", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+            ImGui::TableSetupColumn("script");
+            ImGui::TableSetupColumn("avg (us)");
+            ImGui::TableSetupColumn("peak (us)");
+            ImGui::TableSetupColumn("overruns");
+            ImGui::TableHeadersRow();
+
+            for (const auto& loaded : scripts) {
+                const auto& stats = loaded->get_stats();
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(loaded->get_name().c_str());
+                if (loaded->get_state() == script_state::suspended) {
+                    ImGui::SameLine();
+                    ImGui::TextUnformatted("(suspended)");
+                }
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", stats.average_us());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", stats.peak_us());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", stats.overruns);
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+#endif
+    }
+};
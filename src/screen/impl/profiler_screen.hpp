@@ -0,0 +1,12 @@
+#pragma once
+#include "../screen.hpp"
+
+namespace selaura {
+    struct profiler_screen : public screen {
+        DEFINE_SCREEN_TRAITS("Profiler");
+
+        profiler_screen();
+
+        void on_render(selaura::setupandrender_event& ev) override;
+    };
+};
@@ -1,12 +1,42 @@
 #include "screen.hpp"
+#include "../instance.hpp"
+#include "../hook/impl/render_hooks.hpp"
+
+#include <algorithm>
 
 namespace selaura {
+    screen::screen() {
+        this->listen(&screen::render);
+    }
+
     screen::~screen() noexcept {
         this->enabled = false;
     }
 
     void screen::set_enabled(bool enabled) {
+        if (this->enabled == enabled) return;
         this->enabled = enabled;
+        selaura::get_component<selaura::screen_manager>().set_capturing(this->capture_bit, enabled);
+
+        auto& renderer = selaura::get_component<selaura::renderer>();
+        renderer.get_pacer().invalidate();
+        if (enabled) renderer.get_layers().want(this->layers);
+        else renderer.get_layers().release(this->layers);
+
+        auto& hooks = selaura::get_component<selaura::hook_manager>();
+        for (const auto& dependency : this->hooks) {
+            if (enabled) hooks.acquire(dependency);
+            else hooks.release(dependency);
+        }
+
+        if (enabled) {
+            this->bindings.attach(selaura::get_component<selaura::event_manager>());
+            this->on_enable();
+        }
+        else {
+            this->bindings.detach();
+            this->on_disable();
+        }
     }
 
     bool screen::is_enabled() const {
@@ -14,10 +44,12 @@ namespace selaura {
     }
 
     void screen::toggle() {
-        this->enabled = !this->enabled;
+        this->set_enabled(!this->enabled);
     }
 
     void screen::set_hotkey(selaura::key hotkey) {
+        if (this->hotkey == hotkey) return;
+        selaura::get_component<selaura::input_manager>().get_hotkeys().bind(this->hotkey, hotkey, { nullptr, this });
         this->hotkey = hotkey;
     }
 
@@ -25,7 +57,40 @@ namespace selaura {
         return this->hotkey;
     }
 
+    std::span<const layer_hash> screen::get_layers() const {
+        return this->layers;
+    }
+
+    void screen::draw_on(std::string_view layer) {
+        const layer_hash hash = HashedString::fnv1a_64(layer);
+        if (std::ranges::find(this->layers, hash) != this->layers.end()) return;
+        this->layers.push_back(hash);
+        if (this->enabled) selaura::get_component<selaura::renderer>().get_layers().want({ &hash, 1 });
+        this->require_hooks<render_hooks>();
+    }
+
+    void screen::require_hooks(const hook_dependency& dependency) {
+        if (std::ranges::find(this->hooks, dependency) != this->hooks.end()) return;
+        this->hooks.push_back(dependency);
+        if (this->enabled) selaura::get_component<selaura::hook_manager>().acquire(dependency);
+    }
+
+#if defined(SELAURA_PROFILING)
+    void screen::set_profile_scope(std::uint32_t id) {
+        this->profile_scope = id;
+    }
+#endif
+
+    void screen::render(selaura::setupandrender_event& ev) {
+        if (!ev.renderer.layers_visible(this->layers)) return;
+#if defined(SELAURA_PROFILING)
+        profiler::scope_timer timer{ this->profile_scope };
+#endif
+        this->on_render(ev);
+    }
+
     void screen::on_enable() {}
     void screen::on_disable() {}
+    void screen::on_layers_hidden() {}
     void screen::on_render(selaura::setupandrender_event& ev) {}
 };
\ No newline at end of file
@@ -3,10 +3,16 @@
 #include <vector>
 #include <string>
 #include <variant>
+#include <span>
+#include <string_view>
 
 #include <glm/glm.hpp>
 #include <libhat/fixed_string.hpp>
 #include "../event/event_manager.hpp"
+#include "../event/event_bindings.hpp"
+#include "../profiler/profiler.hpp"
+#include "../renderer/render_layers.hpp"
+#include "../hook/hook_dependency.hpp"
 
 namespace selaura {
 	template <hat::fixed_string name_str = "String Not Found">
@@ -18,12 +24,14 @@ namespace selaura {
 
 	struct screen {
 		using info = screen_traits<>;
-		screen() = default;
+		screen();
 		virtual ~screen() noexcept;
 
 		virtual void on_disable();
 		virtual void on_enable();
 		virtual void on_render(selaura::setupandrender_event& ev);
+		// enabled, but none of the layers it draws on has been shown for a frame
+		virtual void on_layers_hidden();
 
 		void set_enabled(bool enabled = true);
 		bool is_enabled() const;
@@ -32,8 +40,44 @@ namespace selaura {
 		void set_hotkey(selaura::key hotkey);
 		selaura::key get_hotkey() const;
 
+		std::span<const layer_hash> get_layers() const;
+
+#if defined(SELAURA_PROFILING)
+		void set_profile_scope(std::uint32_t id);
+#endif
+
+	protected:
+		// handlers are only subscribed while the screen is enabled, on_render is always bound
+		template <typename T, typename C>
+		void listen(void (C::*handler)(T&), listener_options options = {}) {
+			bindings.add<T>([this, handler](T& ev) { (static_cast<C*>(this)->*handler)(ev); }, options);
+		}
+
+		// root layer names (hud_screen, start_screen, ...) the screen renders on, views showing none of them are skipped
+		void draw_on(std::string_view layer);
+
+		// hook groups held while enabled, draw_on already brings in the render hooks
+		void require_hooks(const hook_dependency& dependency);
+
+		template <typename group_t>
+		void require_hooks() {
+			this->require_hooks(hook_dependency::of<group_t>());
+		}
+
 	private:
+		friend struct screen_manager;
+
+		void render(selaura::setupandrender_event& ev);
+
 		bool enabled = false;
-		selaura::key hotkey;
+		event_bindings bindings;
+#if defined(SELAURA_PROFILING)
+		std::uint32_t profile_scope = profiler::frame_scope;
+#endif
+		selaura::key hotkey = selaura::key::None;
+		std::vector<layer_hash> layers;
+		std::vector<hook_dependency> hooks;
+		// this screen's bit in screen_manager's capture mask
+		std::uint64_t capture_bit = 0;
 	};
 }
\ No newline at end of file
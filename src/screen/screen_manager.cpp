@@ -0,0 +1,23 @@
+#include "screen_manager.hpp"
+#include "../instance.hpp"
+
+namespace selaura {
+    void screen_manager::init() {
+        add_screen<selaura::click_gui>();
+        // kept in release builds, release builds are the ones the overhead number is for
+        add_screen<selaura::benchmark_screen>();
+#if defined(SELAURA_PROFILING)
+        add_screen<selaura::profiler_screen>();
+#endif
+
+        selaura::get_component<selaura::event_manager>().subscribe<minecraftgame_update_event>(&screen_manager::on_update, this);
+    }
+
+    void screen_manager::on_update(minecraftgame_update_event& ev) {
+        auto& renderer = selaura::get_component<selaura::renderer>();
+
+        for (auto* scr : screens.all()) {
+            if (scr->is_enabled() && !renderer.layers_visible(scr->get_layers())) scr->on_layers_hidden();
+        }
+    }
+}
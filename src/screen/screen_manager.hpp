@@ -4,47 +4,68 @@
 #include <string_view>
 #include <type_traits>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 
 #include "screen.hpp"
 #include "impl/click_gui.hpp"
+#include "impl/profiler_screen.hpp"
+#include "impl/benchmark_screen.hpp"
+#include "../profiler/profiler.hpp"
+#include "../util/type_registry.hpp"
 
 namespace selaura {
     struct screen_manager {
         screen_manager() = default;
+        screen_manager(const screen_manager&) = delete;
+        screen_manager& operator=(const screen_manager&) = delete;
 
-        void init() {
-            add_screen<selaura::click_gui>();
-        }
+        void init();
 
         template <typename T, typename... Args>
         T* add_screen(Args&&... args) {
             static_assert(std::is_base_of_v<screen, T>, "T must derive from screen");
-            auto ptr = std::make_unique<T>(std::forward<Args>(args)...);
-            T* raw_ptr = ptr.get();
-            screens.emplace_back(std::move(ptr));
+            if (T* existing = screens.get<T>())
+                return existing;
+
+            T* raw_ptr = screens.emplace<T>(std::forward<Args>(args)...);
+            raw_ptr->capture_bit = std::uint64_t{ 1 } << ((screens.size() - 1) % 64);
+#if defined(SELAURA_PROFILING)
+            raw_ptr->set_profile_scope(profiler::register_scope(std::string_view(T::info::name.c_str(), T::info::name.size())));
+#endif
             return raw_ptr;
         }
 
         void for_each(auto&& callback) {
-            for (auto& scr : screens)
+            for (auto* scr : screens.all())
                 callback(*scr);
         }
 
         void for_each(auto&& callback) const {
-            for (const auto& scr : screens)
+            for (const auto* scr : screens.all())
                 callback(*scr);
         }
 
         template <typename T>
         T* get() {
-            for (auto& scr : screens) {
-                if (auto* casted = dynamic_cast<T*>(scr.get()))
-                    return casted;
-            }
-            return nullptr;
+            return screens.get<T>();
+        }
+
+        // safe from any thread, the input dispatcher uses it to swallow keys while a screen is open
+        bool captures_input() const {
+            return capturing.load(std::memory_order_acquire) != 0;
+        }
+
+        void set_capturing(std::uint64_t bit, bool enabled) {
+            if (enabled) capturing.fetch_or(bit, std::memory_order_release);
+            else capturing.fetch_and(~bit, std::memory_order_release);
         }
 
     private:
-        std::vector<std::unique_ptr<screen>> screens;
+        // closes screens whose layers the game stopped showing, views drawing nothing never reach screen code
+        void on_update(minecraftgame_update_event& ev);
+
+        type_registry<screen> screens;
+        std::atomic<std::uint64_t> capturing{ 0 };
     };
 }
@@ -0,0 +1,129 @@
+#include "draw_batch.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace selaura {
+	namespace {
+		// plain c functions rather than luabridge wrappers, recording a primitive is a handful of stack reads
+		// every argument is read before the slot is taken, a bad one raises with the batch left as it was
+		void push(lua_State* L, draw_batch::kind type, float radius, float param) {
+			draw_batch* batch = draw_batch::check(L, 1);
+			const float x = static_cast<float>(luaL_checknumber(L, 2));
+			const float y = static_cast<float>(luaL_checknumber(L, 3));
+			const float w = static_cast<float>(luaL_checknumber(L, 4));
+			const float h = static_cast<float>(luaL_checknumber(L, 5));
+			const auto color = static_cast<ImU32>(luaL_checkinteger(L, 6));
+
+			if (batch->count == batch->capacity) luaL_error(L, "batch is full (%d primitives)", static_cast<int>(batch->capacity));
+
+			batch->count++;
+			auto& item = batch->items().back();
+			item.min = { x, y };
+			item.max = { x + w, y + h };
+			item.color = color;
+			item.radius = radius;
+			item.param = param;
+			item.type = type;
+		}
+
+		// batch:rect(x, y, w, h, color, stroke = 1, radius = 0)
+		int batch_rect(lua_State* L) {
+			const auto stroke = static_cast<float>(luaL_optnumber(L, 7, 1.0));
+			const auto radius = static_cast<float>(luaL_optnumber(L, 8, 0.0));
+			push(L, draw_batch::kind::rect, radius, stroke);
+			return 0;
+		}
+
+		// batch:fill(x, y, w, h, color, radius = 0)
+		int batch_fill(lua_State* L) {
+			const auto radius = static_cast<float>(luaL_optnumber(L, 7, 0.0));
+			push(L, draw_batch::kind::fill, radius, 0.0f);
+			return 0;
+		}
+
+		// batch:shadow(x, y, w, h, color, radius, blur)
+		int batch_shadow(lua_State* L) {
+			const auto radius = static_cast<float>(luaL_checknumber(L, 7));
+			const auto blur = static_cast<float>(luaL_checknumber(L, 8));
+			push(L, draw_batch::kind::shadow, radius, blur);
+			return 0;
+		}
+
+		int batch_clear(lua_State* L) {
+			draw_batch::check(L, 1)->count = 0;
+			return 0;
+		}
+
+		int batch_len(lua_State* L) {
+			lua_pushinteger(L, draw_batch::check(L, 1)->count);
+			return 1;
+		}
+
+		// selaura.batch(capacity = 256), the userdata is sized up front so recording never allocates
+		int new_batch(lua_State* L) {
+			const lua_Integer requested = luaL_optinteger(L, 1, 256);
+			luaL_argcheck(L, requested > 0 && requested <= draw_batch::max_capacity, 1, "capacity out of range");
+
+			const auto capacity = static_cast<std::uint32_t>(requested);
+			void* memory = lua_newuserdatauv(L, sizeof(draw_batch) + capacity * sizeof(draw_batch::primitive), 0);
+			new (memory) draw_batch{ capacity, 0 };
+
+			luaL_setmetatable(L, draw_batch::metatable);
+			return 1;
+		}
+
+		// selaura.color(r, g, b, a = 255), components are 0 to 255 like the rest of the drawing api
+		int pack_color(lua_State* L) {
+			auto component = [&](int index, lua_Number fallback) {
+				return static_cast<ImU32>(std::clamp(luaL_optnumber(L, index, fallback), lua_Number{ 0 }, lua_Number{ 255 }));
+			};
+			lua_pushinteger(L, IM_COL32(component(1, 0), component(2, 0), component(3, 0), component(4, 255)));
+			return 1;
+		}
+	}
+
+	draw_batch* draw_batch::check(lua_State* L, int index) {
+		return static_cast<draw_batch*>(luaL_checkudata(L, index, metatable));
+	}
+
+	void draw_batch::submit(ImDrawList* list, const shape_atlas& shapes) const {
+		for (const primitive& item : this->items()) {
+			switch (item.type) {
+			case kind::rect:
+				list->AddRect(item.min, item.max, item.color, item.radius, 0, item.param);
+				break;
+			case kind::fill:
+				shapes.fill_rect(list, item.min, item.max, item.color, item.radius);
+				break;
+			case kind::shadow:
+				shapes.shadow_rect(list, item.min, item.max, item.color, item.radius, item.param);
+				break;
+			}
+		}
+	}
+
+	void draw_batch::bind(lua_State* L, lua_CFunction submit_fn) {
+		const luaL_Reg methods[] = {
+			{ "rect", &batch_rect },
+			{ "fill", &batch_fill },
+			{ "shadow", &batch_shadow },
+			{ "clear", &batch_clear },
+			{ "submit", submit_fn },
+			{ nullptr, nullptr }
+		};
+
+		luaL_newmetatable(L, metatable);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, -2, "__index");
+		lua_pushcfunction(L, &batch_len);
+		lua_setfield(L, -2, "__len");
+		luaL_setfuncs(L, methods, 0);
+		lua_pop(L, 1);
+
+		lua_pushcfunction(L, &new_batch);
+		lua_setfield(L, -2, "batch");
+		lua_pushcfunction(L, &pack_color);
+		lua_setfield(L, -2, "color");
+	}
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <span>
+
+#include <imgui.h>
+#include "lua.hpp"
+#include "../renderer/shape_atlas.hpp"
+
+namespace selaura {
+	// primitives a script records into a userdata of its own and draws with one call
+	// the primitives live inline in the userdata, submit reads them in place and nothing is marshalled per primitive
+	// a batch keeps its contents until cleared, a static overlay is filled once and submitted every frame
+	struct draw_batch {
+		static constexpr const char* metatable = "selaura.batch";
+		static constexpr std::uint32_t max_capacity = 65536;
+
+		enum class kind : std::uint8_t {
+			rect,
+			fill,
+			shadow
+		};
+
+		// param is the stroke width of a rect and the blur of a shadow
+		struct primitive {
+			ImVec2 min;
+			ImVec2 max;
+			ImU32 color;
+			float radius;
+			float param;
+			kind type;
+		};
+
+		std::uint32_t capacity;
+		std::uint32_t count;
+
+		std::span<primitive> items() {
+			return { reinterpret_cast<primitive*>(this + 1), this->count };
+		}
+
+		std::span<const primitive> items() const {
+			return { reinterpret_cast<const primitive*>(this + 1), this->count };
+		}
+
+		void submit(ImDrawList* list, const shape_atlas& shapes) const;
+
+		// the batch metatable and selaura.batch(capacity), selaura.color(r, g, b, a) and batch:submit from submit_fn
+		// expects the selaura table on top of the stack
+		static void bind(lua_State* L, lua_CFunction submit_fn);
+		// the batch at index, raises a lua error if it is anything else
+		static draw_batch* check(lua_State* L, int index);
+	};
+
+	static_assert(alignof(draw_batch::primitive) <= alignof(draw_batch) && sizeof(draw_batch) % alignof(draw_batch::primitive) == 0, "primitives follow the header directly");
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+// lua is built as c, luabridge expects the headers to already be included
+extern "C" {
+#include <lua.h>
+#include <lualib.h>
+#include <lauxlib.h>
+}
+
+#include <LuaBridge/LuaBridge.h>
@@ -0,0 +1,487 @@
+#include "script.hpp"
+#include "draw_batch.hpp"
+#include "../instance.hpp"
+#include "../profiler/memory.hpp"
+#include "../sdk/mc/HashedString.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace selaura {
+	namespace {
+		// instructions between budget checks, small enough that a tight loop can't run long past its deadline
+		constexpr int hook_interval = 1000;
+
+		constexpr std::uint32_t cache_magic = 0x4342534C; // "LSBC"
+
+		// bytecode is only reused when the source it was compiled from is unchanged
+		struct cache_header {
+			std::uint32_t magic;
+			std::uint32_t lua_version;
+			std::int64_t mtime;
+			std::uint64_t hash;
+		};
+
+		// selaura.sleep(ms) and selaura.next_frame(), both just yield back to run_coroutine
+		int lua_sleep(lua_State* L) {
+			luaL_checkinteger(L, 1);
+			if (!lua_isyieldable(L)) return luaL_error(L, "selaura.sleep can only be called from selaura.spawn");
+			lua_settop(L, 1);
+			return lua_yield(L, 1);
+		}
+
+		int lua_next_frame(lua_State* L) {
+			if (!lua_isyieldable(L)) return luaL_error(L, "selaura.next_frame can only be called from selaura.spawn");
+			return lua_yield(L, 0);
+		}
+
+		// load with its mode pinned to text, precompiled bytecode is unchecked and can escape the sandbox
+		int lua_load_text(lua_State* L) {
+			// an explicit nil env is not the same as none, only pass one along when the script did
+			const int args = lua_gettop(L) >= 4 ? 4 : 3;
+			lua_settop(L, args);
+			lua_pushliteral(L, "t");
+			lua_replace(L, 3);
+
+			lua_pushvalue(L, lua_upvalueindex(1));
+			lua_insert(L, 1);
+			lua_call(L, args, LUA_MULTRET);
+			return lua_gettop(L);
+		}
+
+		int write_chunk(lua_State* L, const void* data, size_t size, void* user) {
+			auto* out = static_cast<std::vector<char>*>(user);
+			out->insert(out->end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+			return 0;
+		}
+	}
+
+	script::script(std::filesystem::path path, std::shared_ptr<spdlog::logger> logger, const script_budget& budget)
+		: path(std::move(path)), logger(std::move(logger)), budget(budget) {
+		this->name = this->path.filename().string();
+		this->state = luaL_newstate();
+
+		// luaL_newstate keeps its panic and warning handlers, from here on every block is counted against scripting
+		// the allocators are interchangeable, both end in realloc and free, so what the state holds so far is counted up front
+		memory::track(memory::tag::scripting, static_cast<std::size_t>(lua_gc(this->state, LUA_GCCOUNT)) * 1024 + lua_gc(this->state, LUA_GCCOUNTB));
+		lua_setallocf(this->state, &memory::lua_alloc, nullptr);
+
+		// coroutines copy the extra space and the hook from the main thread, so they are budgeted too
+		*static_cast<script**>(lua_getextraspace(this->state)) = this;
+		lua_sethook(this->state, &script::count_hook, LUA_MASKCOUNT, hook_interval);
+
+		this->open_libraries();
+		this->bind_api();
+	}
+
+	script::script(std::filesystem::path path, std::span<const std::byte> source, std::shared_ptr<spdlog::logger> logger, const script_budget& budget)
+		: script(std::move(path), std::move(logger), budget) {
+		this->bundled = source;
+	}
+
+	script::~script() {
+		// handlers hold registry references, drop them and the subscriptions before the state goes away
+		this->bindings.detach();
+		if (this->installed) selaura::get_component<selaura::task_scheduler>().cancel(this);
+		this->update_handlers.clear();
+		this->render_handlers.clear();
+		this->key_handlers.clear();
+		lua_close(this->state);
+	}
+
+	const std::string& script::get_name() const {
+		return this->name;
+	}
+
+	const std::filesystem::path& script::get_path() const {
+		return this->path;
+	}
+
+	const script_stats& script::get_stats() const {
+		return this->stats;
+	}
+
+	script_state script::get_state() const {
+		return this->run_state;
+	}
+
+	bool script::draws() const {
+		// coroutines resume from frames, without the render hooks and the layer they would never run
+		return !this->render_handlers.empty() || this->live_coroutines != 0;
+	}
+
+	void script::count_hook(lua_State* L, lua_Debug* ar) {
+		auto* self = *static_cast<script**>(lua_getextraspace(L));
+		self->frame_instructions += hook_interval;
+
+		if (self->frame_instructions > self->instruction_limit || std::chrono::steady_clock::now() > self->deadline) {
+			self->frame_overran = true;
+			luaL_error(L, "script exceeded its budget");
+		}
+	}
+
+	bool script::can_run() const {
+		return this->run_state == script_state::running && !this->frame_overran;
+	}
+
+	template <typename... Args>
+	luabridge::LuaResult script::call(const luabridge::LuaRef& handler, Args&&... args) {
+		const auto start = std::chrono::steady_clock::now();
+		const auto remaining = this->budget.frame_time - std::chrono::nanoseconds(this->frame_ns);
+		this->deadline = start + remaining;
+		this->instruction_limit = this->budget.frame_instructions;
+
+		auto result = handler(std::forward<Args>(args)...);
+
+		this->frame_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		return result;
+	}
+
+	void script::begin_frame() {
+		if (this->run_state == script_state::suspended) return;
+
+		if (this->frame_ns > 0) {
+			this->stats.frames++;
+			this->stats.total_ns += this->frame_ns;
+			this->stats.peak_ns = std::max(this->stats.peak_ns, this->frame_ns);
+		}
+
+		if (this->frame_overran) {
+			this->stats.overruns++;
+			this->consecutive_overruns++;
+
+			if (this->consecutive_overruns >= this->budget.max_overruns) {
+				this->run_state = script_state::suspended;
+				this->bindings.detach();
+				this->logger->error("[{}] suspended after {} consecutive overruns (avg {:.1f}us, peak {:.1f}us)", this->name, this->consecutive_overruns, this->stats.average_us(), this->stats.peak_us());
+			}
+			else {
+				// back off exponentially, a script that keeps overrunning gets fewer frames to do it in
+				this->run_state = script_state::throttled;
+				this->throttle_frames = 1u << this->consecutive_overruns;
+				this->logger->warn("[{}] overran its frame budget ({:.1f}us, {} instructions), skipping {} frames", this->name, this->frame_ns / 1000.0, this->frame_instructions, this->throttle_frames);
+			}
+		}
+		else if (this->run_state == script_state::throttled) {
+			if (--this->throttle_frames == 0) this->run_state = script_state::running;
+		}
+		else if (this->frame_ns > 0) {
+			this->consecutive_overruns = 0;
+		}
+
+		this->frame_ns = 0;
+		this->frame_instructions = 0;
+		this->frame_overran = false;
+	}
+
+	void script::open_libraries() {
+		// no io, os, package or debug, scripts only get what they can't escape the sandbox with
+		const std::pair<const char*, lua_CFunction> libraries[] = {
+			{ LUA_GNAME, luaopen_base },
+			{ LUA_TABLIBNAME, luaopen_table },
+			{ LUA_STRLIBNAME, luaopen_string },
+			{ LUA_MATHLIBNAME, luaopen_math },
+			{ LUA_UTF8LIBNAME, luaopen_utf8 },
+			{ LUA_COLIBNAME, luaopen_coroutine },
+		};
+
+		for (const auto& [library, open] : libraries) {
+			luaL_requiref(this->state, library, open, 1);
+			lua_pop(this->state, 1);
+		}
+
+		for (const char* global : { "dofile", "loadfile" }) {
+			lua_pushnil(this->state);
+			lua_setglobal(this->state, global);
+		}
+
+		lua_getglobal(this->state, "load");
+		lua_pushcclosure(this->state, &lua_load_text, 1);
+		lua_setglobal(this->state, "load");
+
+		// string.dump is the other half, without it a script can't produce bytecode to begin with
+		lua_getglobal(this->state, LUA_STRLIBNAME);
+		lua_pushnil(this->state);
+		lua_setfield(this->state, -2, "dump");
+		lua_pop(this->state, 1);
+	}
+
+	void script::bind_api() {
+		luabridge::getGlobalNamespace(this->state)
+			.beginNamespace("selaura")
+				.addFunction("log", [this](const std::string& message) {
+					this->logger->info("[{}] {}", this->name, message);
+				})
+				.addFunction("on", [this](const std::string& event, luabridge::LuaRef handler) {
+					this->on(event, std::move(handler));
+				})
+				.addFunction("spawn", [this](luabridge::LuaRef function) {
+					this->spawn(std::move(function));
+				})
+				.addFunction("draw_rect", [this](float x, float y, float w, float h, float r, float g, float b, float a, float stroke, float radius) {
+					if (!this->in_render) return;
+					selaura::get_component<selaura::renderer>().draw_rect({ x, y }, { w, h }, glm::vec4{ r, g, b, a }, stroke, radius);
+				})
+				.addFunction("fill_rect", [this](float x, float y, float w, float h, float r, float g, float b, float a, float radius) {
+					if (!this->in_render) return;
+					selaura::get_component<selaura::renderer>().draw_filled_rect({ x, y }, { w, h }, glm::vec4{ r, g, b, a }, radius);
+				})
+				.addFunction("draw_shadow", [this](float x, float y, float w, float h, float r, float g, float b, float a, float radius, float blur) {
+					if (!this->in_render) return;
+					selaura::get_component<selaura::renderer>().draw_shadow({ x, y }, { w, h }, glm::vec4{ r, g, b, a }, radius, blur);
+				})
+			.endNamespace();
+
+		// these yield, which luabridge wrappers can't do, so they are plain c functions, batches skip luabridge to stay cheap per primitive
+		lua_getglobal(this->state, "selaura");
+		lua_pushcfunction(this->state, &lua_sleep);
+		lua_setfield(this->state, -2, "sleep");
+		lua_pushcfunction(this->state, &lua_next_frame);
+		lua_setfield(this->state, -2, "next_frame");
+		draw_batch::bind(this->state, &script::submit_batch);
+		lua_pop(this->state, 1);
+	}
+
+	int script::submit_batch(lua_State* L) {
+		const draw_batch* batch = draw_batch::check(L, 1);
+		const auto* self = *static_cast<script**>(lua_getextraspace(L));
+		if (!self->in_render) return 0;
+
+		batch->submit(ImGui::GetBackgroundDrawList(), selaura::get_component<selaura::renderer>().get_shapes());
+		return 0;
+	}
+
+	void script::spawn(luabridge::LuaRef function) {
+		if (!function.isFunction()) {
+			this->logger->error("[{}] selaura.spawn expects a function", this->name);
+			return;
+		}
+
+		// the thread is anchored in the registry until the coroutine finishes
+		lua_State* thread = lua_newthread(this->state);
+		const int ref = luaL_ref(this->state, LUA_REGISTRYINDEX);
+		function.push(thread);
+		this->live_coroutines++;
+
+		if (!this->installed) {
+			this->pending_coroutines.emplace_back(thread, ref);
+			return;
+		}
+
+		selaura::get_component<selaura::task_scheduler>().spawn(this->run_coroutine(thread, ref), this);
+	}
+
+	task script::run_coroutine(lua_State* thread, int ref) {
+		std::chrono::milliseconds delay{ 0 };
+
+		while (true) {
+			if (delay.count() > 0) co_await sleep_for(delay);
+
+			// always resume from a frame so the coroutine can draw, and never inside the handler that spawned it
+			co_await next_frame();
+			if (this->run_state == script_state::suspended) break;
+			if (!this->can_run()) continue;
+
+			int results = 0;
+			const int status = this->resume(thread, results);
+
+			if (status == LUA_YIELD) {
+				delay = std::chrono::milliseconds(results > 0 ? lua_tointeger(thread, -1) : 0);
+				lua_pop(thread, results);
+				continue;
+			}
+
+			// an overrun kills the coroutine as well, begin_frame already reports it
+			if (status != LUA_OK && !this->frame_overran) {
+				this->logger->error("[{}] coroutine failed: {}", this->name, lua_tostring(thread, -1));
+			}
+			break;
+		}
+
+		luaL_unref(this->state, LUA_REGISTRYINDEX, ref);
+		this->live_coroutines--;
+	}
+
+	int script::resume(lua_State* thread, int& results) {
+		const auto start = std::chrono::steady_clock::now();
+		this->deadline = start + (this->budget.frame_time - std::chrono::nanoseconds(this->frame_ns));
+		this->instruction_limit = this->budget.frame_instructions;
+
+		// drawing is only allowed when this is a next_frame resume and the hud the scripts draw on is showing
+		this->in_render = selaura::get_component<selaura::task_scheduler>().in_frame()
+			&& selaura::get_component<selaura::renderer>().layers_visible({ &script_layer, 1 });
+		const int status = lua_resume(thread, this->state, 0, &results);
+		this->in_render = false;
+
+		this->frame_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		return status;
+	}
+
+	void script::install() {
+		this->installed = true;
+		this->bindings.attach(selaura::get_component<selaura::event_manager>());
+
+		for (const auto& [thread, ref] : this->pending_coroutines) {
+			selaura::get_component<selaura::task_scheduler>().spawn(this->run_coroutine(thread, ref), this);
+		}
+		this->pending_coroutines.clear();
+	}
+
+	bool script::load_cached(const std::filesystem::path& cache_file, std::int64_t mtime, std::uint64_t hash) {
+		std::ifstream file(cache_file, std::ios::binary);
+		if (!file) return false;
+
+		cache_header header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!file || header.magic != cache_magic || header.lua_version != LUA_VERSION_NUM || header.mtime != mtime || header.hash != hash) return false;
+
+		const std::string bytecode{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+		// lua checks its own header too, a chunk from an incompatible build just falls back to the source
+		const std::string chunk_name = "@" + this->name;
+		if (luaL_loadbufferx(this->state, bytecode.data(), bytecode.size(), chunk_name.c_str(), "b") != LUA_OK) {
+			lua_pop(this->state, 1);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool script::compile(std::string_view code, const std::filesystem::path& cache_file, std::int64_t mtime, std::uint64_t hash) {
+		const std::string chunk_name = "@" + this->name;
+		if (luaL_loadbufferx(this->state, code.data(), code.size(), chunk_name.c_str(), "t") != LUA_OK) return false;
+
+		// debug info is kept so errors from cached chunks still carry line numbers
+		std::vector<char> bytecode;
+		if (lua_dump(this->state, &write_chunk, &bytecode, 0) != 0) return true;
+
+		const cache_header header{ cache_magic, LUA_VERSION_NUM, mtime, hash };
+		auto temp_file = cache_file;
+		temp_file += ".tmp";
+		{
+			std::ofstream file(temp_file, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(temp_file, cache_file, ec);
+		if (ec) this->logger->warn("[{}] failed to cache bytecode: {}", this->name, ec.message());
+
+		return true;
+	}
+
+	bool script::load(const std::filesystem::path& cache_folder) {
+		// bundled sources have no mtime of their own, the hash alone decides whether the cache matches
+		std::string loose;
+		std::string_view code{ reinterpret_cast<const char*>(this->bundled.data()), this->bundled.size() };
+		std::int64_t mtime = 0;
+		if (this->bundled.empty()) {
+			std::ifstream file(this->path, std::ios::binary);
+			std::stringstream source;
+			source << file.rdbuf();
+			loose = source.str();
+			code = loose;
+
+			std::error_code ec;
+			mtime = std::filesystem::last_write_time(this->path, ec).time_since_epoch().count();
+		}
+
+		const std::uint64_t hash = HashedString::fnv1a_64(code);
+		const auto cache_file = cache_folder / (this->name + "c");
+
+		this->deadline = std::chrono::steady_clock::now() + this->budget.load_time;
+		this->instruction_limit = UINT64_MAX;
+
+		const bool cached = this->load_cached(cache_file, mtime, hash);
+		if (cached) this->logger->debug("[{}] using cached bytecode", this->name);
+
+		const bool loaded = (cached || this->compile(code, cache_file, mtime, hash)) && lua_pcall(this->state, 0, 0, 0) == LUA_OK;
+
+		// loading isn't charged to the first frame
+		this->frame_instructions = 0;
+		this->frame_overran = false;
+
+		if (!loaded) {
+			this->logger->error("[{}] {}", this->name, lua_tostring(this->state, -1));
+			lua_pop(this->state, 1);
+			return false;
+		}
+
+		return true;
+	}
+
+	void script::on(const std::string& event, luabridge::LuaRef handler) {
+		if (!handler.isFunction()) {
+			this->logger->error("[{}] selaura.on(\"{}\") expects a function", this->name, event);
+			return;
+		}
+
+		if (event == "update") {
+			if (this->update_handlers.empty()) this->bindings.add<minecraftgame_update_event>([this](auto& ev) { this->handle_update(ev); });
+			this->update_handlers.push_back(std::move(handler));
+		}
+		else if (event == "render") {
+			if (this->render_handlers.empty()) this->bindings.add<setupandrender_event>([this](auto& ev) { this->handle_render(ev); });
+			this->render_handlers.push_back(std::move(handler));
+		}
+		else if (event == "key") {
+			if (this->key_handlers.empty()) this->bindings.add<key_event>([this](auto& ev) { this->handle_key(ev); });
+			this->key_handlers.push_back(std::move(handler));
+		}
+		else {
+			this->logger->error("[{}] unknown event \"{}\"", this->name, event);
+		}
+	}
+
+	bool script::report(const luabridge::LuaResult& result, std::string_view event) {
+		// an overrun aborts the call but keeps the handler, begin_frame decides what happens to the script
+		if (result.wasOk() || this->frame_overran) return true;
+		this->logger->error("[{}] {} handler failed: {}", this->name, event, result.errorMessage());
+		return false;
+	}
+
+	template <typename F>
+	void script::run_handlers(std::vector<luabridge::LuaRef>& handlers, F&& invoke) {
+		// by index over a copy of each ref, a handler may call selaura.on and grow the list while it runs
+		// handlers added that way first run on the next pass, the ones that failed are dropped once this one is over
+		const std::size_t count = handlers.size();
+		std::vector<std::size_t> failed;
+		for (std::size_t i = 0; i < count && this->can_run(); i++) {
+			const luabridge::LuaRef handler = handlers[i];
+			if (!invoke(handler)) failed.push_back(i);
+		}
+
+		for (auto it = failed.rbegin(); it != failed.rend(); ++it) {
+			handlers.erase(handlers.begin() + static_cast<std::ptrdiff_t>(*it));
+		}
+	}
+
+	void script::handle_update(minecraftgame_update_event& ev) {
+		this->run_handlers(this->update_handlers, [&](const luabridge::LuaRef& handler) {
+			return this->report(this->call(handler), "update");
+		});
+	}
+
+	void script::handle_render(setupandrender_event& ev) {
+		if (!ev.renderer.layers_visible({ &script_layer, 1 })) return;
+
+		this->in_render = true;
+		this->run_handlers(this->render_handlers, [&](const luabridge::LuaRef& handler) {
+			return this->report(this->call(handler), "render");
+		});
+		this->in_render = false;
+	}
+
+	void script::handle_key(key_event& ev) {
+		this->run_handlers(this->key_handlers, [&](const luabridge::LuaRef& handler) {
+			auto result = this->call(handler, static_cast<int>(ev.key), static_cast<int>(ev.action));
+			if (!this->report(result, "key")) return false;
+
+			// returning true from a key handler swallows the key
+			if (result.wasOk() && result.size() > 0 && result[0].isBool() && result[0].unsafe_cast<bool>()) ev.cancel();
+			return true;
+		});
+	}
+};
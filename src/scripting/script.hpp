@@ -0,0 +1,147 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include "lua.hpp"
+#include "../event/event_bindings.hpp"
+#include "../async/task.hpp"
+#include "../renderer/render_layers.hpp"
+#include "../sdk/mc/HashedString.hpp"
+
+namespace selaura {
+	// how much of a frame a single script may spend across all of its handlers
+	struct script_budget {
+		std::chrono::nanoseconds frame_time = std::chrono::microseconds(1000);
+		std::uint64_t frame_instructions = 200'000;
+		// the top level chunk runs once, it only needs to be stopped if it never returns
+		std::chrono::nanoseconds load_time = std::chrono::seconds(1);
+		// consecutive overrunning frames before a script is suspended for good
+		std::uint32_t max_overruns = 4;
+	};
+
+	// scripts draw in game, alongside the hud
+	inline constexpr layer_hash script_layer = "hud_screen"_hs.hash;
+
+	enum class script_state {
+		running,
+		throttled,
+		suspended
+	};
+
+	struct script_stats {
+		std::uint64_t frames = 0;
+		std::uint64_t total_ns = 0;
+		std::uint64_t peak_ns = 0;
+		std::uint32_t overruns = 0;
+
+		double average_us() const {
+			return this->frames ? this->total_ns / 1000.0 / this->frames : 0.0;
+		}
+
+		double peak_us() const {
+			return this->peak_ns / 1000.0;
+		}
+	};
+
+	// one lua_State per script, nothing is shared between scripts
+	struct script {
+		script(std::filesystem::path path, std::shared_ptr<spdlog::logger> logger, const script_budget& budget);
+		// source is read from instead of path, it has to outlive load
+		script(std::filesystem::path path, std::span<const std::byte> source, std::shared_ptr<spdlog::logger> logger, const script_budget& budget);
+		~script();
+		script(const script&) = delete;
+		script& operator=(const script&) = delete;
+
+		// compiles, or reuses the chunk cached in cache_folder, and runs it. safe to call off the game thread
+		bool load(const std::filesystem::path& cache_folder);
+
+		// subscribes whatever the chunk registered through selaura.on, game thread only
+		void install();
+
+		// closes out the previous frame's accounting, called once per frame before any handler runs
+		void begin_frame();
+
+		const std::string& get_name() const;
+		const std::filesystem::path& get_path() const;
+		const script_stats& get_stats() const;
+		script_state get_state() const;
+		// registered a render handler that is still alive
+		bool draws() const;
+
+	private:
+		void open_libraries();
+		void bind_api();
+
+		// push the compiled chunk, from the cache when it still matches the source
+		bool load_cached(const std::filesystem::path& cache_file, std::int64_t mtime, std::uint64_t hash);
+		bool compile(std::string_view code, const std::filesystem::path& cache_file, std::int64_t mtime, std::uint64_t hash);
+		void on(const std::string& event, luabridge::LuaRef handler);
+
+		// false while throttled, suspended or once this frame's budget is spent
+		bool can_run() const;
+
+		template <typename... Args>
+		luabridge::LuaResult call(const luabridge::LuaRef& handler, Args&&... args);
+
+		// selaura.spawn, drives a lua coroutine from the task scheduler, one resume per frame at most
+		void spawn(luabridge::LuaRef function);
+		task run_coroutine(lua_State* thread, int ref);
+		int resume(lua_State* thread, int& results);
+
+		// returns false and logs if the handler errored, running out of budget is not an error
+		bool report(const luabridge::LuaResult& result, std::string_view event);
+
+		static void count_hook(lua_State* L, lua_Debug* ar);
+		// batch:submit(), draws a selaura.batch in place, only from a render handler or coroutine like the other draw calls
+		static int submit_batch(lua_State* L);
+
+		// invoke returns false for a handler that errored and is dropped
+		template <typename F>
+		void run_handlers(std::vector<luabridge::LuaRef>& handlers, F&& invoke);
+
+		void handle_update(minecraftgame_update_event& ev);
+		void handle_render(setupandrender_event& ev);
+		void handle_key(key_event& ev);
+
+		std::filesystem::path path;
+		std::span<const std::byte> bundled;
+		std::string name;
+		std::shared_ptr<spdlog::logger> logger;
+		const script_budget& budget;
+		lua_State* state = nullptr;
+
+		// limits for the call currently running, checked from the count hook
+		std::chrono::steady_clock::time_point deadline{};
+		std::uint64_t instruction_limit = 0;
+
+		std::uint64_t frame_ns = 0;
+		std::uint64_t frame_instructions = 0;
+		bool frame_overran = false;
+
+		script_state run_state = script_state::running;
+		std::uint32_t consecutive_overruns = 0;
+		std::uint32_t throttle_frames = 0;
+		script_stats stats;
+
+		std::vector<luabridge::LuaRef> update_handlers;
+		std::vector<luabridge::LuaRef> render_handlers;
+		std::vector<luabridge::LuaRef> key_handlers;
+
+		// an event is only subscribed once the script registers its first handler for it
+		event_bindings bindings;
+		bool in_render = false;
+		// spawned and not finished yet, pending ones included
+		std::uint32_t live_coroutines = 0;
+
+		// coroutines spawned while loading off the game thread, started by install
+		std::vector<std::pair<lua_State*, int>> pending_coroutines;
+		bool installed = false;
+	};
+};
@@ -1,30 +1,194 @@
 #include "script_manager.hpp"
 #include "../instance.hpp"
+#include "../hook/impl/render_hooks.hpp"
+
+#include <algorithm>
+#include <latch>
 
 namespace selaura {
 	void script_manager::init() {
 		auto inst = selaura::instance::get();
 		this->data_folder = inst->get_data_folder() / "scripts";
-		auto log_file = inst->get_data_folder() / "logs.txt";
 
-		this->logger = spdlog::basic_logger_mt("selaura scripting", log_file.string(), true);
-		this->logger->set_pattern("[%Y-%m-%d %H:%M:%S] [%^%l%$] [Scripting] %v");
+		// shares the main logger's file sink and writer thread, the [Scripting] tag comes from the logger name
+		auto main_logger = spdlog::default_logger();
+		this->logger = std::make_shared<spdlog::async_logger>("Scripting", main_logger->sinks().begin(), main_logger->sinks().end(), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
 		this->logger->set_level(spdlog::level::debug);
-		this->logger->flush_on(spdlog::level::debug);
+		this->logger->flush_on(spdlog::level::err);
+		spdlog::register_logger(this->logger);
+
+		// subscribed before any script so each frame's accounting rolls over before the first handler runs
+		selaura::get_component<selaura::event_manager>().subscribe<minecraftgame_update_event>(&script_manager::on_update, this);
+		this->last_stats_log = std::chrono::steady_clock::now();
+
+		this->cache_folder = this->data_folder / ".cache";
 
 		int scriptsLoaded = 0;
+		std::vector<std::unique_ptr<script>> pending;
 		if (!std::filesystem::exists(this->data_folder) || std::filesystem::is_empty(this->data_folder)) {
 			std::filesystem::create_directory(this->data_folder);
 		}
 		else {
 			for (const auto& entry : std::filesystem::directory_iterator(this->data_folder)) {
-				if (entry.is_regular_file() && entry.path().extension() == ".lua") { // todo: find what language we're going to use for scripting
-					scriptsLoaded++;
+				if (entry.is_regular_file() && entry.path().extension() == ".lua") {
 					this->logger->info("Loading script: {}", entry.path().filename().string());
+					pending.push_back(std::make_unique<script>(entry.path(), this->logger, this->budget));
 				}
 			}
 		}
 
+		// bundled scripts run from the mapping, a loose file of the same name replaces one and is hot reloaded like any other
+		selaura::get_component<selaura::asset_bundle>().for_each("scripts/", [&](std::string_view name, std::span<const std::byte> source) {
+			const std::filesystem::path file(name);
+			if (file.extension() != ".lua" || file.parent_path() != "scripts") return;
+
+			auto path = this->data_folder / file.filename();
+			if (std::filesystem::exists(path)) return;
+
+			this->logger->info("Loading bundled script: {}", file.filename().string());
+			pending.push_back(std::make_unique<script>(std::move(path), source, this->logger, this->budget));
+		});
+
+		if (!pending.empty()) {
+			std::filesystem::create_directory(this->cache_folder);
+
+			// every script owns its own state, so compiling and running the chunks needs no locking
+			std::vector<std::uint8_t> loaded(pending.size());
+			std::latch done(static_cast<std::ptrdiff_t>(pending.size()));
+
+			for (std::size_t i = 0; i < pending.size(); i++) {
+				selaura::get_component<selaura::job_system>().submit([&, i] {
+					loaded[i] = pending[i]->load(this->cache_folder);
+					done.count_down();
+				});
+			}
+			done.wait();
+
+			for (std::size_t i = 0; i < pending.size(); i++) {
+				if (!loaded[i]) continue;
+				pending[i]->install();
+				this->scripts.push_back(std::move(pending[i]));
+				scriptsLoaded++;
+			}
+		}
+
 		this->logger->info("{} scripts loaded.", scriptsLoaded);
+
+		this->watcher.start(this->data_folder, [this](std::vector<std::filesystem::path> changed) {
+			this->reload(std::move(changed));
+		});
+	}
+
+	void script_manager::reload(std::vector<std::filesystem::path> changed) {
+		std::filesystem::create_directory(this->cache_folder);
+
+		for (auto& path : changed) {
+			if (!std::filesystem::exists(path)) {
+				std::scoped_lock lock(this->reload_mutex);
+				this->reloads.push_back({ std::move(path), nullptr });
+				continue;
+			}
+
+			this->logger->info("Reloading script: {}", path.filename().string());
+
+			// a script that no longer compiles keeps running its previous version
+			auto replacement = std::make_unique<script>(path, this->logger, this->budget);
+			if (!replacement->load(this->cache_folder)) continue;
+
+			std::scoped_lock lock(this->reload_mutex);
+			this->reloads.push_back({ std::move(path), std::move(replacement) });
+		}
+	}
+
+	bool script_manager::upload(std::string_view name, std::vector<std::byte> source) {
+		const std::filesystem::path file(name);
+		if (file.extension() != ".lua" || file.filename() != file) return false;
+
+		auto path = this->data_folder / file;
+		selaura::get_component<selaura::job_system>().submit([this, path = std::move(path), source = std::move(source)]() mutable {
+			std::filesystem::create_directory(this->cache_folder);
+			this->logger->info("Loading uploaded script: {}", path.filename().string());
+
+			// the source only has to outlive load, the compiled chunk lives in the state from then on
+			auto replacement = std::make_unique<script>(path, std::span<const std::byte>(source), this->logger, this->budget);
+			if (!replacement->load(this->cache_folder)) return;
+
+			std::scoped_lock lock(this->reload_mutex);
+			this->reloads.push_back({ std::move(path), std::move(replacement) });
+		});
+		return true;
+	}
+
+	void script_manager::apply_reloads() {
+		std::vector<pending_reload> ready;
+		{
+			std::scoped_lock lock(this->reload_mutex);
+			ready.swap(this->reloads);
+		}
+
+		for (auto& [path, replacement] : ready) {
+			auto it = std::find_if(this->scripts.begin(), this->scripts.end(), [&](const auto& loaded) {
+				return loaded->get_path() == path;
+			});
+
+			if (!replacement) {
+				if (it == this->scripts.end()) continue;
+				this->logger->info("Unloaded script: {}", path.filename().string());
+				this->scripts.erase(it);
+				continue;
+			}
+
+			// the old state unsubscribes in its destructor, the new one subscribes before any handler runs this frame
+			replacement->install();
+			if (it != this->scripts.end()) *it = std::move(replacement);
+			else this->scripts.push_back(std::move(replacement));
+		}
+	}
+
+	std::span<const std::unique_ptr<script>> script_manager::get_scripts() const {
+		return this->scripts;
+	}
+
+	script_budget& script_manager::get_budget() {
+		return this->budget;
+	}
+
+	void script_manager::on_update(minecraftgame_update_event& ev) {
+		this->apply_reloads();
+
+		for (auto& loaded : this->scripts) {
+			loaded->begin_frame();
+		}
+
+		// render handlers and coroutines come and go with reloads and errors, the hud only stays wanted while one is left
+		const bool draws = std::ranges::any_of(this->scripts, [](const auto& loaded) { return loaded->draws(); });
+		if (draws != this->drawing) {
+			this->drawing = draws;
+			auto& layers = selaura::get_component<selaura::renderer>().get_layers();
+			auto& hooks = selaura::get_component<selaura::hook_manager>();
+			if (draws) {
+				layers.want({ &script_layer, 1 });
+				hooks.acquire(hook_dependency::of<render_hooks>());
+			}
+			else {
+				layers.release({ &script_layer, 1 });
+				hooks.release(hook_dependency::of<render_hooks>());
+			}
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		if (now - this->last_stats_log >= std::chrono::seconds(60)) {
+			this->last_stats_log = now;
+			this->log_stats();
+		}
+	}
+
+	void script_manager::log_stats() {
+		for (const auto& loaded : this->scripts) {
+			const auto& stats = loaded->get_stats();
+			if (stats.frames == 0) continue;
+
+			this->logger->info("[{}] avg {:.1f}us, peak {:.1f}us over {} frames, {} overruns", loaded->get_name(), stats.average_us(), stats.peak_us(), stats.frames, stats.overruns);
+		}
 	}
 };
\ No newline at end of file
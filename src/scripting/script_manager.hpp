@@ -1,12 +1,59 @@
 #pragma once
 #include <filesystem>
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "script.hpp"
+#include "script_watcher.hpp"
 
 namespace selaura {
 	struct script_manager {
+		script_manager() = default;
+		script_manager(const script_manager&) = delete;
+		script_manager& operator=(const script_manager&) = delete;
+
 		void init();
+
+		// compiled on a worker and swapped in like a reload, nothing touches the scripts folder
+		// false when name is not a plain .lua file name
+		bool upload(std::string_view name, std::vector<std::byte> source);
+
+		std::span<const std::unique_ptr<script>> get_scripts() const;
+		script_budget& get_budget();
 	private:
+		void on_update(minecraftgame_update_event& ev);
+		void log_stats();
+
+		// watcher thread, compiles the changed scripts so the game thread only has to swap them in
+		void reload(std::vector<std::filesystem::path> changed);
+		void apply_reloads();
+
+		struct pending_reload {
+			std::filesystem::path path;
+			// null when the file was removed
+			std::unique_ptr<script> replacement;
+		};
+
 		std::filesystem::path data_folder;
 		std::shared_ptr<spdlog::logger> logger;
+		std::vector<std::unique_ptr<script>> scripts;
+		script_budget budget;
+		std::chrono::steady_clock::time_point last_stats_log{};
+		std::filesystem::path cache_folder;
+
+		std::mutex reload_mutex;
+		std::vector<pending_reload> reloads;
+
+		// whether script_layer and the render hooks are held for the scripts that draw
+		bool drawing = false;
+
+		// last, so the watcher thread is stopped before anything it touches is destroyed
+		script_watcher watcher;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "script_watcher.hpp"
+
+#include <chrono>
+#include <set>
+
+#if defined(SELAURA_WINDOWS)
+#include <Windows.h>
+#else
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace selaura {
+	namespace {
+		// editors save in several steps, wait for the folder to go quiet before reporting anything
+		constexpr std::chrono::milliseconds settle_time{ 150 };
+
+		void collect(std::set<std::filesystem::path>& changed, const std::filesystem::path& folder, const std::filesystem::path& file) {
+			if (file.extension() == ".lua") changed.insert(folder / file);
+		}
+	}
+
+	script_watcher::~script_watcher() {
+		this->stop();
+	}
+
+#if defined(SELAURA_WINDOWS)
+	bool script_watcher::start(std::filesystem::path folder, callback_t callback) {
+		this->folder = std::move(folder);
+		this->callback = std::move(callback);
+
+		this->directory = CreateFileW(this->folder.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (this->directory == INVALID_HANDLE_VALUE) {
+			this->directory = nullptr;
+			spdlog::error("Failed to watch {}: {}", this->folder.string(), GetLastError());
+			return false;
+		}
+
+		this->stop_event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		this->thread = std::thread(&script_watcher::watch_loop, this);
+		return true;
+	}
+
+	void script_watcher::stop() {
+		if (this->thread.joinable()) {
+			SetEvent(this->stop_event);
+			this->thread.join();
+		}
+
+		if (this->directory) CloseHandle(this->directory);
+		if (this->stop_event) CloseHandle(this->stop_event);
+		this->directory = nullptr;
+		this->stop_event = nullptr;
+	}
+
+	void script_watcher::watch_loop() {
+		alignas(DWORD) std::byte buffer[16 * 1024];
+		OVERLAPPED overlapped{};
+		overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+		std::set<std::filesystem::path> changed;
+		const HANDLE handles[] = { this->stop_event, overlapped.hEvent };
+
+		while (true) {
+			ResetEvent(overlapped.hEvent);
+			constexpr DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+			if (!ReadDirectoryChangesW(this->directory, buffer, sizeof(buffer), FALSE, filter, nullptr, &overlapped, nullptr)) break;
+
+			// an empty pending set blocks until something happens, otherwise the timeout flushes it
+			const DWORD wait = WaitForMultipleObjects(2, handles, FALSE, changed.empty() ? INFINITE : static_cast<DWORD>(settle_time.count()));
+			if (wait == WAIT_OBJECT_0) break;
+
+			if (wait == WAIT_TIMEOUT) {
+				CancelIoEx(this->directory, &overlapped);
+				DWORD ignored;
+				GetOverlappedResult(this->directory, &overlapped, &ignored, TRUE);
+
+				this->callback({ changed.begin(), changed.end() });
+				changed.clear();
+				continue;
+			}
+
+			DWORD bytes = 0;
+			if (!GetOverlappedResult(this->directory, &overlapped, &bytes, FALSE)) continue;
+
+			// zero bytes means the buffer overflowed, nothing tells us which files changed so report them all
+			if (bytes == 0) {
+				for (const auto& entry : std::filesystem::directory_iterator(this->folder)) collect(changed, this->folder, entry.path().filename());
+				continue;
+			}
+
+			for (auto* info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(buffer);; info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(reinterpret_cast<std::byte*>(info) + info->NextEntryOffset)) {
+				collect(changed, this->folder, std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)));
+				if (info->NextEntryOffset == 0) break;
+			}
+		}
+
+		CancelIoEx(this->directory, &overlapped);
+		DWORD ignored;
+		GetOverlappedResult(this->directory, &overlapped, &ignored, TRUE);
+		CloseHandle(overlapped.hEvent);
+	}
+#else
+	bool script_watcher::start(std::filesystem::path folder, callback_t callback) {
+		this->folder = std::move(folder);
+		this->callback = std::move(callback);
+
+		this->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (this->inotify_fd < 0 || inotify_add_watch(this->inotify_fd, this->folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+			spdlog::error("Failed to watch {}: {}", this->folder.string(), errno);
+			if (this->inotify_fd >= 0) close(this->inotify_fd);
+			this->inotify_fd = -1;
+			return false;
+		}
+
+		this->stop_fd = eventfd(0, EFD_CLOEXEC);
+		this->thread = std::thread(&script_watcher::watch_loop, this);
+		return true;
+	}
+
+	void script_watcher::stop() {
+		if (this->thread.joinable()) {
+			const std::uint64_t one = 1;
+			write(this->stop_fd, &one, sizeof(one));
+			this->thread.join();
+		}
+
+		if (this->inotify_fd >= 0) close(this->inotify_fd);
+		if (this->stop_fd >= 0) close(this->stop_fd);
+		this->inotify_fd = -1;
+		this->stop_fd = -1;
+	}
+
+	void script_watcher::watch_loop() {
+		alignas(inotify_event) char buffer[16 * 1024];
+		std::set<std::filesystem::path> changed;
+		pollfd fds[] = { { this->stop_fd, POLLIN, 0 }, { this->inotify_fd, POLLIN, 0 } };
+
+		while (true) {
+			// an empty pending set blocks until something happens, otherwise the timeout flushes it
+			const int ready = poll(fds, 2, changed.empty() ? -1 : static_cast<int>(settle_time.count()));
+			if (ready < 0 && errno == EINTR) continue;
+			if (ready < 0 || (fds[0].revents & POLLIN)) break;
+
+			if (ready == 0) {
+				this->callback({ changed.begin(), changed.end() });
+				changed.clear();
+				continue;
+			}
+
+			ssize_t length;
+			while ((length = read(this->inotify_fd, buffer, sizeof(buffer))) > 0) {
+				for (char* ptr = buffer; ptr < buffer + length;) {
+					const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+					if (event->len > 0) collect(changed, this->folder, event->name);
+					ptr += sizeof(inotify_event) + event->len;
+				}
+			}
+		}
+	}
+#endif
+};
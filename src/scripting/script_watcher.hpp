@@ -0,0 +1,36 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace selaura {
+	// watches one directory for changed .lua files using the os change notifications, never by scanning it
+	struct script_watcher {
+		using callback_t = std::function<void(std::vector<std::filesystem::path>)>;
+
+		script_watcher() = default;
+		~script_watcher();
+		script_watcher(const script_watcher&) = delete;
+		script_watcher& operator=(const script_watcher&) = delete;
+
+		// callback runs on the watcher thread with every file touched since the last batch
+		bool start(std::filesystem::path folder, callback_t callback);
+		void stop();
+	private:
+		void watch_loop();
+
+		std::filesystem::path folder;
+		callback_t callback;
+		std::thread thread;
+
+#if defined(SELAURA_WINDOWS)
+		void* directory = nullptr;
+		void* stop_event = nullptr;
+#else
+		int inotify_fd = -1;
+		int stop_fd = -1;
+#endif
+	};
+};
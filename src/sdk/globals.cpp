@@ -0,0 +1,30 @@
+#include "globals.hpp"
+#include "../instance.hpp"
+
+namespace selaura {
+    namespace {
+        constexpr layer_hash hud_layers[] = { "hud_screen"_hs.hash };
+    }
+
+    void globals::tick(MinecraftGame* game) {
+        const auto now = std::chrono::steady_clock::now();
+        game_snapshot next{};
+        next.tick = ++this->ticks;
+        if (this->last_tick != std::chrono::steady_clock::time_point{}) next.delta = std::chrono::duration<float>(now - this->last_tick).count();
+        this->last_tick = now;
+
+        next.mc_game = game;
+        next.client_instance = this->client_instance.load(std::memory_order_acquire);
+
+        // every derived value is worked out here once, not by each feature on each frame
+        if (next.client_instance) {
+            GuiData* gui_data = next.client_instance->getGuiData();
+            next.screen_size = gui_data->getScreenSize();
+            next.gui_scale = gui_data->getGuiScale();
+            if (next.gui_scale > 0.0f) next.gui_size = { next.screen_size.x / next.gui_scale, next.screen_size.y / next.gui_scale };
+        }
+        next.hud_visible = selaura::get_component<selaura::renderer>().layers_visible(hud_layers);
+
+        this->state.publish(next);
+    }
+};
@@ -1,9 +1,46 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include "mc/game/MinecraftGame.hpp"
+#include "mc/game/ClientInstance.hpp"
 #include "mc/gui/controls/renderers/SplashTextRenderer.hpp"
+#include "../util/triple_buffer.hpp"
 
 namespace selaura {
+    // game state as it was at the end of a MinecraftGame::update, the same for every reader until the next tick
+    struct game_snapshot {
+        std::uint64_t tick = 0;
+        // seconds since the previous tick
+        float delta = 0.0f;
+
+        MinecraftGame* mc_game = nullptr;
+        ClientInstance* client_instance = nullptr;
+
+        Vec2 screen_size{};
+        float gui_scale = 1.0f;
+        // screen size in gui units, what hud positions are laid out in
+        Vec2 gui_size{};
+        bool hud_visible = false;
+    };
+
     struct globals {
+        // game thread only, the pointers other threads want are in the snapshot
         MinecraftGame* mc_game = nullptr;
+        // stored by every SetupAndRender and loaded by tick, lives as long as the game does
+        std::atomic<ClientInstance*> client_instance{ nullptr };
+
+        // MinecraftGame::update, after the update event so the snapshot sees what listeners changed
+        void tick(MinecraftGame* game);
+
+        // any thread, without locking, the profiler screen shows it
+        game_snapshot snapshot() const {
+            return this->state.read();
+        }
+
+    private:
+        triple_buffer<game_snapshot> state;
+        std::uint64_t ticks = 0;
+        std::chrono::steady_clock::time_point last_tick{};
     };
-};
\ No newline at end of file
+};
@@ -1,8 +1,10 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
-
+struct HashedStringView;
 
 class HashedString {
 public:
@@ -13,7 +15,7 @@ private:
 	HashedString* lastCompare;
 
 public:
-	uint64_t fnv1a_64(std::string const& str) {
+	static constexpr uint64_t fnv1a_64(std::string_view str) {
 		uint64_t hash = 0xcbf29ce484222325;
 
 		for (char c : str) {
@@ -26,6 +28,9 @@ public:
 
 	HashedString(int64_t hash, std::string text) : hash(hash), string(text.c_str()), lastCompare(nullptr) {};
 
+	// the owning layout the engine expects, only build one to hand it to an engine function
+	explicit HashedString(const HashedStringView& view);
+
 	std::string getString() {
 		return string;
 	}
@@ -69,4 +74,30 @@ public:
 	bool operator!=(std::string const& right) {
 		return !operator==(right);
 	}
-};
\ No newline at end of file
+};
+
+// non-owning, for hashing and comparing without a std::string in sight
+struct HashedStringView {
+	uint64_t hash = 0;
+	std::string_view str;
+
+	constexpr HashedStringView() = default;
+	constexpr HashedStringView(std::string_view str) : hash(HashedString::fnv1a_64(str)), str(str) {}
+	constexpr HashedStringView(uint64_t hash, std::string_view str) : hash(hash), str(str) {}
+
+	constexpr bool operator==(const HashedStringView& right) const {
+		return hash == right.hash && str == right.str;
+	}
+
+	constexpr bool operator==(uint64_t right) const {
+		return hash == right;
+	}
+};
+
+inline HashedString::HashedString(const HashedStringView& view) : hash(static_cast<int64_t>(view.hash)), string(view.str), lastCompare(nullptr) {}
+
+// "ui_texture_and_color_blur"_hs, hashed at compile time and pointing at the literal
+consteval HashedStringView operator""_hs(const char* str, std::size_t size) {
+	return HashedStringView(std::string_view(str, size));
+}
+static_assert("ui_texture_and_color_blur"_hs == HashedString::fnv1a_64("ui_texture_and_color_blur"));
@@ -1,4 +1,5 @@
 #include "Blob.hpp"
+#include <utility>
 
 mce::Blob::Blob() : mBlob(nullptr, Deleter()), mSize(0) {}
 
@@ -8,14 +9,21 @@ mce::Blob::Blob(const iterator data, const size_type size)
     std::copy(data, data + size, mBlob.get());
 }
 
-mce::Blob::Blob(const Blob& other)
-    : mSize(other.mSize), mBlob(nullptr, Deleter(other.mBlob.get_deleter().getDeleteFunc()))
+mce::Blob::Blob(iterator data, const size_type size, delete_function delete_func)
+    : mBlob(data, Deleter(delete_func)), mSize(size)
 {
-    if (other.mBlob) {
-        value_type* newData = new value_type[other.mSize];
-        std::copy(other.mBlob.get(), other.mBlob.get() + other.mSize, newData);
-        mBlob.reset(newData);
-    }
+}
+
+mce::Blob::Blob(Blob&& other) noexcept
+    : mBlob(std::move(other.mBlob)), mSize(std::exchange(other.mSize, 0))
+{
+}
+
+mce::Blob& mce::Blob::operator=(Blob&& other) noexcept
+{
+    mBlob = std::move(other.mBlob);
+    mSize = std::exchange(other.mSize, 0);
+    return *this;
 }
 
 mce::Blob::size_type mce::Blob::size() const
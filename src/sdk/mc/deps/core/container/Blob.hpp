@@ -40,7 +40,13 @@ namespace mce {
     public:
         Blob();
         Blob(const iterator data, const size_type size);
-        Blob(const Blob& other);
+        // takes ownership of data, delete_func is what eventually frees it
+        Blob(iterator data, const size_type size, delete_function delete_func);
+        Blob(const Blob& other) = delete;
+        Blob(Blob&& other) noexcept;
+
+        Blob& operator=(const Blob& other) = delete;
+        Blob& operator=(Blob&& other) noexcept;
 
         size_type size() const;
 
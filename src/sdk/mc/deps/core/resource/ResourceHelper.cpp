@@ -22,7 +22,8 @@ ResourceLocation::ResourceLocation(const char* path) : ResourceLocation(std::str
 
 void ResourceLocation::_computeHashes()
 {
-    int64_t hash = HashedString(mPath).getHash();
+    // only the hash is needed, building a HashedString here would copy the path for nothing
+    int64_t hash = static_cast<int64_t>(HashedString::fnv1a_64(mPath));
     mPathHash = hash;
     mFullHash = hash ^ (uint64_t)mFileSystem;
 }
\ No newline at end of file
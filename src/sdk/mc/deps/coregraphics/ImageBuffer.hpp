@@ -12,8 +12,11 @@ namespace cg {
         ImageBuffer(mce::Blob&& blob, cg::ImageDescription&& imageDescription)
             : mStorage(std::move(blob)), mImageDescription(std::move(imageDescription)) {}
 
-        ImageBuffer(const ImageBuffer& other)
-            : mStorage(other.mStorage), mImageDescription(other.mImageDescription) {}
+        ImageBuffer(const ImageBuffer& other) = delete;
+        ImageBuffer& operator=(const ImageBuffer& other) = delete;
+
+        ImageBuffer(ImageBuffer&& other) noexcept
+            : mStorage(std::move(other.mStorage)), mImageDescription(other.mImageDescription) {}
 
         __declspec(noinline) bool isValid() const {
             size_t blobSize = mStorage.size();
@@ -3,19 +3,40 @@
 #include "../../../instance.hpp"
 #include "../../../sdk/globals.hpp"
 #include "../../../hook/hook_manager.hpp"
+#include "../../../hook/impl/render_hooks.hpp"
+#include "../../../profiler/profiler.hpp"
 
 void __cdecl MinecraftGame::update() {
-    auto inst = selaura::instance::get();
-    auto evm = inst->get<selaura::event_manager>();
+    SELAURA_PROFILE_FRAME();
+    SELAURA_PROFILE_HOOK("MinecraftGame::update");
+    SELAURA_PROFILE_SCOPE("MinecraftGame::update");
+    auto& evm = selaura::get_component<selaura::event_manager>();
+    // nothing is dispatching on this thread yet, a good moment to free listener lists replaced last frame
+    selaura::event_manager::quiesce();
 
-    inst->get<selaura::globals>().mc_game = this;
+    auto& hk = selaura::get_component<selaura::hook_manager>();
+    hk.update();
+
+    auto& globals = selaura::get_component<selaura::globals>();
+    globals.mc_game = this;
+    auto& renderer = selaura::get_component<selaura::renderer>();
+    auto& pacer = renderer.get_pacer();
+    pacer.begin_game_frame();
+
+    // whatever other threads drew during the last frame becomes what the next rebuild draws
+    if (renderer.get_commands().swap()) pacer.invalidate();
+
+    // drained once per game frame rather than by whichever view draws, so hotkeys work while nothing is drawn
+    // the same thread renders the ui, imgui only sees pointer input while the render hooks keep it running
+    const bool drawing = ImGui::GetCurrentContext() && hk.is_active(selaura::hook_dependency::of<selaura::render_hooks>());
+    if (selaura::get_component<selaura::input_manager>().drain(drawing)) pacer.invalidate();
 
     selaura::minecraftgame_update_event ev{};
     evm.dispatch<selaura::minecraftgame_update_event>(ev);
-
-    auto hk = inst->get<selaura::hook_manager>();
+    globals.tick(this);
 
     auto original = hk.get_original<&MinecraftGame::update>();
+    SELAURA_PROFILE_ORIGINAL();
     return (this->*original)();
 }
 
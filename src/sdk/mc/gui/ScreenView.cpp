@@ -3,17 +3,16 @@
 #include "../../../instance.hpp"
 #include "../../../hook/hook_manager.hpp"
 #include "../../../renderer/renderer.hpp"
+#include "../../../profiler/profiler.hpp"
 #include "../../mem/symbols.hpp"
 #include <glm/glm.hpp>
+#include <array>
 
 void __cdecl ScreenView::SetupAndRender(MinecraftUIRenderContext* ctx) {
-    auto inst = selaura::instance::get();
-    auto evm = inst->get<selaura::event_manager>();
-
-	auto globals = inst->get<selaura::globals>();
-	// reset splash text to show selaura
-
-	auto renderer = inst->get<selaura::renderer>();
+	SELAURA_PROFILE_HOOK("ScreenView::SetupAndRender");
+	SELAURA_PROFILE_SCOPE("ScreenView::SetupAndRender");
+    auto& evm = selaura::get_component<selaura::event_manager>();
+	auto& renderer = selaura::get_component<selaura::renderer>();
 
     if (ImGui::GetCurrentContext() == nullptr) {
         IMGUI_CHECKVERSION();
@@ -22,29 +21,99 @@ void __cdecl ScreenView::SetupAndRender(MinecraftUIRenderContext* ctx) {
         ImGuiIO& io = ImGui::GetIO();
 
         renderer.initialize_imgui(*ctx);
+
+        // the startup number that matters, injection until the overlay can draw
+        const std::chrono::duration<float, std::milli> since_start = std::chrono::steady_clock::now() - selaura::instance::current().get_start_time();
+        spdlog::info("First overlay frame {:.1f}ms after init", since_start.count());
     }
 
-	renderer.new_frame(*ctx);
-	ImGui::NewFrame();
+    auto& hk = selaura::get_component<selaura::hook_manager>();
+    auto original = hk.get_original<&ScreenView::SetupAndRender>();
 
-	selaura::setupandrender_event ev{ ctx, renderer, this };
-	evm.dispatch<selaura::setupandrender_event>(ev);
+	// every view is seen so screens can tell when their layer goes away, only the ones something draws on go further
+	auto& pacer = renderer.get_pacer();
+	auto& layers = renderer.get_layers();
+	const uint64_t layer = this->getScreenHash();
+	layers.observe(layer, pacer.get_game_frame());
+	if (pacer.is_suspended() || !layers.wanted(layer)) {
+		SELAURA_PROFILE_ORIGINAL();
+		return (this->*original)(ctx);
+	}
 
-	inst->get<selaura::screen_manager>().for_each([&](selaura::screen& screen) {
-		if (screen.is_enabled()) screen.on_render(ev);
-	});
+	// hud, toast and debug views can all be wanted, the overlay is only drawn by the first one each frame
+	if (!pacer.claim_view(this)) {
+		SELAURA_PROFILE_ORIGINAL();
+		return (this->*original)(ctx);
+	}
 
-	ImGui::EndFrame();
-	ImGui::Render();
+	// everything below reads the game through this instead of chasing the same pointers again
+	const auto frame = selaura::frame_context::capture(*ctx, layer);
+	selaura::get_component<selaura::globals>().client_instance.store(frame.client_instance, std::memory_order_release);
+	renderer.new_frame(frame);
+	selaura::get_component<selaura::texture_manager>().process_uploads(*ctx);
+	selaura::get_component<selaura::texture_atlas>().process(*ctx);
 
-	renderer.render_draw_data(ImGui::GetDrawData(), *ctx);
+	// between rebuilds the last draw data stays valid, imgui only replaces it on the next Render
+	float delta = 0.0f;
+	const bool rebuild = pacer.should_rebuild(delta);
+	if (rebuild) {
+		ImGui::GetIO().DeltaTime = delta;
+		ImGui::NewFrame();
+		renderer.get_quads().clear();
+		renderer.get_commands().merge(ImGui::GetBackgroundDrawList(), renderer.get_shapes());
 
-    auto hk = inst->get<selaura::hook_manager>();
+		selaura::setupandrender_event ev{ frame, renderer, this, &renderer.get_frame_arena() };
+		// enabled screens are subscribed to this event, disabled ones are never visited
+		evm.dispatch<selaura::setupandrender_event>(ev);
 
-    auto original = hk.get_original<&ScreenView::SetupAndRender>();
+		ImGui::EndFrame();
+		ImGui::Render();
+		if (ImDrawData* data = ImGui::GetDrawData()) renderer.get_hud().submit(*data);
+	}
+
+	if (ImDrawData* data = ImGui::GetDrawData()) {
+		if (auto& capture = renderer.get_capture(); capture.active()) capture.record(*data, !rebuild);
+		renderer.render_draw_data(data, frame, !rebuild);
+	}
+	renderer.get_frame_arena().reset();
+
+    SELAURA_PROFILE_ORIGINAL();
     return (this->*original)(ctx);
 }
 
 VisualTree* ScreenView::getVisualTree() {
 	return hat::member_at<VisualTree*>(this, selaura::signatures::screenview_visualtree.resolve());
+}
+
+uint64_t ScreenView::getScreenHash() {
+	struct cached_view {
+		ScreenView* view = nullptr;
+		UIControl* root = nullptr;
+		uint64_t hash = 0;
+	};
+	// hud, toast, debug and whatever screen is open all render every frame, keep a slot for each view
+	static std::array<cached_view, 8> cache{};
+	static std::size_t next_slot = 0;
+
+	UIControl* root = getVisualTree()->getRoot();
+	cached_view* slot = nullptr;
+	for (auto& entry : cache) {
+		if (entry.view == this) {
+			slot = &entry;
+			break;
+		}
+	}
+
+	if (!slot) {
+		slot = &cache[next_slot++ % cache.size()];
+		slot->view = this;
+		slot->root = nullptr;
+	}
+
+	// a view keeps its object when the game swaps its visual tree, so the root still has to be compared
+	if (slot->root != root) {
+		slot->root = root;
+		slot->hash = root->getLayerHash();
+	}
+	return slot->hash;
 }
\ No newline at end of file
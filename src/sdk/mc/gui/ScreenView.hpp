@@ -9,4 +9,7 @@
 struct ScreenView {
     void __cdecl SetupAndRender(MinecraftUIRenderContext* ctx);
     VisualTree* getVisualTree();
+
+    // hash of the root layer name, cached per view and only recomputed when its visual tree root changes
+    uint64_t getScreenHash();
 };
\ No newline at end of file
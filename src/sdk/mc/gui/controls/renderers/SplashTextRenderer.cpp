@@ -2,16 +2,25 @@
 
 #include "../../../../../instance.hpp"
 #include "../../../../../event/event_manager.hpp"
+#include "../../../../../profiler/profiler.hpp"
+#include "../../../../../util/field_override.hpp"
 
 #include <spdlog/spdlog.h>
 
 void SplashTextRenderer::render(MinecraftUIRenderContext* ctx, ClientInstance* ci, UIControl* owner, int pass, void* renderAABB) {
-    auto inst = selaura::instance::get();
-    auto hk = inst->get<selaura::hook_manager>();
+    SELAURA_PROFILE_HOOK("SplashTextRenderer::render");
+    SELAURA_TRACE_SCOPE("SplashTextRenderer::render");
+    auto& hk = selaura::get_component<selaura::hook_manager>();
 
     auto original = hk.get_original<&SplashTextRenderer::render>();
-    (this->*original)(ctx, ci, owner, pass, renderAABB);
+    {
+        SELAURA_PROFILE_ORIGINAL();
+        (this->*original)(ctx, ci, owner, pass, renderAABB);
+    }
 
-    this->mCurrentSplash = 0;
-    this->mSplashes = { "\u00a76Selaura Client \u00a76on top!\u00a7r" };
+    // written once, then again only if the game reloads its splashes or picks another one
+    static selaura::field_override<int> current_splash{ 0 };
+    static selaura::field_override<std::vector<std::string>> splashes{ { "\u00a76Selaura Client \u00a76on top!\u00a7r" } };
+    current_splash.apply(this->mCurrentSplash);
+    splashes.apply(this->mSplashes);
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "UIControl.hpp"
 #include "../../../mem/symbols.hpp"
+#include "../../HashedString.hpp"
 
-std::string UIControl::getLayerName() {
+std::string_view UIControl::getLayerName() {
     return hat::member_at<std::string>(this, selaura::signatures::uicontrol_layername.resolve());
+}
+
+uint64_t UIControl::getLayerHash() {
+    return HashedString::fnv1a_64(getLayerName());
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <libhat/access.hpp>
 
 struct UIControl {
-    std::string getLayerName();
+    std::string_view getLayerName();
+    uint64_t getLayerHash();
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "NetworkPeer.hpp"
+
+#include "../../../instance.hpp"
+#include "../../../hook/hook_manager.hpp"
+#include "../../../network/packet_dispatch.hpp"
+#include "../../../profiler/profiler.hpp"
+
+#include <span>
+
+namespace {
+    std::span<const std::byte> bytes_of(const std::string& data) {
+        return { reinterpret_cast<const std::byte*>(data.data()), data.size() };
+    }
+}
+
+void __cdecl BatchedNetworkPeer::sendPacket(const std::string& data, NetworkPeer::Reliability reliability, Compressibility compressibility) {
+    SELAURA_PROFILE_HOOK("BatchedNetworkPeer::sendPacket");
+    auto original = selaura::get_component<selaura::hook_manager>().get_original<&BatchedNetworkPeer::sendPacket>();
+
+    // a cancelled packet never reaches the batch
+    if (selaura::dispatch_packet(selaura::packet_direction::outbound, bytes_of(data))) return;
+
+    SELAURA_PROFILE_ORIGINAL();
+    return (this->*original)(data, reliability, compressibility);
+}
+
+NetworkPeer::DataStatus __cdecl BatchedNetworkPeer::receivePacket(std::string& data, const std::shared_ptr<std::chrono::steady_clock::time_point>& time) {
+    SELAURA_PROFILE_HOOK("BatchedNetworkPeer::receivePacket");
+    auto original = selaura::get_component<selaura::hook_manager>().get_original<&BatchedNetworkPeer::receivePacket>();
+
+    // the caller takes whatever comes back, so a cancelled packet is replaced by the next one in the batch
+    while (true) {
+        NetworkPeer::DataStatus status;
+        {
+            SELAURA_PROFILE_ORIGINAL();
+            status = (this->*original)(data, time);
+        }
+
+        if (status != NetworkPeer::DataStatus::HasData) return status;
+        if (!selaura::dispatch_packet(selaura::packet_direction::inbound, bytes_of(data))) return status;
+    }
+}
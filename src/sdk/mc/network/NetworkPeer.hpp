@@ -0,0 +1,30 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include <string>
+
+struct NetworkPeer {
+    enum class Reliability : int {
+        Reliable,
+        ReliableOrdered,
+        Unreliable,
+        UnreliableSequenced
+    };
+
+    enum class DataStatus : int {
+        HasData,
+        NoData,
+        BrokenData
+    };
+};
+
+enum class Compressibility : int {
+    Compressible,
+    Incompressible
+};
+
+// the outermost peer of a connection, it takes and hands out one serialized packet at a time and batches below that
+struct BatchedNetworkPeer {
+    void __cdecl sendPacket(const std::string& data, NetworkPeer::Reliability reliability, Compressibility compressibility);
+    NetworkPeer::DataStatus __cdecl receivePacket(std::string& data, const std::shared_ptr<std::chrono::steady_clock::time_point>& time);
+};
@@ -1,6 +1,30 @@
 #include "Tessellator.hpp"
 #include "../../mem/symbols.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace {
+    // widens the four channels of a packed abgr color and scales them by 1/255 in one multiply
+    void unpack_color(unsigned int col, float out[4]) {
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(col)), zero), zero);
+        _mm_storeu_ps(out, _mm_mul_ps(_mm_cvtepi32_ps(wide), _mm_set1_ps(1.0f / 255.0f)));
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+        const uint32x4_t wide = vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(col))));
+        vst1q_f32(out, vmulq_n_f32(vcvtq_f32_u32(wide), 1.0f / 255.0f));
+#else
+        for (int i = 0; i < 4; i++) {
+            out[i] = ((col >> (i * 8)) & 0xFF) * (1.0f / 255.0f);
+        }
+#endif
+    }
+}
+
 void Tessellator::begin(mce::PrimitiveMode vertexFormat, const int maxVertices, const bool buildFaceData) {
     static auto func = reinterpret_cast<selaura::signatures::tessellator_begin_t>(selaura::signatures::tessellator_begin.resolve());
     func(this, vertexFormat, maxVertices, buildFaceData);
@@ -16,11 +40,29 @@ void Tessellator::color(float r, float g, float b, float a) {
     func(this, r, g, b, a);
 }
 
+void Tessellator::vertices(std::span<const vertex> vertices) {
+    static auto vertex_func = reinterpret_cast<selaura::signatures::tessellator_vertexuv_t>(selaura::signatures::tessellator_vertexuv.resolve());
+    static auto color_func = reinterpret_cast<selaura::signatures::tessellator_color_t>(selaura::signatures::tessellator_color.resolve());
+
+    bool has_color = false;
+    uint32_t current_color = 0;
+
+    for (const auto& vtx : vertices) {
+        if (!has_color || vtx.color != current_color) {
+            float rgba[4];
+            unpack_color(vtx.color, rgba);
+            color_func(this, rgba[0], rgba[1], rgba[2], rgba[3]);
+            current_color = vtx.color;
+            has_color = true;
+        }
+
+        vertex_func(this, vtx.x, vtx.y, vtx.z, vtx.u, vtx.v);
+    }
+}
+
 void Tessellator::color(unsigned int col) {
-    float r = ((col >> 0) & 0xFF) / 255.0f;
-    float g = ((col >> 8) & 0xFF) / 255.0f;
-    float b = ((col >> 16) & 0xFF) / 255.0f;
-    float a = ((col >> 24) & 0xFF) / 255.0f;
+    float rgba[4];
+    unpack_color(col, rgba);
 
-    this->color(r, g, b, a);
+    this->color(rgba[0], rgba[1], rgba[2], rgba[3]);
 }
\ No newline at end of file
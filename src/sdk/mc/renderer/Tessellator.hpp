@@ -1,9 +1,20 @@
 #pragma once
+#include <cstdint>
+#include <span>
 #include "helpers/MeshHelpers.hpp"
 
 struct Tessellator {
+	struct vertex {
+		float x, y, z;
+		float u, v;
+		uint32_t color;
+	};
+
 	void begin(mce::PrimitiveMode vertexFormat, const int maxVertices, const bool buildFaceData = false);
 	void vertexUV(float x, float y, float z, float u, float v);
 	void color(float r, float g, float b, float a);
 	void color(unsigned int col);
+
+	// submits a prepared run of vertices, the game's color state is only touched when the color changes
+	void vertices(std::span<const vertex> vertices);
 };
\ No newline at end of file
@@ -2,22 +2,26 @@
 #include "../../mem/symbols.hpp"
 #include "../../../instance.hpp"
 #include "../../../renderer/renderer.hpp"
+#include "../../../profiler/profiler.hpp"
 #include <spdlog/spdlog.h>
 
 namespace mce {
-    mce::BedrockTexture& TextureGroup::uploadTexture(const ResourceLocation& resource, cg::ImageBuffer image_buffer) {
+    mce::BedrockTexture& TextureGroup::uploadTexture(const ResourceLocation& resource, cg::ImageBuffer&& image_buffer) {
         static auto func = reinterpret_cast<selaura::signatures::mce_texturegroup_uploadtexture_t>(selaura::signatures::mce_texturegroup_uploadtexture.resolve());
-        return func(this, resource, image_buffer);
+        // the game takes the buffer by value, this move is the only place its storage changes hands
+        return func(this, resource, std::move(image_buffer));
     }
 
     void TextureGroup::unloadAllTextures() {
-        auto inst = selaura::instance::get();
-        auto renderer = inst->get<selaura::renderer>();
+        SELAURA_PROFILE_HOOK("mce::TextureGroup::unloadAllTextures");
+        SELAURA_TRACE_SCOPE("mce::TextureGroup::unloadAllTextures");
+        selaura::get_component<selaura::renderer>().set_textures_unloaded();
+        selaura::get_component<selaura::texture_manager>().on_textures_unloaded();
+        selaura::get_component<selaura::texture_atlas>().on_textures_unloaded();
 
-        renderer.set_textures_unloaded();
-
-        auto hk = inst->get<selaura::hook_manager>();
+        auto& hk = selaura::get_component<selaura::hook_manager>();
         auto original = hk.get_original<&mce::TextureGroup::unloadAllTextures>();
+        SELAURA_PROFILE_ORIGINAL();
         return (this->*original)();
     }
 }   
\ No newline at end of file
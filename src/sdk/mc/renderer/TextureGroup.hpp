@@ -7,7 +7,7 @@
 namespace mce {
     class TextureGroup {
     public:
-        mce::BedrockTexture& uploadTexture(const ResourceLocation& resource, cg::ImageBuffer image_buffer);
+        mce::BedrockTexture& uploadTexture(const ResourceLocation& resource, cg::ImageBuffer&& image_buffer);
         void unloadAllTextures();
     };
 };
\ No newline at end of file
@@ -6,7 +6,7 @@ namespace mce {
     mce::MaterialPtr* MaterialPtr::createMaterial(const HashedString& name) {
         uintptr_t addr = reinterpret_cast<uintptr_t>(selaura::signatures::mce_rendermaterialgroup_ui.resolve());
         uintptr_t offseted_addr = selaura::offset_from_sig(addr, 3);
-        return selaura::call_virtual_raw<mce::MaterialPtr*, const HashedString&>(reinterpret_cast<void*>(offseted_addr), 1, name);
+        return selaura::call_virtual_raw<mce::MaterialPtr*, const HashedString&>(reinterpret_cast<void*>(offseted_addr), selaura::signatures::mce_rendermaterialgroup_getmaterial.slot(), name);
     };
 };
 
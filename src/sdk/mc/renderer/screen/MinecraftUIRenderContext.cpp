@@ -11,5 +11,5 @@ ClientInstance* MinecraftUIRenderContext::getClientInstance() {
 }
 
 mce::TexturePtr MinecraftUIRenderContext::getTexture(const ResourceLocation& resourceLocation, bool forceReload) {
-	return selaura::call_virtual<mce::TexturePtr>(this, 29, resourceLocation, forceReload);
+	return selaura::call_virtual<mce::TexturePtr>(this, selaura::signatures::minecraftuirendercontext_gettexture.slot(), resourceLocation, forceReload);
 }
\ No newline at end of file
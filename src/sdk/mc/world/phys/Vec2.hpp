@@ -1,6 +1,23 @@
 #pragma once
+#include <glm/vec2.hpp>
 
 struct Vec2 {
-    float x;
-    float y;
-};
\ No newline at end of file
+    float x = 0.0f;
+    float y = 0.0f;
+
+    constexpr Vec2() = default;
+    constexpr Vec2(float x, float y) : x(x), y(y) {}
+    constexpr Vec2(const glm::vec2& v) : x(v.x), y(v.y) {}
+
+    constexpr operator glm::vec2() const { return { x, y }; }
+
+    constexpr Vec2 operator+(const Vec2 v) const { return { x + v.x, y + v.y }; }
+    constexpr Vec2 operator-(const Vec2 v) const { return { x - v.x, y - v.y }; }
+    constexpr Vec2 operator*(const Vec2 v) const { return { x * v.x, y * v.y }; }
+    constexpr Vec2 operator*(float s) const { return { x * s, y * s }; }
+    constexpr Vec2 operator/(const Vec2 v) const { return { x / v.x, y / v.y }; }
+    constexpr bool operator==(const Vec2& v) const = default;
+};
+
+// read straight out of game memory, the layout has to stay two packed floats
+static_assert(sizeof(Vec2) == 8);
@@ -1,20 +1,28 @@
 #pragma once
+#include <glm/vec3.hpp>
 
 struct Vec3 {
-    float x;
-    float y;
-    float z;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
 
-    Vec3();
-    Vec3(float x, float y, float z);
-    Vec3(const Vec3& v);
+    constexpr Vec3() = default;
+    constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+    constexpr Vec3(const glm::vec3& v) : x(v.x), y(v.y), z(v.z) {}
 
-    Vec3 operator+(const Vec3 v) const;
-    Vec3 operator-(const Vec3 v) const;
-    Vec3 operator*(const Vec3 v) const;
-    Vec3 operator*(float s) const;
-    Vec3 operator/(const Vec3 v) const;
-    bool operator==(const Vec3 v) const;
+    constexpr operator glm::vec3() const { return { x, y, z }; }
 
-    static Vec3 lerp(const Vec3& a, const Vec3& b, float t);
-};
\ No newline at end of file
+    constexpr Vec3 operator+(const Vec3 v) const { return { x + v.x, y + v.y, z + v.z }; }
+    constexpr Vec3 operator-(const Vec3 v) const { return { x - v.x, y - v.y, z - v.z }; }
+    constexpr Vec3 operator*(const Vec3 v) const { return { x * v.x, y * v.y, z * v.z }; }
+    constexpr Vec3 operator*(float s) const { return { x * s, y * s, z * s }; }
+    constexpr Vec3 operator/(const Vec3 v) const { return { x / v.x, y / v.y, z / v.z }; }
+    // exact, positions the game hands back unchanged compare equal
+    constexpr bool operator==(const Vec3& v) const = default;
+
+    static constexpr Vec3 lerp(const Vec3& a, const Vec3& b, float t) {
+        return a + (b - a) * t;
+    }
+};
+
+static_assert(sizeof(Vec3) == 12);
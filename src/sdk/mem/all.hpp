@@ -2,4 +2,6 @@
 #include "process.hpp"
 #include "signatures.hpp"
 #include "storage.hpp"
-#include "symbols.hpp"
\ No newline at end of file
+#include "symbols.hpp"
+#include "vtables.hpp"
+#include "exports.hpp"
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "exports.hpp"
+#include "process.hpp"
+
+#include <cstring>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+namespace selaura {
+#ifdef SELAURA_WINDOWS
+    void* find_export(std::string_view name) {
+        const auto& process = selaura::get_cached_handle();
+        return reinterpret_cast<void*>(GetProcAddress(reinterpret_cast<HMODULE>(process.native), std::string(name).c_str()));
+    }
+#else
+    namespace {
+        struct export_table {
+            const std::byte* base = nullptr;
+            const ElfW(Sym)* symbols = nullptr;
+            const char* strings = nullptr;
+            const uint32_t* gnu_hash = nullptr;
+        };
+
+        export_table load_exports() {
+            export_table table{ selaura::get_cached_handle().base };
+
+            dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) -> int {
+                auto* table = reinterpret_cast<export_table*>(data);
+                if (reinterpret_cast<const std::byte*>(info->dlpi_addr) != table->base) return 0;
+
+                for (int i = 0; i < info->dlpi_phnum; ++i) {
+                    const auto& phdr = info->dlpi_phdr[i];
+                    if (phdr.p_type != PT_DYNAMIC) continue;
+
+                    // glibc relocates these in place, bionic leaves them as vaddrs
+                    auto address = [&](ElfW(Addr) ptr) {
+                        return ptr < info->dlpi_addr ? reinterpret_cast<const std::byte*>(info->dlpi_addr + ptr) : reinterpret_cast<const std::byte*>(ptr);
+                    };
+
+                    for (auto* dyn = reinterpret_cast<const ElfW(Dyn)*>(info->dlpi_addr + phdr.p_vaddr); dyn->d_tag != DT_NULL; ++dyn) {
+                        switch (dyn->d_tag) {
+                            case DT_SYMTAB: table->symbols = reinterpret_cast<const ElfW(Sym)*>(address(dyn->d_un.d_ptr)); break;
+                            case DT_STRTAB: table->strings = reinterpret_cast<const char*>(address(dyn->d_un.d_ptr)); break;
+                            case DT_GNU_HASH: table->gnu_hash = reinterpret_cast<const uint32_t*>(address(dyn->d_un.d_ptr)); break;
+                        }
+                    }
+                }
+                return 1;
+            }, &table);
+
+            if (!table.symbols || !table.strings || !table.gnu_hash) {
+                spdlog::warn("Game image has no .gnu.hash, exported symbols are unavailable");
+                table.gnu_hash = nullptr;
+            }
+            return table;
+        }
+
+        constexpr uint32_t gnu_hash(std::string_view name) {
+            uint32_t hash = 5381;
+            for (char c : name) {
+                hash = hash * 33 + static_cast<unsigned char>(c);
+            }
+            return hash;
+        }
+    }
+
+    void* find_export(std::string_view name) {
+        static const export_table table = load_exports();
+        if (!table.gnu_hash) return nullptr;
+
+        const uint32_t bucket_count = table.gnu_hash[0];
+        const uint32_t first_symbol = table.gnu_hash[1];
+        const uint32_t bloom_size = table.gnu_hash[2];
+        const uint32_t bloom_shift = table.gnu_hash[3];
+
+        const auto* bloom = reinterpret_cast<const ElfW(Addr)*>(table.gnu_hash + 4);
+        const auto* buckets = reinterpret_cast<const uint32_t*>(bloom + bloom_size);
+        const auto* chain = buckets + bucket_count;
+
+        constexpr uint32_t word_bits = sizeof(ElfW(Addr)) * 8;
+        const uint32_t hash = gnu_hash(name);
+
+        // the bloom filter rejects nearly every missing name without touching the buckets
+        const auto word = bloom[(hash / word_bits) % bloom_size];
+        const auto mask = (ElfW(Addr){ 1 } << (hash % word_bits)) | (ElfW(Addr){ 1 } << ((hash >> bloom_shift) % word_bits));
+        if ((word & mask) != mask) return nullptr;
+
+        uint32_t index = buckets[hash % bucket_count];
+        if (index < first_symbol) return nullptr;
+
+        for (;; ++index) {
+            const uint32_t entry = chain[index - first_symbol];
+            const auto& symbol = table.symbols[index];
+
+            if ((entry | 1) == (hash | 1) && symbol.st_shndx != SHN_UNDEF && name == table.strings + symbol.st_name) {
+                return const_cast<std::byte*>(table.base + symbol.st_value);
+            }
+            if (entry & 1) break;
+        }
+        return nullptr;
+    }
+#endif
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string_view>
+
+namespace selaura {
+    // address of a symbol the game image exports by its mangled name, nullptr when it is not exported
+    // elf images are looked up through .gnu.hash, pe images through the export directory
+    void* find_export(std::string_view name);
+};
@@ -1,5 +1,9 @@
 #include "process.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <format>
+
 selaura::process selaura::get_handle() {
 #ifdef SELAURA_WINDOWS
     std::string_view name = "Minecraft.Windows.exe";
@@ -13,11 +17,26 @@ selaura::process selaura::get_handle() {
         throw std::runtime_error("GetModuleInformation failed.");
     }
 
-    return {
+    auto* dos = reinterpret_cast<PIMAGE_DOS_HEADER>(moduleInfo.lpBaseOfDll);
+    auto* nt = reinterpret_cast<PIMAGE_NT_HEADERS>(reinterpret_cast<std::byte*>(moduleInfo.lpBaseOfDll) + dos->e_lfanew);
+
+    process detail{
         reinterpret_cast<std::byte*>(moduleInfo.lpBaseOfDll),
         moduleInfo.SizeOfImage,
         reinterpret_cast<void*>(hModule)
     };
+
+    auto* section_header = IMAGE_FIRST_SECTION(nt);
+    for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section_header) {
+        detail.sections.push_back({
+            detail.base + section_header->VirtualAddress,
+            section_header->Misc.VirtualSize,
+            (section_header->Characteristics & IMAGE_SCN_MEM_EXECUTE) != 0
+        });
+    }
+
+    detail.fingerprint = std::format("{:08X}{:08X}{:08X}", nt->FileHeader.TimeDateStamp, nt->OptionalHeader.CheckSum, nt->OptionalHeader.SizeOfImage);
+    return detail;
 #else
     std::string_view name = "libminecraftpe.so";
     void* handle = dlopen(name.data(), RTLD_NOLOAD);
@@ -32,16 +51,53 @@ selaura::process selaura::get_handle() {
         auto* detail = reinterpret_cast<process*>(data);
         if (info->dlpi_name && std::string_view(info->dlpi_name).contains("libminecraftpe.so")) {
             detail->base = reinterpret_cast<std::byte*>(info->dlpi_addr);
-            detail->size = info->dlpi_phdr[1].p_memsz;
+            detail->size = 0;
+
+            for (int i = 0; i < info->dlpi_phnum; ++i) {
+                const auto& phdr = info->dlpi_phdr[i];
+                if (phdr.p_type != PT_LOAD) continue;
+
+                detail->sections.push_back({
+                    detail->base + phdr.p_vaddr,
+                    phdr.p_memsz,
+                    (phdr.p_flags & PF_X) != 0
+                });
+                detail->size = std::max<std::size_t>(detail->size, phdr.p_vaddr + phdr.p_memsz);
+            }
+
+            for (int i = 0; i < info->dlpi_phnum; ++i) {
+                const auto& phdr = info->dlpi_phdr[i];
+                if (phdr.p_type != PT_NOTE) continue;
+
+                auto* note = reinterpret_cast<const std::byte*>(info->dlpi_addr + phdr.p_vaddr);
+                auto* note_end = note + phdr.p_memsz;
+
+                while (note + sizeof(ElfW(Nhdr)) <= note_end) {
+                    auto* header = reinterpret_cast<const ElfW(Nhdr)*>(note);
+                    auto* name = note + sizeof(ElfW(Nhdr));
+                    auto* desc = name + ((header->n_namesz + 3) & ~3u);
+
+                    if (header->n_type == NT_GNU_BUILD_ID && header->n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0) {
+                        for (std::size_t j = 0; j < header->n_descsz; ++j) {
+                            detail->fingerprint += std::format("{:02x}", static_cast<unsigned>(desc[j]));
+                        }
+                        break;
+                    }
+
+                    note = desc + ((header->n_descsz + 3) & ~3u);
+                }
+            }
             return 1;
         }
         return 0;
     }, &detail);
 
-    return {
-        detail.base,
-        detail.size,
-        detail.native
-    };
+    std::ranges::sort(detail.sections, {}, &section::base);
+    return detail;
 #endif
-};
\ No newline at end of file
+};
+
+const selaura::process& selaura::get_cached_handle() {
+    static auto process = selaura::get_handle();
+    return process;
+}
\ No newline at end of file
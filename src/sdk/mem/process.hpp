@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 #include <optional>
 #include <cstddef>
@@ -8,6 +9,7 @@
 #include <stdexcept>
 #include <utility>
 #include <type_traits>
+#include <vector>
 
 #include <libhat/scanner.hpp>
 
@@ -20,12 +22,25 @@
 #endif
 
 namespace selaura {
+    struct section {
+        std::byte* base;
+        std::size_t size;
+        bool executable;
+    };
+
     struct process {
         std::byte* base;
         std::size_t size;
 
         void* native;
+
+        // .text and friends on pe, PT_LOAD segments on elf, sorted by address
+        std::vector<section> sections;
+
+        // identifies the exact game build, pe timestamp + checksum on windows, gnu build-id on elf
+        std::string fingerprint;
     };
 
     selaura::process get_handle();
+    const selaura::process& get_cached_handle();
 };
\ No newline at end of file
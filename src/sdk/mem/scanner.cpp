@@ -0,0 +1,187 @@
+#include "scanner.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SELAURA_SCAN_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SELAURA_SCAN_NEON
+#endif
+
+namespace selaura {
+    namespace {
+        constexpr std::size_t max_simd_anchors = 16;
+        constexpr std::size_t min_shard_size = 1 << 20;
+
+        bool matches(const scan_target& target, const std::byte* start) {
+            return pattern_matches(target.signature, start);
+        }
+
+        struct scan_state {
+            std::span<scan_target> targets;
+            const std::byte* begin;
+            const std::byte* end;
+            std::array<std::vector<std::uint16_t>, 256> buckets{};
+            std::size_t remaining = 0;
+
+            // called for every position whose byte is one of the anchors
+            void candidate(const std::byte* at) {
+                auto& bucket = buckets[static_cast<std::uint8_t>(*at)];
+                for (std::size_t i = 0; i < bucket.size();) {
+                    auto& target = targets[bucket[i]];
+                    const std::byte* start = at - target.anchor;
+
+                    if (start >= begin && start + target.signature.size() <= end && matches(target, start)) {
+                        target.result = reinterpret_cast<uintptr_t>(start);
+                        bucket[i] = bucket.back();
+                        bucket.pop_back();
+                        --remaining;
+                        continue;
+                    }
+                    ++i;
+                }
+            }
+        };
+    }
+
+    bool pattern_matches(hat::signature_view signature, const std::byte* at) {
+        for (std::size_t i = 0; i < signature.size(); ++i) {
+            if (!(signature[i] == at[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void find_patterns(std::span<scan_target> targets, const std::byte* begin, const std::byte* end) {
+        scan_state state{ targets, begin, end };
+
+        std::vector<std::uint8_t> anchors;
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            auto& target = targets[i];
+            if (target.result || target.signature.empty() || !target.signature[target.anchor].has_value()) continue;
+
+            const auto value = static_cast<std::uint8_t>(target.signature[target.anchor].value());
+            if (state.buckets[value].empty()) {
+                anchors.push_back(value);
+            }
+            state.buckets[value].push_back(static_cast<std::uint16_t>(i));
+            ++state.remaining;
+        }
+
+        if (state.remaining == 0 || begin >= end) return;
+
+        const std::byte* it = begin;
+
+#if defined(SELAURA_SCAN_SSE2) || defined(SELAURA_SCAN_NEON)
+        if (anchors.size() <= max_simd_anchors) {
+            constexpr std::size_t lanes = 16;
+
+#if defined(SELAURA_SCAN_SSE2)
+            __m128i needles[max_simd_anchors];
+            for (std::size_t i = 0; i < anchors.size(); ++i) {
+                needles[i] = _mm_set1_epi8(static_cast<char>(anchors[i]));
+            }
+#else
+            uint8x16_t needles[max_simd_anchors];
+            for (std::size_t i = 0; i < anchors.size(); ++i) {
+                needles[i] = vdupq_n_u8(anchors[i]);
+            }
+#endif
+
+            for (; it + lanes <= end && state.remaining > 0; it += lanes) {
+#if defined(SELAURA_SCAN_SSE2)
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+                __m128i hits = _mm_setzero_si128();
+                for (std::size_t i = 0; i < anchors.size(); ++i) {
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, needles[i]));
+                }
+
+                auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+                while (mask) {
+                    state.candidate(it + std::countr_zero(mask));
+                    mask &= mask - 1;
+                }
+#else
+                const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(it));
+                uint8x16_t hits = vdupq_n_u8(0);
+                for (std::size_t i = 0; i < anchors.size(); ++i) {
+                    hits = vorrq_u8(hits, vceqq_u8(chunk, needles[i]));
+                }
+
+                // narrow to four bits per lane so the hit mask fits in one 64-bit register
+                auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+                while (mask) {
+                    const int lane = std::countr_zero(mask) >> 2;
+                    state.candidate(it + lane);
+                    mask &= ~(std::uint64_t{ 0xF } << (lane * 4));
+                }
+#endif
+            }
+        }
+#endif
+
+        for (; it < end && state.remaining > 0; ++it) {
+            if (!state.buckets[static_cast<std::uint8_t>(*it)].empty()) {
+                state.candidate(it);
+            }
+        }
+    }
+
+    void find_patterns_parallel(std::span<scan_target> targets, const std::byte* begin, const std::byte* end, unsigned int max_threads) {
+        const std::size_t size = end > begin ? static_cast<std::size_t>(end - begin) : 0;
+        const unsigned int threads = std::clamp(std::thread::hardware_concurrency(), 1u, std::max(max_threads, 1u));
+
+        if (threads == 1 || size < min_shard_size * 2) {
+            find_patterns(targets, begin, end);
+            return;
+        }
+
+        std::size_t overlap = 0;
+        for (const auto& target : targets) {
+            overlap = std::max(overlap, target.signature.size());
+        }
+
+        // a few shards per thread keeps every core busy when some shards finish early
+        const std::size_t shard_count = std::min<std::size_t>(threads * 4, size / min_shard_size);
+        const std::size_t shard_size = (size + shard_count - 1) / shard_count;
+
+        std::vector<std::vector<scan_target>> shard_results(shard_count, std::vector<scan_target>(targets.begin(), targets.end()));
+        std::atomic<std::size_t> next_shard{ 0 };
+
+        auto worker = [&]() {
+            for (std::size_t shard = next_shard++; shard < shard_count; shard = next_shard++) {
+                const std::byte* shard_begin = begin + shard * shard_size;
+                const std::byte* shard_end = begin + std::min(size, (shard + 1) * shard_size + overlap);
+                find_patterns(shard_results[shard], shard_begin, shard_end);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned int i = 1; i < threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            for (const auto& shard : shard_results) {
+                if (!shard[i].result) continue;
+                if (!targets[i].result || *shard[i].result < *targets[i].result) {
+                    targets[i].result = shard[i].result;
+                }
+            }
+        }
+    }
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <libhat/scanner.hpp>
+
+namespace selaura {
+    struct scan_target {
+        hat::signature_view signature;
+        std::size_t anchor = 0;
+        std::optional<uintptr_t> result;
+    };
+
+    bool pattern_matches(hat::signature_view signature, const std::byte* at);
+
+    // bytes that show up constantly in x64 and arm64 code, they make poor anchors
+    constexpr int byte_frequency(std::byte value) {
+        switch (static_cast<std::uint8_t>(value)) {
+            case 0x00: case 0xFF: case 0xCC:
+                return 4;
+            case 0x48: case 0x89: case 0x8B: case 0x4C: case 0x8D: case 0x24:
+            case 0xE8: case 0x83: case 0x0F: case 0x44: case 0x41: case 0xC3:
+            case 0x85: case 0xC0: case 0x01: case 0x91: case 0xA9: case 0xF9:
+            case 0xAA: case 0xD1:
+                return 2;
+            default:
+                return 0;
+        }
+    }
+
+    // index of the least common concrete byte in the signature, used to prefilter candidates
+    constexpr std::size_t select_anchor(hat::signature_view signature) {
+        std::size_t best = 0;
+        int best_score = -1;
+
+        for (std::size_t i = 0; i < signature.size(); ++i) {
+            if (!signature[i].has_value()) continue;
+
+            const int score = 8 - byte_frequency(signature[i].value());
+            if (score > best_score) {
+                best = i;
+                best_score = score;
+            }
+        }
+        return best;
+    }
+
+    // resolves every target in a single pass over [begin, end), each result is the lowest matching address
+    void find_patterns(std::span<scan_target> targets, const std::byte* begin, const std::byte* end);
+
+    // same contract as find_patterns, with the range split into overlapping shards scanned on a small worker pool
+    void find_patterns_parallel(std::span<scan_target> targets, const std::byte* begin, const std::byte* end, unsigned int max_threads = 8);
+};
@@ -3,23 +3,29 @@
 #include <spdlog/spdlog.h>
 
 namespace selaura {
-    inline std::optional<uintptr_t> find_pattern(std::string_view pattern) {
-        const auto parsed = hat::parse_signature(pattern);
-        if (!parsed.has_value()) {
-            spdlog::error("Invalid signature! {:s}", pattern);
-            return std::nullopt;
-        }
+    // only executable sections are searched unless include_data is set
+    inline std::optional<uintptr_t> find_pattern(hat::signature_view signature, bool include_data = false) {
+        const auto& process = selaura::get_cached_handle();
 
-        static auto process = selaura::get_handle();
+        for (const auto& section : process.sections) {
+            if (!section.executable && !include_data) continue;
 
-        const auto begin = process.base;
-        const auto end = begin + process.size;
-        const auto result = hat::find_pattern(begin, end, parsed.value());
+            const auto result = hat::find_pattern(section.base, section.base + section.size, signature);
+            if (result.has_result()) {
+                return reinterpret_cast<uintptr_t>(result.get());
+            }
+        }
+        return std::nullopt;
+    }
 
-        if (!result.has_result()) {
+    // for patterns only known at runtime, anything declared in source should use _sig instead
+    inline std::optional<uintptr_t> find_pattern(std::string_view pattern, bool include_data = false) {
+        const auto parsed = hat::parse_signature(pattern);
+        if (!parsed.has_value()) {
+            spdlog::error("Invalid signature! {:s}", pattern);
             return std::nullopt;
         }
-        return reinterpret_cast<uintptr_t>(result.get());
+        return find_pattern(parsed.value(), include_data);
     }
 
     inline uintptr_t offset_from_sig(uintptr_t sig, int offset) {
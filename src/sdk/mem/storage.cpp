@@ -0,0 +1,181 @@
+#include "storage.hpp"
+#include "scanner.hpp"
+#include "../../profiler/profiler.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace selaura {
+	namespace {
+		constexpr std::string_view cache_header = "selaura-signatures 1";
+
+		std::string_view trim(std::string_view text) {
+			while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+			while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+			return text;
+		}
+
+		std::unordered_map<std::string, uintptr_t> load_cache(const std::filesystem::path& cache_file, std::string_view fingerprint) {
+			std::unordered_map<std::string, uintptr_t> rvas;
+			if (cache_file.empty() || fingerprint.empty()) return rvas;
+
+			std::ifstream file(cache_file);
+			std::string header, build;
+			if (!std::getline(file, header) || header != cache_header) return rvas;
+			if (!std::getline(file, build) || build != fingerprint) return rvas;
+
+			std::string line;
+			while (std::getline(file, line)) {
+				auto separator = line.find('\t');
+				if (separator == std::string::npos) continue;
+
+				// a line that doesn't parse means the file was damaged, none of it is trusted and the next save replaces it
+				const std::string_view value = std::string_view(line).substr(separator + 1);
+				uintptr_t rva = 0;
+				const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), rva, 16);
+				if (ec != std::errc{} || end != value.data() + value.size()) {
+					spdlog::warn("Ignoring damaged signature cache {}", cache_file.filename().string());
+					return {};
+				}
+
+				rvas.emplace(line.substr(0, separator), rva);
+			}
+			return rvas;
+		}
+
+		void save_cache(const std::filesystem::path& cache_file, std::string_view fingerprint, const std::unordered_map<std::string, uintptr_t>& rvas) {
+			if (cache_file.empty() || fingerprint.empty()) return;
+
+			auto temp_file = cache_file;
+			temp_file += ".tmp";
+
+			{
+				std::ofstream file(temp_file, std::ios::trunc);
+				file << cache_header << '\n' << fingerprint << '\n';
+				for (const auto& [name, rva] : rvas) {
+					file << name << '\t' << std::hex << rva << '\n';
+				}
+			}
+
+			std::error_code ec;
+			std::filesystem::rename(temp_file, cache_file, ec);
+			if (ec) {
+				spdlog::error("Failed to write signature cache: {}", ec.message());
+			}
+		}
+	}
+
+	void load_offset_overrides(const std::filesystem::path& file, std::span<offset_symbol_base* const> symbols) {
+		std::ifstream overrides(file);
+		if (!overrides) return;
+
+		std::string line;
+		while (std::getline(overrides, line)) {
+			auto separator = line.find('=');
+			if (line.empty() || line.front() == '#' || separator == std::string::npos) continue;
+
+			const std::string_view name = trim(std::string_view(line).substr(0, separator));
+			auto symbol = std::ranges::find(symbols, name, &offset_symbol_base::name);
+			if (symbol == symbols.end()) {
+				spdlog::warn("Unknown offset override: {}", name);
+				continue;
+			}
+
+			// hex with a 0x prefix, decimal otherwise
+			std::string_view value = trim(std::string_view(line).substr(separator + 1));
+			int base = 10;
+			if (value.starts_with("0x") || value.starts_with("0X")) {
+				value.remove_prefix(2);
+				base = 16;
+			}
+
+			uintptr_t offset = 0;
+			const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), offset, base);
+			if (value.empty() || ec != std::errc{} || end != value.data() + value.size()) {
+				spdlog::error("Offset override {} is not a number: {}", name, line.substr(separator + 1));
+				continue;
+			}
+
+			(*symbol)->override_offset = offset;
+			spdlog::info("Overriding offset {} with {:#x}", name, offset);
+		}
+	}
+
+	void resolve_signatures(std::span<const signature_symbol_base* const> symbols, const std::filesystem::path& cache_file) {
+		SELAURA_TRACE_SCOPE("resolve_signatures");
+		auto startTime = std::chrono::steady_clock::now();
+
+		const auto& process = selaura::get_cached_handle();
+		const auto* image_begin = process.base;
+		const auto* image_end = process.base + process.size;
+
+		auto rvas = load_cache(cache_file, process.fingerprint);
+		bool cache_dirty = false;
+
+		std::vector<scan_target> targets;
+		std::vector<const signature_symbol_base*> owners;
+		std::vector<std::ptrdiff_t> offsets;
+		std::size_t cache_hits = 0;
+		std::size_t exports = 0;
+
+		for (const auto* symbol : symbols) {
+			if (symbol->cached) continue;
+
+			if (!symbol->export_name.empty()) {
+				symbol->cached = find_export(symbol->export_name);
+				if (symbol->cached) {
+					++exports;
+					continue;
+				}
+			}
+
+			const auto& info = symbol->current();
+			if (info.pattern.empty()) continue;
+
+			if (auto cached = rvas.find(std::string(symbol->name)); cached != rvas.end() && cached->second < process.size) {
+				const auto* at = image_begin + cached->second;
+				if (info.pattern.size() <= static_cast<std::size_t>(image_end - at) && pattern_matches(info.pattern, at)) {
+					symbol->cached = const_cast<std::byte*>(at) + info.offset;
+					++cache_hits;
+					continue;
+				}
+			}
+
+			targets.push_back({ info.pattern, info.anchor });
+			owners.push_back(symbol);
+			offsets.push_back(info.offset);
+		}
+
+		for (const auto& section : process.sections) {
+			if (targets.empty()) break;
+			if (!section.executable) continue;
+
+			SELAURA_TRACE_SCOPE("find_patterns_parallel");
+			find_patterns_parallel(targets, section.base, section.base + section.size);
+		}
+
+		std::size_t resolved = 0;
+		for (std::size_t i = 0; i < targets.size(); ++i) {
+			if (!targets[i].result.has_value()) {
+				spdlog::error("Signature not valid! {}", owners[i]->name);
+				continue;
+			}
+
+			owners[i]->cached = reinterpret_cast<void*>(*targets[i].result + offsets[i]);
+			rvas[std::string(owners[i]->name)] = *targets[i].result - reinterpret_cast<uintptr_t>(image_begin);
+			cache_dirty = true;
+			++resolved;
+		}
+
+		if (cache_dirty) {
+			save_cache(cache_file, process.fingerprint, rvas);
+		}
+
+		std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+		spdlog::info("Resolved {}/{} signatures, {} from exports, {} from cache [{:.2f}ms]", resolved + cache_hits + exports, targets.size() + cache_hits + exports, exports, cache_hits, duration.count());
+	}
+}
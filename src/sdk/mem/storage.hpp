@@ -4,9 +4,15 @@
 #include <string_view>
 #include <stdexcept>
 #include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
 
 #include "process.hpp"
+#include "scanner.hpp"
 #include "signatures.hpp"
+#include "vtables.hpp"
+#include "exports.hpp"
 
 #include <spdlog/spdlog.h>
 
@@ -38,60 +44,186 @@ namespace selaura {
 		using type = T;
 	};
 
-	template <typename T>
-	struct signature_symbol : base_symbol<T> {
-		struct signature_info {
-			std::string_view pattern;
-			std::ptrdiff_t offset = 0;
-		};
+	// one copy of each parsed signature in read-only data, shared by every symbol declaring the same pattern
+	template <hat::fixed_string pattern>
+	inline constexpr auto compiled_signature = hat::compile_signature<pattern>();
+
+	namespace literals {
+		// a malformed pattern fails the build instead of logging at startup
+		template <hat::fixed_string pattern>
+		consteval hat::signature_view operator""_sig() {
+			return compiled_signature<pattern>;
+		}
+	}
+
+	struct signature_info {
+		hat::signature_view pattern;
+		std::ptrdiff_t offset = 0;
+		std::size_t anchor = select_anchor(pattern);
+	};
+
+	// one slot per platform so a symbol table is a plain constant, an empty pattern means the platform has none
+	struct platform_signatures {
+		signature_info windows;
+		signature_info android;
+		signature_info linux_platform;
+
+		constexpr const signature_info& get(platform target) const {
+			switch (target) {
+				case platform::windows: return windows;
+				case platform::android: return android;
+				case platform::linux_platform: return linux_platform;
+			}
+			return windows;
+		}
+	};
 
+	struct signature_symbol_base {
 		std::string_view name;
-		std::unordered_map<platform, signature_info> platform_signatures;
+		platform_signatures signatures;
+		// the only state, zero until a scan or resolve fills it
 		mutable void* cached = nullptr;
+		// mangled name tried in the image's exports before any scan, empty for plain signatures
+		std::string_view export_name;
 
-		signature_symbol(std::string_view nm, std::unordered_map<platform, signature_info> list)
-			: name(nm), platform_signatures(list) {
+		constexpr const signature_info& current() const {
+			return signatures.get(current_platform);
 		}
+	};
+
+	template <typename T>
+	struct signature_symbol : base_symbol<T>, signature_symbol_base {
+		using signature_info = selaura::signature_info;
+
+		constexpr signature_symbol(std::string_view nm, platform_signatures list)
+			: signature_symbol_base{ nm, list } {}
 
 		void* resolve() const override {
-			auto it = platform_signatures.find(current_platform);
-			if (it == platform_signatures.end()) {
+			const auto& info = this->current();
+			if (info.pattern.empty()) {
 				spdlog::error("No symbol for current platform: {}", name);
 				return nullptr;
 			}
 
 			if (!cached) {
-				auto base = find_pattern(it->second.pattern);
+				auto base = find_pattern(info.pattern);
 				if (!base.has_value()) {
 					spdlog::error("Signature not valid! {}", name);
 					return nullptr;
 				}
-				cached = reinterpret_cast<void*>(*base + it->second.offset);
+				cached = reinterpret_cast<void*>(*base + info.offset);
 			}
 			return cached;
 		}
 	};
 
-	struct offset_symbol {
-		struct offset_info {
-			uintptr_t offset;
-		};
+	// an exported function looked up by mangled name, scanning for the signatures only when the image does not export it
+	template <typename T>
+	struct symbol_symbol : signature_symbol<T> {
+		constexpr symbol_symbol(std::string_view nm, std::string_view exported, platform_signatures fallback = {})
+			: signature_symbol<T>(nm, fallback) {
+			this->export_name = exported;
+		}
+
+		void* resolve() const override {
+			if (!this->cached) {
+				this->cached = find_export(this->export_name);
+			}
+			return this->cached ? this->cached : signature_symbol<T>::resolve();
+		}
+	};
+
+	// resolves every listed symbol in one scan, cache_file keeps resolved rvas per game build and hits are verified in place instead of rescanned
+	void resolve_signatures(std::span<const signature_symbol_base* const> symbols, const std::filesystem::path& cache_file = {});
 
-		std::string_view name;
-		std::unordered_map<platform, offset_info> platform_offsets;
+	struct platform_offsets {
+		uintptr_t windows = 0;
+		uintptr_t android = 0;
+		uintptr_t linux_platform = 0;
 
-		offset_symbol(std::string_view nm, std::unordered_map<platform, offset_info> list)
-			: name(nm), platform_offsets(list) {
+		constexpr uintptr_t get(platform target) const {
+			switch (target) {
+				case platform::windows: return windows;
+				case platform::android: return android;
+				case platform::linux_platform: return linux_platform;
+			}
+			return 0;
 		}
+	};
+
+	struct offset_symbol_base {
+		std::string_view name;
+		// set from offsets.txt when a game update moves a field before we ship new offsets, 0 is a valid override
+		std::optional<uintptr_t> override_offset;
+	};
+
+	template <platform_offsets offsets>
+	struct offset_symbol : offset_symbol_base {
+		static constexpr uintptr_t offset = offsets.get(current_platform);
+
+		constexpr offset_symbol(std::string_view nm) : offset_symbol_base{ nm } {}
 
 		uintptr_t resolve() const {
-			auto it = platform_offsets.find(current_platform);
-			if (it == platform_offsets.end()) {
-				spdlog::error("No symbol for current platform: {}", name);
-				return 0;
+			if (override_offset) [[unlikely]] {
+				return *override_offset;
+			}
+			return offset;
+		}
+	};
+
+	// reads "Name=0x1234" lines and applies them to the matching symbols
+	void load_offset_overrides(const std::filesystem::path& file, std::span<offset_symbol_base* const> symbols);
+
+	// vtable slots differ between abis, itanium has two destructor entries where msvc has one
+	struct platform_indices {
+		int windows = -1;
+		int android = -1;
+		int linux_platform = -1;
+
+		constexpr int get(platform target) const {
+			switch (target) {
+				case platform::windows: return windows;
+				case platform::android: return android;
+				case platform::linux_platform: return linux_platform;
 			}
+			return -1;
+		}
+	};
+
+	// a virtual function named by its class and slot, found through rtti so it survives updates that only move code
+	template <typename T>
+	struct vtable_symbol : base_symbol<T> {
+		std::string_view type_name;
+		platform_indices indices;
+		mutable void* cached = nullptr;
+
+		constexpr vtable_symbol(std::string_view type, platform_indices list)
+			: type_name(type), indices(list) {}
 
-			return it->second.offset;
+		constexpr int index() const {
+			return indices.get(current_platform);
+		}
+
+		// for calling through the slot, whoever enables the caller checks index() first, see render_hooks
+		std::size_t slot() const {
+			return static_cast<std::size_t>(index());
+		}
+
+		void* resolve() const override {
+			if (!cached) {
+				if (index() < 0) {
+					spdlog::error("No symbol for current platform: {}::{}", type_name, index());
+					return nullptr;
+				}
+
+				const auto* vtable = find_vtable(type_name);
+				if (!vtable) {
+					spdlog::error("No vtable for {}", type_name);
+					return nullptr;
+				}
+				cached = reinterpret_cast<void*>(vtable[index()]);
+			}
+			return cached;
 		}
 	};
 
@@ -18,158 +18,142 @@
 #endif
 
 namespace selaura::signatures {
+    using namespace selaura::literals;
 
     using splashtextrenderer_render_t = void(THISCALL*)(MinecraftUIRenderContext* ctx, ClientInstance* ci, UIControl* owner, int pass, void* renderAABB);
-    inline signature_symbol<splashtextrenderer_render_t> splashtextrenderer_render{
+    inline constinit signature_symbol<splashtextrenderer_render_t> splashtextrenderer_render{
         "SplashTextRenderer::render",
-{
-                { selaura::platform::windows, { "48 89 5C 24 18 55 56 57 48 8D AC 24 50 FC FF FF 48 81 EC B0 04 00 00 48 8B FA" } },
-             }
+        {
+            .windows = { "48 89 5C 24 18 55 56 57 48 8D AC 24 50 FC FF FF 48 81 EC B0 04 00 00 48 8B FA"_sig }
+        }
     };
 
     using minecraftgame_update_t = void(THISCALL*)();
-    inline signature_symbol<minecraftgame_update_t> minecraftgame_update{
+    inline constinit symbol_symbol<minecraftgame_update_t> minecraftgame_update{
         "MinecraftGame::update",
+        "_ZN13MinecraftGame6updateEv",
         {
-            { selaura::platform::windows, { "48 8B C4 48 89 58 10 48 89 70 18 48 89 78 20 55 41 54 41 55 41 56 41 57 48 8D A8 F8 F6" } },
-            // 1.21.80: { selaura::platform::windows, { "48 8B C4 48 89 58 10 48 89 70 18 48 89 78 20 55 41 54 41 55 41 56 41 57 48 8D A8 18 F7" } },
-            { selaura::platform::android, { "? ? ? FC ? ? ? A9 ? ? ? 91 ? ? ? A9 ? ? ? A9 ? ? ? A9 ? ? ? A9 ? ? ? A9 ? ? ? D1 ? ? ? D5 F3 03 00 AA ? ? ? F9 ? ? ? F8 ? ? ? F9 ? ? ? 95" } }
+            .windows = { "48 8B C4 48 89 58 10 48 89 70 18 48 89 78 20 55 41 54 41 55 41 56 41 57 48 8D A8 F8 F6"_sig },
+            // 1.21.80: .windows = { "48 8B C4 48 89 58 10 48 89 70 18 48 89 78 20 55 41 54 41 55 41 56 41 57 48 8D A8 18 F7"_sig },
+            .android = { "? ? ? FC ? ? ? A9 ? ? ? 91 ? ? ? A9 ? ? ? A9 ? ? ? A9 ? ? ? A9 ? ? ? A9 ? ? ? D1 ? ? ? D5 F3 03 00 AA ? ? ? F9 ? ? ? F8 ? ? ? F9 ? ? ? 95"_sig }
         }
     };
 
 	using screenview_setupandrender_t = void(THISCALL*)(void*);
-    inline signature_symbol<screenview_setupandrender_t> screenview_setupandrender{
+    inline constinit signature_symbol<screenview_setupandrender_t> screenview_setupandrender{
         "ScreenView::SetupAndRender",
         {
-            { selaura::platform::windows, { "48 8B C4 48 89 58 18 55 56 57 41 54 41 55 41 56 41 57 48 8D A8 98 FD" } },
-            { selaura::platform::android, { "todo: find this" } }
+            .windows = { "48 8B C4 48 89 58 18 55 56 57 41 54 41 55 41 56 41 57 48 8D A8 98 FD"_sig },
+            // .android: todo, find this
         }
 	};
 
     using tessellator_begin_t = void(THISCALL*)(Tessellator*, mce::PrimitiveMode, const int, const bool);
-    inline signature_symbol<tessellator_begin_t> tessellator_begin{
+    inline constinit signature_symbol<tessellator_begin_t> tessellator_begin{
         "Tessellator::begin",
         {
-            { selaura::platform::windows, { "40 53 55 48 83 EC 28 80 B9" } },
-            { selaura::platform::android, { "todo: find this" } }
+            .windows = { "40 53 55 48 83 EC 28 80 B9"_sig },
+            // .android: todo, find this
         }
     };
 
     using tessellator_vertexuv_t = void(THISCALL*)(Tessellator*, float, float, float, float, float);
-    inline signature_symbol<tessellator_vertexuv_t> tessellator_vertexuv{
+    inline constinit signature_symbol<tessellator_vertexuv_t> tessellator_vertexuv{
         "Tessellator::vertexUV",
         {
-            { selaura::platform::windows, { "48 83 EC ? 80 B9 ? ? ? ? ? 0F 57 E4" } },
-            { selaura::platform::android, { "todo: find this" } }
+            .windows = { "48 83 EC ? 80 B9 ? ? ? ? ? 0F 57 E4"_sig },
+            // .android: todo, find this
         }
     };
 
     using tessellator_color_t = void(THISCALL*)(Tessellator*, float, float, float, float);
-    inline signature_symbol<tessellator_color_t> tessellator_color{
+    inline constinit signature_symbol<tessellator_color_t> tessellator_color{
         "Tessellator::color",
         {
-            { selaura::platform::windows, { "80 B9 ? ? ? ? ? 4C 8B C1 75" } },
-            { selaura::platform::android, { "todo: find this" } }
+            .windows = { "80 B9 ? ? ? ? ? 4C 8B C1 75"_sig },
+            // .android: todo, find this
         }
     };
 
     using meshhelpers_rendermeshimmediately_t = void(THISCALL*)(void*, void*, void*, BedrockTextureData&, char*);
-    inline signature_symbol<meshhelpers_rendermeshimmediately_t> meshhelpers_rendermeshimmediately{
+    inline constinit signature_symbol<meshhelpers_rendermeshimmediately_t> meshhelpers_rendermeshimmediately{
         "MeshHelpers::renderMeshImmediately",
         {
-            { selaura::platform::windows, { "40 55 53 56 57 41 54 41 55 41 56 41 57 48 8D AC 24 98 FC FF FF 48 81 EC 68 04 00 00 49" } },
-            { selaura::platform::android, { "todo: find this" } }
+            .windows = { "40 55 53 56 57 41 54 41 55 41 56 41 57 48 8D AC 24 98 FC FF FF 48 81 EC 68 04 00 00 49"_sig },
+            // .android: todo, find this
         }
     };
 
     using mce_rendermaterialgroup_ui_t = mce::MaterialPtr*(THISCALL*)(void*);
-    inline signature_symbol<mce_rendermaterialgroup_ui_t> mce_rendermaterialgroup_ui{
+    inline constinit signature_symbol<mce_rendermaterialgroup_ui_t> mce_rendermaterialgroup_ui{
         "mce::RenderMaterialGroup::ui",
         {
-            { selaura::platform::windows, { "48 8B 05 ? ? ? ? 48 8D 55 90 48 8D 0D ? ? ? ? 48 8B 40 08 FF 15 ? ? ? ? 48 8B D8" } },
-            { selaura::platform::android, { "todo: find this" } }
+            .windows = { "48 8B 05 ? ? ? ? 48 8D 55 90 48 8D 0D ? ? ? ? 48 8B 40 08 FF 15 ? ? ? ? 48 8B D8"_sig },
+            // .android: todo, find this
         }
     };
 
     using mce_texturegroup_uploadtexture_t = mce::BedrockTexture&(THISCALL*)(void*, const ResourceLocation&, cg::ImageBuffer);
-    inline signature_symbol<mce_texturegroup_uploadtexture_t> mce_texturegroup_uploadtexture{
+    inline constinit signature_symbol<mce_texturegroup_uploadtexture_t> mce_texturegroup_uploadtexture{
         "mce::TextureGroup::uploadTexture",
         {
-            { selaura::platform::windows, {"48 89 5C 24 20 55 56 57 41 55 41 56 48 83 EC 20 48 8B 29"}},
+            .windows = { "48 89 5C 24 20 55 56 57 41 55 41 56 48 83 EC 20 48 8B 29"_sig }
         }
     };
 
     using mce_texturegroup_unloadalltextures_t = void(*)();
-    inline signature_symbol<mce_texturegroup_unloadalltextures_t> mce_texturegroup_unloadalltextures{
+    inline constinit signature_symbol<mce_texturegroup_unloadalltextures_t> mce_texturegroup_unloadalltextures{
         "mce::TextureGroup::unloadAllTextures",
         {
-            { selaura::platform::windows, {""}}
-            // 1.21.80 {selaura::platform::windows, {"48 89 5C 24 ? 57 48 83 EC ? 48 8B 99 ? ? ? ? 48 8B F9 48 8B 1B 80 7B ? ? 75 ? 0F 1F 00 48 8D 53"}}
-        }
-    };
-
-    inline offset_symbol clientinstance_guidata{
-        "ClientInstance::GuiData",
-        {
-                { selaura::platform::windows, {0x5B8}},
-                { selaura::platform::android, {0x0} }
-        }
-    };
-
-    inline offset_symbol minecraftuirendercontext_screencontext{
-        "MinecraftUIRenderContext::ScreenContext",
-        {
-            { selaura::platform::windows, {0x10}},
-            { selaura::platform::android, {0x0} }
-        }
-    };
-
-    inline offset_symbol minecraftuirendercontext_clientinstance{
-        "MinecraftUIRenderContext::ClientInstance",
-        {
-                { selaura::platform::windows, {0x8}},
-                { selaura::platform::android, {0x0} }
-        }
-    };
-
-    inline offset_symbol screencontext_tessellator{
-        "ScreenContext::Tessellator",
-        {
-                    { selaura::platform::windows, {0xC8}},
-                    { selaura::platform::android, {0x0} }
-        }
-    };
-
-    inline offset_symbol screenview_visualtree{
-        "ScreenView::VisualTree",
-        {
-                        { selaura::platform::windows, {0x48}},
-                        { selaura::platform::android, {0x0} }
-        }
-    };
-
-    inline offset_symbol visualtree_root{
-        "VisualTree::root",
-        {
-                            { selaura::platform::windows, {0x8}},
-                            { selaura::platform::android, {0x0} }
-        }
-    };
-
-    inline offset_symbol uicontrol_layername{
-        "UIControl::layerName",
-        {
-                                { selaura::platform::windows, {0x20}},
-                                { selaura::platform::android, {0x0} }
-        }
-    };
-
-    inline offset_symbol minecraftgame_gettexturegroup{
-        "MinecraftGame::getTextureGroup",
-        {
-                                    { selaura::platform::windows, {0x6D8}},
-                                    // 1.21.80: { selaura::platform::windows, {0x6C8}},
-                                    { selaura::platform::android, {0x0} }
-        }
+            // .windows: todo, find this
+            // 1.21.80 .windows = { "48 89 5C 24 ? 57 48 83 EC ? 48 8B 99 ? ? ? ? 48 8B F9 48 8B 1B 80 7B ? ? 75 ? 0F 1F 00 48 8D 53"_sig }
+        }
+    };
+
+    using minecraftuirendercontext_gettexture_t = mce::TexturePtr(THISCALL*)(MinecraftUIRenderContext*, const ResourceLocation&, bool);
+    inline constinit vtable_symbol<minecraftuirendercontext_gettexture_t> minecraftuirendercontext_gettexture{ "MinecraftUIRenderContext", { .windows = 29 } };
+
+    using mce_rendermaterialgroup_getmaterial_t = mce::MaterialPtr*(THISCALL*)(void*, const HashedString&);
+    inline constinit vtable_symbol<mce_rendermaterialgroup_getmaterial_t> mce_rendermaterialgroup_getmaterial{ "mce::RenderMaterialGroup", { .windows = 1 } };
+
+    // NetworkPeer's first slots after the destructor, sendPacket then receivePacket
+    using batchednetworkpeer_sendpacket_t = void(THISCALL*)(void*, const std::string&, int, int);
+    inline constinit vtable_symbol<batchednetworkpeer_sendpacket_t> batchednetworkpeer_sendpacket{ "BatchedNetworkPeer", { .windows = 1, .android = 2 } };
+
+    using batchednetworkpeer_receivepacket_t = int(THISCALL*)(void*, std::string&, const void*);
+    inline constinit vtable_symbol<batchednetworkpeer_receivepacket_t> batchednetworkpeer_receivepacket{ "BatchedNetworkPeer", { .windows = 2, .android = 3 } };
+
+    inline const signature_symbol_base* const signature_symbols[] = {
+        &splashtextrenderer_render,
+        &minecraftgame_update,
+        &screenview_setupandrender,
+        &tessellator_begin,
+        &tessellator_vertexuv,
+        &tessellator_color,
+        &meshhelpers_rendermeshimmediately,
+        &mce_rendermaterialgroup_ui,
+        &mce_texturegroup_uploadtexture,
+        &mce_texturegroup_unloadalltextures
+    };
+
+    inline constinit offset_symbol<platform_offsets{ .windows = 0x5B8, .android = 0x0 }> clientinstance_guidata{ "ClientInstance::GuiData" };
+    inline constinit offset_symbol<platform_offsets{ .windows = 0x10, .android = 0x0 }> minecraftuirendercontext_screencontext{ "MinecraftUIRenderContext::ScreenContext" };
+    inline constinit offset_symbol<platform_offsets{ .windows = 0x8, .android = 0x0 }> minecraftuirendercontext_clientinstance{ "MinecraftUIRenderContext::ClientInstance" };
+    inline constinit offset_symbol<platform_offsets{ .windows = 0xC8, .android = 0x0 }> screencontext_tessellator{ "ScreenContext::Tessellator" };
+    inline constinit offset_symbol<platform_offsets{ .windows = 0x48, .android = 0x0 }> screenview_visualtree{ "ScreenView::VisualTree" };
+    inline constinit offset_symbol<platform_offsets{ .windows = 0x8, .android = 0x0 }> visualtree_root{ "VisualTree::root" };
+    inline constinit offset_symbol<platform_offsets{ .windows = 0x20, .android = 0x0 }> uicontrol_layername{ "UIControl::layerName" };
+    inline constinit offset_symbol<platform_offsets{ .windows = 0x6D8, .android = 0x0 }> minecraftgame_gettexturegroup{ "MinecraftGame::getTextureGroup" };
+    // 1.21.80: .windows = 0x6C8
+
+    inline offset_symbol_base* const offset_symbols[] = {
+        &clientinstance_guidata,
+        &minecraftuirendercontext_screencontext,
+        &minecraftuirendercontext_clientinstance,
+        &screencontext_tessellator,
+        &screenview_visualtree,
+        &visualtree_root,
+        &uicontrol_layername,
+        &minecraftgame_gettexturegroup
     };
 }
\ No newline at end of file
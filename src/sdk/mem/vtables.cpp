@@ -0,0 +1,169 @@
+#include "vtables.hpp"
+#include "process.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace selaura {
+    namespace {
+        using vtable_index = std::unordered_map<std::string, const uintptr_t*>;
+
+        bool in_image(const process& proc, uintptr_t address, std::size_t size) {
+            const auto begin = reinterpret_cast<uintptr_t>(proc.base);
+            return address >= begin && address + size <= begin + proc.size;
+        }
+
+        std::string_view bounded_string(const process& proc, uintptr_t address) {
+            const auto* str = reinterpret_cast<const char*>(address);
+            const auto limit = reinterpret_cast<uintptr_t>(proc.base) + proc.size - address;
+            const auto length = strnlen(str, limit);
+            return length < limit ? std::string_view(str, length) : std::string_view{};
+        }
+
+#ifdef SELAURA_WINDOWS
+        // x64 layout, every field after the first three is an rva from the image base
+        struct complete_object_locator {
+            uint32_t signature;
+            uint32_t offset;
+            uint32_t constructor_offset;
+            int32_t type_descriptor;
+            int32_t class_descriptor;
+            int32_t self;
+        };
+
+        // vtable[-1] points at the locator, whose type descriptor holds ".?AVName@Namespace@@" 16 bytes in
+        vtable_index build_index(const process& proc) {
+            const auto image = reinterpret_cast<uintptr_t>(proc.base);
+            std::unordered_map<uintptr_t, std::string_view> locators;
+
+            for (const auto& section : proc.sections) {
+                if (section.executable) continue;
+
+                const auto* end = section.base + section.size;
+                for (const auto* at = section.base; at + sizeof(complete_object_locator) <= end; at += alignof(complete_object_locator)) {
+                    const auto* locator = reinterpret_cast<const complete_object_locator*>(at);
+                    if (locator->signature != 1 || locator->offset != 0) continue;
+                    if (reinterpret_cast<uintptr_t>(at) - image != static_cast<uintptr_t>(locator->self)) continue;
+
+                    const auto descriptor = image + locator->type_descriptor;
+                    if (!in_image(proc, descriptor, 2 * sizeof(void*) + 4)) continue;
+
+                    const auto name = bounded_string(proc, descriptor + 2 * sizeof(void*));
+                    if (!name.starts_with(".?AV") && !name.starts_with(".?AU")) continue;
+
+                    locators.emplace(reinterpret_cast<uintptr_t>(at), name.substr(4));
+                }
+            }
+
+            vtable_index index;
+            for (const auto& section : proc.sections) {
+                if (section.executable) continue;
+
+                const auto* end = section.base + section.size;
+                for (const auto* at = section.base; at + 2 * sizeof(uintptr_t) <= end; at += sizeof(uintptr_t)) {
+                    const auto* words = reinterpret_cast<const uintptr_t*>(at);
+                    auto locator = locators.find(words[0]);
+                    if (locator == locators.end()) continue;
+
+                    index.try_emplace(std::string(locator->second), words + 1);
+                }
+            }
+            return index;
+        }
+#else
+        // <length><identifier> or N<length><identifier>...E, the only shapes mangle_type_name produces
+        bool plausible_type_name(std::string_view name) {
+            const bool nested = name.starts_with('N');
+            if (nested) {
+                if (!name.ends_with('E')) return false;
+                name = name.substr(1, name.size() - 2);
+            }
+
+            if (name.empty()) return false;
+            while (!name.empty()) {
+                std::size_t length = 0, digits = 0;
+                while (digits < name.size() && name[digits] >= '0' && name[digits] <= '9') {
+                    length = length * 10 + (name[digits++] - '0');
+                }
+                if (digits == 0 || length == 0 || digits + length > name.size()) return false;
+                name.remove_prefix(digits + length);
+            }
+            return true;
+        }
+
+        // itanium puts offset-to-top and the typeinfo pointer right before the functions objects point at
+        vtable_index build_index(const process& proc) {
+            vtable_index index;
+
+            for (const auto& section : proc.sections) {
+                if (section.executable) continue;
+
+                const auto* end = section.base + section.size;
+                for (const auto* at = section.base; at + 3 * sizeof(uintptr_t) <= end; at += sizeof(uintptr_t)) {
+                    const auto* words = reinterpret_cast<const uintptr_t*>(at);
+                    if (words[0] != 0 || !in_image(proc, words[1], 2 * sizeof(uintptr_t))) continue;
+                    if (!in_image(proc, words[2], 1)) continue;
+
+                    // libc++ flags non-unique rtti names with the top bit on arm64
+                    auto name_address = reinterpret_cast<const uintptr_t*>(words[1])[1];
+                    name_address &= ~(uintptr_t{ 1 } << 63);
+                    if (!in_image(proc, name_address, 1)) continue;
+
+                    const auto name = bounded_string(proc, name_address);
+                    if (!plausible_type_name(name)) continue;
+
+                    index.try_emplace(std::string(name), words + 2);
+                }
+            }
+            return index;
+        }
+#endif
+
+        const vtable_index& get_index() {
+            static const vtable_index index = [] {
+                auto startTime = std::chrono::steady_clock::now();
+                auto built = build_index(get_cached_handle());
+
+                std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - startTime;
+                spdlog::info("Indexed {} vtables [{:.2f}ms]", built.size(), duration.count());
+                return built;
+            }();
+            return index;
+        }
+    }
+
+    std::string mangle_type_name(std::string_view type_name) {
+        std::vector<std::string_view> parts;
+        for (std::size_t start = 0;;) {
+            const auto separator = type_name.find("::", start);
+            parts.push_back(type_name.substr(start, separator - start));
+            if (separator == std::string_view::npos) break;
+            start = separator + 2;
+        }
+
+        std::string mangled;
+#ifdef SELAURA_WINDOWS
+        for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+            mangled.append(*it).push_back('@');
+        }
+        mangled.push_back('@');
+#else
+        if (parts.size() > 1) mangled.push_back('N');
+        for (const auto& part : parts) {
+            mangled.append(std::to_string(part.size())).append(part);
+        }
+        if (parts.size() > 1) mangled.push_back('E');
+#endif
+        return mangled;
+    }
+
+    const uintptr_t* find_vtable(std::string_view type_name) {
+        const auto& index = get_index();
+        auto it = index.find(mangle_type_name(type_name));
+        return it != index.end() ? it->second : nullptr;
+    }
+};
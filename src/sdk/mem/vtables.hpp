@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace selaura {
+    // primary vtable of a class by its source name, e.g. "mce::RenderMaterialGroup", nullptr if the image has no rtti for it
+    // the first call indexes every vtable in the image's data sections, later calls are a hash lookup
+    const uintptr_t* find_vtable(std::string_view type_name);
+
+    // the name rtti records for a plain or namespaced class, templates are not supported
+    std::string mangle_type_name(std::string_view type_name);
+};
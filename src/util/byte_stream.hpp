@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace selaura {
+    // little endian on every target we ship, values are written as their in-memory bytes
+    struct byte_writer {
+        std::vector<uint8_t>& out;
+
+        template <typename T>
+        void put(const T& value) {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        void put_string(std::string_view value) {
+            put(static_cast<uint16_t>(value.size()));
+            out.insert(out.end(), value.begin(), value.end());
+        }
+    };
+
+    // a read past the end yields zeroes and clears ok, callers check it once after a batch of reads
+    struct byte_reader {
+        const uint8_t* it;
+        const uint8_t* end;
+        bool ok = true;
+
+        template <typename T>
+        T get() {
+            T value{};
+            if (end - it < static_cast<std::ptrdiff_t>(sizeof(T))) {
+                ok = false;
+                return value;
+            }
+            std::memcpy(&value, it, sizeof(T));
+            it += sizeof(T);
+            return value;
+        }
+
+        std::string_view get_string() {
+            const auto size = get<uint16_t>();
+            if (!ok || end - it < size) {
+                ok = false;
+                return {};
+            }
+            std::string_view value(reinterpret_cast<const char*>(it), size);
+            it += size;
+            return value;
+        }
+    };
+}
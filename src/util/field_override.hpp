@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+
+namespace selaura {
+    // how a field_override tells the game wrote the field since we did
+    enum class field_check {
+        // compares with the override's value, no allocation and cheap for anything small
+        equal,
+        // compares the container's buffer and size with what the last write left, for containers too big to compare
+        // misses the game assigning into the same buffer at the same size
+        identity
+    };
+
+    // a value we keep in a game field, e.g. the splash texts
+    // apply is meant for every call of a hook and only writes when the field no longer holds the override
+    template <typename T, field_check check = field_check::equal>
+    struct field_override {
+        explicit field_override(T value) : value(std::move(value)) {}
+
+        // true when it had to write
+        bool apply(T& field) {
+            if (this->holds(field)) return false;
+
+            field = this->value;
+            if constexpr (check == field_check::identity) {
+                this->target = &field;
+                this->data = static_cast<const void*>(field.data());
+                this->size = field.size();
+            }
+            return true;
+        }
+
+        // the next apply writes the new value no matter what the field holds
+        void set(T value) {
+            this->value = std::move(value);
+            this->target = nullptr;
+        }
+
+        const T& get() const {
+            return this->value;
+        }
+    private:
+        bool holds(const T& field) const {
+            if constexpr (check == field_check::identity) {
+                return this->target == &field && this->data == static_cast<const void*>(field.data()) && this->size == field.size();
+            }
+            else {
+                return field == this->value;
+            }
+        }
+
+        T value;
+        const T* target = nullptr;
+        const void* data = nullptr;
+        std::size_t size = 0;
+    };
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace selaura {
+    // bump allocator for data that dies with the frame, deallocate is a no-op and reset hands everything back at once
+    // single threaded, only the render thread allocates from it
+    struct frame_arena final : std::pmr::memory_resource {
+        explicit frame_arena(std::size_t initial_size = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : chunk_size(initial_size), upstream(upstream) {}
+        frame_arena(const frame_arena&) = delete;
+        frame_arena& operator=(const frame_arena&) = delete;
+
+        ~frame_arena() override {
+            for (auto& chunk : this->chunks) {
+                this->upstream->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+            }
+        }
+
+        // a frame that overflowed into several chunks gets one chunk big enough for all of them next time
+        void reset() {
+            if (this->chunks.size() > 1) {
+                std::size_t total = 0;
+                for (auto& chunk : this->chunks) {
+                    total += chunk.size;
+                    this->upstream->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+                }
+                this->chunks.clear();
+                this->chunk_size = total;
+            }
+
+            this->offset = 0;
+            this->peak = std::max(this->peak, this->used);
+            this->used = 0;
+        }
+
+        // high water mark over every frame so far
+        std::size_t get_peak() const {
+            return this->peak;
+        }
+
+        std::size_t get_capacity() const {
+            std::size_t total = 0;
+            for (const auto& chunk : this->chunks) total += chunk.size;
+            return total;
+        }
+
+    private:
+        struct chunk {
+            std::byte* data;
+            std::size_t size;
+        };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            if (!this->chunks.empty()) {
+                if (void* out = this->bump(this->chunks.back(), bytes, alignment)) return out;
+            }
+
+            // the last chunk is full, the next one is at least twice as big
+            const std::size_t size = std::max(bytes + alignment, this->chunks.empty() ? this->chunk_size : this->chunks.back().size * 2);
+            auto* data = static_cast<std::byte*>(this->upstream->allocate(size, alignof(std::max_align_t)));
+            this->chunks.push_back({ data, size });
+            this->offset = 0;
+            return this->bump(this->chunks.back(), bytes, alignment);
+        }
+
+        void* bump(const chunk& current, std::size_t bytes, std::size_t alignment) {
+            const auto base = reinterpret_cast<std::uintptr_t>(current.data);
+            const std::size_t aligned = ((base + this->offset + alignment - 1) & ~(alignment - 1)) - base;
+            if (aligned + bytes > current.size) return nullptr;
+
+            this->offset = aligned + bytes;
+            this->used += bytes;
+            return current.data + aligned;
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        std::vector<chunk> chunks;
+        std::size_t chunk_size;
+        std::pmr::memory_resource* upstream;
+        std::size_t offset = 0;
+        std::size_t used = 0;
+        std::size_t peak = 0;
+    };
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace selaura {
+    // word-at-a-time mix, fast enough for megabytes per frame, only used to tell whether content changed
+    // not stable across builds on different endianness, nothing hashed with it is shared between platforms
+    inline std::uint64_t hash_bytes(std::uint64_t seed, const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t h = seed ^ (size * 0x9E3779B97F4A7C15ull);
+
+        for (; size >= 8; bytes += 8, size -= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            h = (h ^ word) * 0xFF51AFD7ED558CCDull;
+            h ^= h >> 32;
+        }
+
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, bytes, size);
+        h = (h ^ tail) * 0xC4CEB9FE1A85EC53ull;
+        return h ^ (h >> 29);
+    }
+}
@@ -0,0 +1,90 @@
+#include "mapped_file.hpp"
+
+#if defined(SELAURA_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace selaura {
+    mapped_file::mapped_file(mapped_file&& other) noexcept
+        : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)) {}
+
+    mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            this->close();
+            this->data = std::exchange(other.data, nullptr);
+            this->size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+
+    mapped_file::~mapped_file() {
+        this->close();
+    }
+
+#if defined(SELAURA_WINDOWS)
+    bool mapped_file::open(const std::filesystem::path& path) {
+        this->close();
+
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        // the view keeps the mapping and the file alive, both handles can go straight away
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) return false;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view) return false;
+
+        this->data = static_cast<const std::byte*>(view);
+        this->size = static_cast<std::size_t>(file_size.QuadPart);
+        return true;
+    }
+
+    void mapped_file::close() {
+        if (this->data) UnmapViewOfFile(this->data);
+        this->data = nullptr;
+        this->size = 0;
+    }
+#else
+    bool mapped_file::open(const std::filesystem::path& path) {
+        this->close();
+
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        // the mapping holds its own reference to the file
+        void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) return false;
+
+        this->data = static_cast<const std::byte*>(view);
+        this->size = static_cast<std::size_t>(info.st_size);
+        return true;
+    }
+
+    void mapped_file::close() {
+        if (this->data) munmap(const_cast<std::byte*>(this->data), this->size);
+        this->data = nullptr;
+        this->size = 0;
+    }
+#endif
+};
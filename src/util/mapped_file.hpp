@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+namespace selaura {
+    // a whole file mapped read-only, the pages are the os's page cache and nothing is copied into the heap
+    struct mapped_file {
+        mapped_file() = default;
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+        mapped_file(mapped_file&& other) noexcept;
+        mapped_file& operator=(mapped_file&& other) noexcept;
+        ~mapped_file();
+
+        // false for a missing or empty file, whatever was mapped before is unmapped either way
+        bool open(const std::filesystem::path& path);
+        void close();
+
+        std::span<const std::byte> bytes() const {
+            return { this->data, this->size };
+        }
+
+        bool is_open() const {
+            return this->data != nullptr;
+        }
+    private:
+        const std::byte* data = nullptr;
+        std::size_t size = 0;
+    };
+};
@@ -0,0 +1,85 @@
+#include "shared_mapping.hpp"
+
+#if defined(SELAURA_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace selaura {
+    shared_mapping::shared_mapping(shared_mapping&& other) noexcept
+        : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)) {}
+
+    shared_mapping& shared_mapping::operator=(shared_mapping&& other) noexcept {
+        if (this != &other) {
+            this->close();
+            this->data = std::exchange(other.data, nullptr);
+            this->size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+
+    shared_mapping::~shared_mapping() {
+        this->close();
+    }
+
+#if defined(SELAURA_WINDOWS)
+    bool shared_mapping::open(const std::filesystem::path& path, std::size_t size) {
+        this->close();
+
+        // other processes may open, map and even replace the file while we hold it
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        // a mapping bigger than the file extends it
+        const auto wide = static_cast<unsigned long long>(size);
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(wide >> 32), static_cast<DWORD>(wide), nullptr);
+        CloseHandle(file);
+        if (!mapping) return false;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, size);
+        CloseHandle(mapping);
+        if (!view) return false;
+
+        this->data = static_cast<std::byte*>(view);
+        this->size = size;
+        return true;
+    }
+
+    void shared_mapping::close() {
+        if (this->data) UnmapViewOfFile(this->data);
+        this->data = nullptr;
+        this->size = 0;
+    }
+#else
+    bool shared_mapping::open(const std::filesystem::path& path, std::size_t size) {
+        this->close();
+
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0660);
+        if (fd < 0) return false;
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || (static_cast<std::size_t>(info.st_size) < size && ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) return false;
+
+        this->data = static_cast<std::byte*>(view);
+        this->size = size;
+        return true;
+    }
+
+    void shared_mapping::close() {
+        if (this->data) munmap(this->data, this->size);
+        this->data = nullptr;
+        this->size = 0;
+    }
+#endif
+};
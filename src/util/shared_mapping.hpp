@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+namespace selaura {
+    // a file mapped read-write and shared, every process that maps the same file sees the same bytes
+    // works inside the game's sandbox on every target, named kernel objects don't reach out of an app container
+    struct shared_mapping {
+        shared_mapping() = default;
+        shared_mapping(const shared_mapping&) = delete;
+        shared_mapping& operator=(const shared_mapping&) = delete;
+        shared_mapping(shared_mapping&& other) noexcept;
+        shared_mapping& operator=(shared_mapping&& other) noexcept;
+        ~shared_mapping();
+
+        // creates the file if needed and grows it to size, existing contents are left for the caller to check
+        bool open(const std::filesystem::path& path, std::size_t size);
+        void close();
+
+        std::span<std::byte> bytes() const {
+            return { this->data, this->size };
+        }
+
+        bool is_open() const {
+            return this->data != nullptr;
+        }
+    private:
+        std::byte* data = nullptr;
+        std::size_t size = 0;
+    };
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+
+namespace selaura {
+    // single producer, single consumer, neither side ever blocks or allocates
+    template <typename T, std::size_t capacity>
+    struct spsc_ring {
+        static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+        // producer only, false when the consumer has fallen a whole ring behind
+        bool push(const T& value) {
+            const std::size_t head = this->head.load(std::memory_order_relaxed);
+            if (head - this->cached_tail == capacity) {
+                this->cached_tail = this->tail.load(std::memory_order_acquire);
+                if (head - this->cached_tail == capacity) {
+                    this->dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+
+            this->slots[head & (capacity - 1)] = value;
+            this->head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer only
+        std::optional<T> pop() {
+            const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+            if (tail == this->cached_head) {
+                this->cached_head = this->head.load(std::memory_order_acquire);
+                if (tail == this->cached_head) return std::nullopt;
+            }
+
+            T value = this->slots[tail & (capacity - 1)];
+            this->tail.store(tail + 1, std::memory_order_release);
+            return value;
+        }
+
+        std::size_t dropped_count() const {
+            return this->dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr std::size_t line = 64;
+
+        // each side keeps a stale copy of the other's index so it only touches the shared line when it has to
+        alignas(line) std::atomic<std::size_t> head{ 0 };
+        std::size_t cached_tail = 0;
+
+        alignas(line) std::atomic<std::size_t> tail{ 0 };
+        std::size_t cached_head = 0;
+
+        alignas(line) std::atomic<std::size_t> dropped{ 0 };
+        std::array<T, capacity> slots{};
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace selaura {
+    // one writer publishes whole values, any number of readers copy the latest one out, nobody blocks
+    // three slots keep the writer off the slot readers are most likely on, the per-slot sequence catches the rare lapped reader
+    template <typename T>
+    struct triple_buffer {
+        static_assert(std::is_trivially_copyable_v<T>, "readers copy slots while the writer may be filling another");
+
+        // writer only
+        void publish(const T& value) {
+            const std::uint32_t next = (this->latest.load(std::memory_order_relaxed) + 1) % 3;
+            auto& target = this->slots[next];
+
+            // odd while the slot is being written
+            const std::uint32_t seq = target.seq.load(std::memory_order_relaxed);
+            target.seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&target.value, &value, sizeof(T));
+            target.seq.store(seq + 2, std::memory_order_release);
+
+            this->latest.store(next, std::memory_order_release);
+        }
+
+        // any thread, the most recent complete value or a default constructed one before the first publish
+        T read() const {
+            T value;
+            while (true) {
+                const auto& source = this->slots[this->latest.load(std::memory_order_acquire)];
+                const std::uint32_t before = source.seq.load(std::memory_order_acquire);
+                if (before & 1) continue;
+
+                std::memcpy(&value, &source.value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (source.seq.load(std::memory_order_relaxed) == before) return value;
+            }
+        }
+
+    private:
+        static constexpr std::size_t line = 64;
+
+        struct alignas(line) slot {
+            std::atomic<std::uint32_t> seq{ 0 };
+            T value{};
+        };
+
+        std::array<slot, 3> slots{};
+        alignas(line) std::atomic<std::uint32_t> latest{ 0 };
+    };
+}
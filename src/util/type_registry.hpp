@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace selaura {
+    // one instance per registered type, looked up by a dense per-type slot instead of dynamic_cast
+    template <typename base_t>
+    struct type_registry {
+        type_registry() = default;
+        type_registry(const type_registry&) = delete;
+        type_registry& operator=(const type_registry&) = delete;
+
+        ~type_registry() {
+            // the arena only releases memory, destructors have to run by hand and in reverse
+            for (auto it = ordered.rbegin(); it != ordered.rend(); ++it)
+                (*it)->~base_t();
+        }
+
+        template <typename T, typename... Args>
+        T* emplace(Args&&... args) {
+            static_assert(std::is_base_of_v<base_t, T>, "T must derive from the registry's base");
+            static_assert(std::has_virtual_destructor_v<base_t>, "base must have a virtual destructor");
+
+            const std::size_t slot = slot_of<T>();
+            if (slot < dense.size() && dense[slot])
+                return static_cast<T*>(dense[slot]);
+
+            T* ptr = std::pmr::polymorphic_allocator<>(&arena).new_object<T>(std::forward<Args>(args)...);
+            if (slot >= dense.size())
+                dense.resize(slot + 1, nullptr);
+            dense[slot] = ptr;
+            ordered.push_back(ptr);
+            return ptr;
+        }
+
+        template <typename T>
+        T* get() const {
+            const std::size_t slot = slot_of<T>();
+            return slot < dense.size() ? static_cast<T*>(dense[slot]) : nullptr;
+        }
+
+        template <typename T>
+        bool contains() const {
+            return get<T>() != nullptr;
+        }
+
+        // registration order, which is also the order instances sit in the arena
+        std::span<base_t* const> all() const {
+            return ordered;
+        }
+
+        std::size_t size() const {
+            return ordered.size();
+        }
+
+    private:
+        static std::size_t next_slot() {
+            static std::size_t counter = 0;
+            return counter++;
+        }
+
+        template <typename T>
+        static std::size_t slot_of() {
+            static const std::size_t slot = next_slot();
+            return slot;
+        }
+
+        std::pmr::monotonic_buffer_resource arena{ 4096 };
+        std::vector<base_t*> dense;
+        std::vector<base_t*> ordered;
+    };
+}
@@ -0,0 +1,153 @@
+#include "projection.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SELAURA_PROJECT_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SELAURA_PROJECT_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SELAURA_PROJECT_NEON
+#endif
+
+namespace selaura {
+    namespace {
+        // anything closer than this to the camera plane is behind it as far as the overlay cares
+        constexpr float near_w = 0.001f;
+
+        // glm is column major, m[column][row]
+        struct rows {
+            float x[4], y[4], w[4];
+
+            explicit rows(const glm::mat4& m) {
+                for (int c = 0; c < 4; c++) {
+                    x[c] = m[c][0];
+                    y[c] = m[c][1];
+                    w[c] = m[c][3];
+                }
+            }
+        };
+
+        std::size_t project_scalar(const rows& r, glm::vec2 half, const point_soa& in, const projected_soa& out, std::size_t from, std::size_t to) {
+            std::size_t visible = 0;
+            for (std::size_t i = from; i < to; i++) {
+                const float px = in.x[i], py = in.y[i], pz = in.z[i];
+                const float cx = r.x[0] * px + r.x[1] * py + r.x[2] * pz + r.x[3];
+                const float cy = r.y[0] * px + r.y[1] * py + r.y[2] * pz + r.y[3];
+                const float cw = r.w[0] * px + r.w[1] * py + r.w[2] * pz + r.w[3];
+
+                const float inv_w = cw > near_w ? 1.0f / cw : 0.0f;
+                const float nx = cx * inv_w;
+                const float ny = cy * inv_w;
+                const bool inside = cw > near_w && nx >= -1.0f && nx <= 1.0f && ny >= -1.0f && ny <= 1.0f;
+
+                out.x[i] = (nx + 1.0f) * half.x;
+                out.y[i] = (1.0f - ny) * half.y;
+                out.visible[i] = inside;
+                visible += inside;
+            }
+            return visible;
+        }
+    }
+
+    std::size_t project_points(const glm::mat4& view_proj, glm::vec2 screen_size, const point_soa& in, const projected_soa& out) {
+        const std::size_t count = std::min({ in.x.size(), in.y.size(), in.z.size() });
+        const rows r(view_proj);
+        const glm::vec2 half = screen_size * 0.5f;
+
+        std::size_t i = 0;
+        std::size_t visible = 0;
+
+#if defined(SELAURA_PROJECT_AVX2)
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 near = _mm256_set1_ps(near_w);
+        const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        const __m256 half_x = _mm256_set1_ps(half.x), half_y = _mm256_set1_ps(half.y);
+
+        for (; i + 8 <= count; i += 8) {
+            const __m256 px = _mm256_loadu_ps(&in.x[i]), py = _mm256_loadu_ps(&in.y[i]), pz = _mm256_loadu_ps(&in.z[i]);
+            auto row = [&](const float* m) {
+                return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, _mm256_set1_ps(m[0])), _mm256_mul_ps(py, _mm256_set1_ps(m[1]))),
+                    _mm256_add_ps(_mm256_mul_ps(pz, _mm256_set1_ps(m[2])), _mm256_set1_ps(m[3])));
+            };
+            const __m256 cx = row(r.x), cy = row(r.y), cw = row(r.w);
+
+            const __m256 front = _mm256_cmp_ps(cw, near, _CMP_GT_OQ);
+            const __m256 inv_w = _mm256_and_ps(_mm256_div_ps(one, cw), front);
+            const __m256 nx = _mm256_mul_ps(cx, inv_w), ny = _mm256_mul_ps(cy, inv_w);
+            const __m256 inside = _mm256_and_ps(front, _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_and_ps(nx, abs_mask), one, _CMP_LE_OQ),
+                _mm256_cmp_ps(_mm256_and_ps(ny, abs_mask), one, _CMP_LE_OQ)));
+
+            _mm256_storeu_ps(&out.x[i], _mm256_mul_ps(_mm256_add_ps(nx, one), half_x));
+            _mm256_storeu_ps(&out.y[i], _mm256_mul_ps(_mm256_sub_ps(one, ny), half_y));
+
+            const unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(inside));
+            for (int lane = 0; lane < 8; lane++) out.visible[i + lane] = (mask >> lane) & 1;
+            visible += std::popcount(mask);
+        }
+#elif defined(SELAURA_PROJECT_SSE2)
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 near = _mm_set1_ps(near_w);
+        const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 half_x = _mm_set1_ps(half.x), half_y = _mm_set1_ps(half.y);
+
+        for (; i + 4 <= count; i += 4) {
+            const __m128 px = _mm_loadu_ps(&in.x[i]), py = _mm_loadu_ps(&in.y[i]), pz = _mm_loadu_ps(&in.z[i]);
+            auto row = [&](const float* m) {
+                return _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(m[0])), _mm_mul_ps(py, _mm_set1_ps(m[1]))),
+                    _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(m[2])), _mm_set1_ps(m[3])));
+            };
+            const __m128 cx = row(r.x), cy = row(r.y), cw = row(r.w);
+
+            const __m128 front = _mm_cmpgt_ps(cw, near);
+            const __m128 inv_w = _mm_and_ps(_mm_div_ps(one, cw), front);
+            const __m128 nx = _mm_mul_ps(cx, inv_w), ny = _mm_mul_ps(cy, inv_w);
+            const __m128 inside = _mm_and_ps(front, _mm_and_ps(
+                _mm_cmple_ps(_mm_and_ps(nx, abs_mask), one),
+                _mm_cmple_ps(_mm_and_ps(ny, abs_mask), one)));
+
+            _mm_storeu_ps(&out.x[i], _mm_mul_ps(_mm_add_ps(nx, one), half_x));
+            _mm_storeu_ps(&out.y[i], _mm_mul_ps(_mm_sub_ps(one, ny), half_y));
+
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(inside));
+            for (int lane = 0; lane < 4; lane++) out.visible[i + lane] = (mask >> lane) & 1;
+            visible += std::popcount(mask);
+        }
+#elif defined(SELAURA_PROJECT_NEON)
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t near = vdupq_n_f32(near_w);
+        const float32x4_t half_x = vdupq_n_f32(half.x), half_y = vdupq_n_f32(half.y);
+
+        for (; i + 4 <= count; i += 4) {
+            const float32x4_t px = vld1q_f32(&in.x[i]), py = vld1q_f32(&in.y[i]), pz = vld1q_f32(&in.z[i]);
+            auto row = [&](const float* m) {
+                return vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(m[3]), px, m[0]), py, m[1]), pz, m[2]);
+            };
+            const float32x4_t cx = row(r.x), cy = row(r.y), cw = row(r.w);
+
+            const uint32x4_t front = vcgtq_f32(cw, near);
+            // lanes behind the camera divide by whatever, the mask throws them away
+            const float32x4_t inv_w = vdivq_f32(one, cw);
+            const float32x4_t nx = vmulq_f32(cx, inv_w), ny = vmulq_f32(cy, inv_w);
+            const uint32x4_t inside = vandq_u32(front, vandq_u32(vcaleq_f32(nx, one), vcaleq_f32(ny, one)));
+
+            vst1q_f32(&out.x[i], vmulq_f32(vaddq_f32(nx, one), half_x));
+            vst1q_f32(&out.y[i], vmulq_f32(vsubq_f32(one, ny), half_y));
+
+            const uint32x4_t bits = vshrq_n_u32(inside, 31);
+            out.visible[i + 0] = static_cast<std::uint8_t>(vgetq_lane_u32(bits, 0));
+            out.visible[i + 1] = static_cast<std::uint8_t>(vgetq_lane_u32(bits, 1));
+            out.visible[i + 2] = static_cast<std::uint8_t>(vgetq_lane_u32(bits, 2));
+            out.visible[i + 3] = static_cast<std::uint8_t>(vgetq_lane_u32(bits, 3));
+            visible += vaddvq_u32(bits);
+        }
+#endif
+
+        return visible + project_scalar(r, half, in, out, i, count);
+    }
+};
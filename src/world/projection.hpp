@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include "../sdk/mc/world/phys/Vec2.hpp"
+#include "../sdk/mc/world/phys/Vec3.hpp"
+
+namespace selaura {
+    // world points as separate coordinate arrays, so a simd lane holds the same coordinate of neighbouring points
+    struct point_soa {
+        std::span<const float> x;
+        std::span<const float> y;
+        std::span<const float> z;
+    };
+
+    struct projected_soa {
+        float* x;
+        float* y;
+        // 1 where the point is in front of the camera and inside the screen, 0 otherwise
+        std::uint8_t* visible;
+    };
+
+    // projects every point with view_proj into pixels in one pass, out must hold as many points as in
+    // returns how many are visible, the coordinates of culled points are left unspecified
+    std::size_t project_points(const glm::mat4& view_proj, glm::vec2 screen_size, const point_soa& in, const projected_soa& out);
+
+    // one point at a time, for the odd label that isn't worth batching
+    inline bool world_to_screen(const glm::mat4& view_proj, glm::vec2 screen_size, const Vec3& point, Vec2& out) {
+        const glm::vec4 clip = view_proj * glm::vec4(point.x, point.y, point.z, 1.0f);
+        if (clip.w <= 0.001f) return false;
+
+        const float nx = clip.x / clip.w;
+        const float ny = clip.y / clip.w;
+        if (nx < -1.0f || nx > 1.0f || ny < -1.0f || ny > 1.0f) return false;
+
+        out = { (nx + 1.0f) * 0.5f * screen_size.x, (1.0f - ny) * 0.5f * screen_size.y };
+        return true;
+    }
+};